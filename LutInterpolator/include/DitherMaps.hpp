@@ -0,0 +1,333 @@
+#ifndef __LUT_INTERPOLATOR_DITHER_MAPS__
+#define __LUT_INTERPOLATOR_DITHER_MAPS__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Interpolator
+{
+
+enum class DitherMode : uint32_t
+{
+    None = 0,
+    Bayer,      // ordered dither, 8x8 Bayer matrix
+    BlueNoise   // 64x64 blue noise tile (void-and-cluster)
+};
+
+
+// --- Threshold maps: value in [0...1) per pixel, tiled over the image ---
+constexpr std::size_t bayerMapSize = 8u;
+constexpr std::size_t blueNoiseMapSize = 64u;
+
+
+// recursive construction: M(2n) = [4M, 4M+2; 4M+3, 4M+1]
+inline const std::array<float, bayerMapSize * bayerMapSize>& bayer_map (void)
+{
+    static const std::array<float, bayerMapSize * bayerMapSize> map = []()
+    {
+        std::array<uint32_t, bayerMapSize * bayerMapSize> rank {};
+        for (std::size_t n = 1u; n < bayerMapSize; n *= 2u)
+        {
+            for (std::size_t y = 0; y < n; y++)
+                for (std::size_t x = 0; x < n; x++)
+                {
+                    const uint32_t v = rank[y * bayerMapSize + x] * 4u;
+                    rank[ y      * bayerMapSize + x    ] = v;
+                    rank[ y      * bayerMapSize + x + n] = v + 2u;
+                    rank[(y + n) * bayerMapSize + x    ] = v + 3u;
+                    rank[(y + n) * bayerMapSize + x + n] = v + 1u;
+                }
+        }
+        std::array<float, bayerMapSize * bayerMapSize> out {};
+        for (std::size_t i = 0; i < out.size(); i++)
+            out[i] = (static_cast<float>(rank[i]) + 0.5f) / static_cast<float>(out.size());
+        return out;
+    }();
+    return map;
+}
+
+
+// Void-and-cluster (Ulichney) blue noise ranks 0...4095 of 64x64 tile (gaussian sigma 1.5, seed 0x5EED),
+// generated offline; DitherApplyTest regenerates the tile and compares it with this table.
+inline const uint16_t* blue_noise_ranks (void) noexcept
+{
+    static const uint16_t ranks[blueNoiseMapSize * blueNoiseMapSize] =
+    {
+        2056,  331, 2898, 1044, 3472, 2772, 3749, 1499, 3357,   43, 2029, 2612, 3317, 2245, 1078, 3672,
+        1719, 1416, 2866, 1979, 3791, 2516, 3258, 2110, 2969,  336, 1919, 2289, 3021, 1183, 3836, 3179,
+         382, 2224, 3075,  513,  910, 2207, 1274, 3820, 2778, 3316, 1390,  223, 3061, 1998, 2705,  703,
+        2971, 2328, 1017, 3890,  244, 2222,  714, 4067, 2023, 2918, 1441,  555, 2444, 1661,  206, 3558,
+        3160, 4069, 1931, 2565,  697, 1737,  993, 2979,  585, 3922, 3117,  995,  408, 1371, 3070,  769,
+        2481, 3903, 1065, 3104,  760, 1397,  109, 3493, 1590, 1061, 3987,  482, 3585, 2567, 2039, 1406,
+        2715,  770, 3931, 2084, 3650, 3200, 2497,  165,  949, 2342,  675, 1825,  987, 3944, 1535, 3389,
+        1277,  290, 1762, 2437, 3055, 3649, 1039, 3285, 1303,  830, 3595, 2692, 1154, 3975, 2729, 1092,
+         686, 1424,   41, 3129, 2252, 3950,  152, 2503, 1225, 2266, 1591, 3683, 1893, 3840, 2742,  255,
+        3232,  512, 2324,  230, 1696, 2763, 4052,  614, 2377, 2681, 3281, 1435,  745, 1721,  319,  986,
+        3577, 1832, 1302,  282, 1496,  452, 1900, 3035, 1557, 4055, 2701, 3400, 2290,  312, 2477,  490,
+        2168, 4046, 3229,  551, 1449, 1823, 2703,  444, 2386, 3146, 1796,  314, 3231, 1904,  460, 2247,
+        2787, 1761, 3690, 1167,  497, 1395, 3227, 1966, 3559,  862,  222, 2863,  693, 2411, 1611, 2096,
+         973, 3520, 1298, 3744, 3331, 2240, 1177, 2004, 3619,  843,   73, 2189, 2747, 3364, 3927, 2271,
+        2917,   32, 3338, 2542, 2908, 3971, 1076, 3438,  564, 2027,   24, 1197, 3601,  759, 3147, 3719,
+        1693,  870, 2798, 1144, 3427,   26, 2140, 3807, 1573,  162, 3923, 2204,  711, 3707, 1523, 3405,
+        3904,  924, 2364, 3415, 1863, 3621, 2794,  339, 1651, 3067, 2568, 1316, 3378,  108, 1145, 3932,
+        2915, 1853, 2678, 2044,  475,  896, 3159,  308, 1361, 2935, 1779, 3787, 1099,  182, 3093,  626,
+        1558, 3765, 2180, 1021, 1790,  724, 2720, 2287, 1324, 3655, 3166, 1714, 2871, 1365, 1941, 1032,
+        2594,  180, 3604, 1956, 2558,  852, 3542, 1188, 2954,  786, 2573, 1287, 2894, 1005, 2534,  236,
+        1951,  522, 2966,  266, 2622,  977,  676, 2355, 3969,  558, 3639, 2158, 1723, 2994, 3547,  561,
+        1452,   23,  738, 2984, 1543, 3819, 2509, 1705, 3912, 2417,  500, 3036, 1513, 2458, 1898, 1246,
+        2656,  890,  410, 3040, 3611,  113, 1607, 3845,  297, 2460, 1003,  394, 2184, 3982,   94, 2965,
+        3339, 1471, 2286,  448, 3962, 1689, 2820,  523, 1965, 3433, 1728, 3276,   90, 2071, 3076, 1332,
+        2435, 3286, 1260, 1637, 4029, 2148, 1504, 3355, 1216, 1923, 1002,  304, 4070,  826, 2610, 2200,
+        3287, 2446, 4025, 1164, 3447,  172, 2833,  696, 3411, 1013, 2086, 3458,  767, 4071,  443, 3548,
+        3217, 2026, 3993, 1431, 2333, 3301, 2070,  854, 3063, 1839, 2731, 3758,  608, 2617, 1609, 2123,
+         526, 3875,  802, 3020, 1358,  289, 3259, 2302, 4004, 1081,  436, 3657, 1537, 4050,  590, 3591,
+          64, 3850, 2058,  618, 3190,  203, 3778, 2920,   25, 2732, 3206, 2396, 1263, 1982,  385, 1649,
+         927, 3581, 1807,  395, 2320, 1846, 1234, 2136,   97, 3154, 1319,  270, 1983, 2779,  938, 2340,
+         154, 1668,  713, 2634, 1171,  532, 2836, 1258, 3467,  661, 1478, 3318, 1180, 3111,  828, 3708,
+        1239, 2439, 1792, 3552, 2093, 2679,  895, 1474,  117, 2513, 2144, 2761,  856, 2347, 1837, 1072,
+        1684, 2641,  886, 2343, 2826, 1150, 1822,  838, 2223, 1408, 3811,  677, 3422, 2783, 3681, 3115,
+         183, 1308, 2810, 3198,  957, 3702, 3008, 4042, 1577, 2706, 3857, 2492, 3568, 1596, 3016, 1327,
+        3842, 2815, 3366,  228, 3710, 1824, 4072, 2426,   80, 3816, 2312,  184, 1773, 2383, 3477,  245,
+        2708, 3182,   61, 1137,  681, 3368, 3855, 1880, 3125, 3740,  640, 1210, 3189,  291, 3485, 2868,
+        3265,  428, 3530, 1344, 3732,  398, 2500, 3255, 3682,  454, 1708, 2985,   87, 1488, 1019, 2370,
+        3815, 2138,  539, 1560, 2545,  268,  799, 2459,  439,  908, 1747,  584, 1132,   66, 3738, 2172,
+         455, 1045, 2263, 1945, 3102,  988,  396, 1598, 2948, 1950,  952, 2843, 4038,  453, 1467, 1985,
+         897, 1579, 4073, 2859, 2421,  193, 1191, 2621,  357, 1405, 2952, 1993, 3928, 2628, 1379,  742,
+        2005, 1512, 2936,  127, 1912, 3396, 1531,  593, 1995, 2666, 1071, 2282, 1886, 3908,  556, 1814,
+        2724,  834, 3482, 3924, 1991, 3336, 1427, 3550, 1922, 2925, 3345, 2153, 3123, 2670,  660, 1873,
+        3180, 1433, 3488,  791, 1522, 2608, 3512, 2146,  762, 3270, 1375, 3582, 2098, 1115, 2803, 3776,
+        3344, 2239,  570, 1942, 3741, 1692, 2190, 3533,  789, 1768, 3468,   31, 1624,  544, 2197, 3888,
+        2489, 1091, 4065, 2166, 2714,  934, 3958, 1190, 3039,  234, 4031, 3308,  804, 2451, 3501, 1261,
+         278, 3078, 1383,   91, 1058, 2725,  553, 2248, 1175, 3809,  288, 1404, 3981, 1677, 3439,  882,
+        2525, 4033,   22, 2410, 3821,  265, 3012, 1161, 3883,  462, 2484,  253,  747, 3145, 2450,  628,
+        1269,  279, 3059, 1388,  958, 3207,  525, 2844, 4047, 2360, 1024, 2496, 3695, 1127, 3034,  144,
+        3691,  499, 3174,  718, 1613,  421, 2823, 2201, 3593, 1660,  548, 1366, 2735,  169, 2928, 2112,
+        4015, 1683, 2494, 2195, 3030, 1648, 3940, 3141,   21, 2633,  847, 2433,  420, 1048, 2356,  306,
+        2923, 1746,  650, 2855, 1291, 1960,  596, 2345, 1538, 2758, 1875, 3401, 1672, 3854,   20, 1798,
+        2899, 3919, 2443, 3544,  231, 2576, 1517, 1109, 2017,  393, 3249,  694, 2852, 1850, 3395,  936,
+        2812, 1858, 1283, 2555, 3792, 3320, 1854,  150,  835, 2499, 3135, 2065, 3794, 1646, 1093, 3242,
+         466,  953, 3394,  658, 3771,  342,  963, 1861, 1472, 3417, 2030, 3718, 2993, 1924, 3578, 1387,
+        3743, 1084, 2059, 3571, 3203,  909, 4006, 3283,   54, 3686,  971, 2881, 1333, 2221, 1049, 3597,
+        2046,  876, 1682,  662, 2106, 3874, 3410,  116, 3052, 1565, 3838, 2088, 1330,  380, 2349, 1546,
+         284, 2237, 3443,   19, 1023, 2405, 1355, 3852, 2956, 1280, 3514,  998,  414, 3384,  664, 2404,
+        1802, 3729, 2840, 1206, 1918, 2609, 3474, 2321,  700, 2831, 1151, 1559,  678, 2618,  100, 3097,
+        2249,  349, 2710, 1542,  158, 2212, 1710, 2676, 1276, 2055,  605, 3999,  391, 2593, 3288, 1477,
+         456, 2698, 3350, 1208, 2764, 1795,  836, 2408, 3648, 1229, 2659,  175, 3090, 4026,  753, 3567,
+        1080, 3965, 1643, 3011, 2069,  611, 3132,  362, 1777, 2335,   44, 1860, 2660, 2174, 3953, 1410,
+        2643,   36, 2091,  418, 3251, 1414,  135, 2977, 4001,  470, 3534,  218, 3240, 4074, 1182, 1709,
+         604, 3348, 3956,  775, 2598, 3664, 1082,  329, 3037, 3521, 2412, 1797, 3094,  871,  204, 2946,
+        3829, 2316,   81, 4016, 3088,  355, 1440, 2896,  652, 1909,  912, 3536, 1680, 2579, 2019, 3133,
+        2718,  516,  833, 2619, 3511, 1536, 3670, 2667, 1110, 3995,  735, 3678, 3101, 1149,  267, 2953,
+         785, 3590, 1571, 4075, 2427,  755, 3689, 1112, 1638, 2128, 2549, 1766, 2315,  832, 2063, 3783,
+        2491, 1430, 1920, 1209, 3028,  506, 2469, 3790,  812, 1526,  161, 1189, 3717, 2073, 3499, 1827,
+         716, 1310, 1635,  601, 2235, 1034, 3456, 2083, 3986,  431, 3282, 2163,  563, 1158,   62, 1462,
+        2392, 1890, 3750, 1247,  332, 1939,  962,  530, 2097, 3252, 2488, 1502,  501, 1722, 3713, 1969,
+        3280, 1230, 2301,  979, 2911, 1712, 2079, 2672,  269, 3213,  943, 3865, 1323, 2745,  442, 2931,
+         964, 3185,  310, 3524, 2105, 1582, 3254, 1799, 2156, 2845, 3332, 2635,  587, 1399, 2457, 1100,
+        2813, 3661, 2519, 3298, 1833, 3753, 2644,   18, 1617, 2511, 2926, 1432, 3680, 2817, 3885, 3404,
+         970, 2924,  199, 3116, 2468, 4076, 2853, 3416, 1619,  254, 1290, 2983, 2236, 3359,  967, 2476,
+         185, 2750,  576, 3486,  170, 3868,  527, 3047, 1418, 3617,  581, 2922,  124, 3302, 1604, 3561,
+          42, 2299, 2832,  707, 3902,   76, 1244,  655, 4058,  412, 1009, 3899, 1691, 3013,  451, 4077,
+         237, 2054,  907, 2962,  188, 1349,  761, 3197, 1203, 3633,  991,  156, 2354,  771, 1789,  361,
+        3797, 1305, 2107, 3587,  671, 1412,  119, 2285, 3864, 2789,  879, 3759,   86, 2682,  643, 1377,
+        3798, 1675, 3033, 1955, 1384, 2536, 1026, 3377, 1819, 2384, 1228, 1976, 3667, 2250,  719, 1947,
+        1334, 4013, 1663, 1015, 2699, 2407, 3491, 2972, 2562, 1402, 1967, 2332,  106, 3630, 2209, 3215,
+        1729, 3435,  481, 1484, 3554, 2434, 3895, 1928, 2327,  354, 1851, 4078, 3119, 1221, 3262, 2211,
+         580, 3434, 1633,  931, 2338, 1817, 3144, 1118,  679, 2011, 3313, 1780, 1179, 3915, 1849, 3479,
+        2142,  366, 3966,  793, 3292, 2205, 3663,   75,  831, 4021,  294, 2614, 1492, 1043, 3856, 2639,
+        3356,  507, 2068, 3284, 1444,  546, 1987, 1057,  178, 3437, 3130,  796, 2793, 1300,  666, 1018,
+        2650, 1259, 3933, 2838, 2143, 1010,  476, 3048,  680, 3391, 2584, 1514, 2033,  263, 2646, 1574,
+        3000, 2507,   89, 2819, 3872,  471, 2658, 3721, 1524,  320, 2526,  560, 2171, 2874,  283, 3106,
+         994, 2432, 1205, 2632,  281, 1695, 1255, 2824, 2042, 2964, 3430,  733, 3193,  406, 3005,  198,
+        1119, 2495, 3711,  145, 3014, 3780, 1676, 3625, 2181, 1585,  493, 3734, 1891, 3407, 1614, 2970,
+          50, 2179,  710, 1820,  277, 3363, 1581, 2770, 1311, 3835,  860, 2903,  565, 3494, 3911,  887,
+         397, 4009, 1999, 3228, 1214, 3475,  868, 2108, 3385, 2959, 3978, 1443, 3527,  780, 1584, 2613,
+         541, 3361, 1545, 3624, 2889,  612, 3913, 2480,  373, 1359, 1715, 2178, 3938, 1857, 2400, 1634,
+        3138,  750, 1828, 1238, 2341,  921,  258, 2809,  816, 3963, 2440, 1139, 2578,  299, 3977, 2007,
+        3687, 3233, 2419, 3607, 1202, 2505, 3997,  214, 2193, 1786,  118, 3295, 1050, 2232, 1396, 1895,
+        2363, 1136,  749, 1516,  309, 2214, 1686,   17, 1265, 2278,  981,  133, 3208, 2398, 4064, 1275,
+        3722, 1906,   16, 2111, 1047, 3157, 1864,  902, 3253, 3735, 1055,   38, 2717, 1264,  550, 3812,
+        2121, 3535, 2842,  477, 4045, 2018, 3294, 2391, 1336, 2995,   15, 1751, 3096,  891, 2317,  529,
+        1350,  945,  407, 1621, 3099,  777, 1874, 3264, 1060, 3636, 2483, 1356, 3720, 2850,   14, 3209,
+        1599, 3418, 2739, 3768, 2498, 3041, 4043, 2822,  651, 3565, 1670, 2755, 1885, 1077,  220, 2132,
+        2905,  853, 3243, 4008,  430, 2369, 3526, 1547,  554, 2674, 2348, 3460,  844, 3598, 2913,  948,
+        1347,  317, 1580, 3424, 2620, 1470,  377, 3844,  583, 1962, 3489,  702, 3823, 1498, 3248, 2837,
+        1770, 2630, 4053, 2873,   93, 3701, 1360, 2371,  654, 2752,  465, 2100, 1738,  730, 2544, 3623,
+         484, 2159,  225, 1844,  689, 1357,  425, 3245, 1869, 2623,  403, 3862,  620, 2974, 3592, 1702,
+         371, 2527, 1223, 1690, 2691, 1394,   96, 2198, 4068, 1916,  330, 3018, 1664, 2089,  146, 3272,
+        2502, 3943, 2215, 1020,  602, 2975, 1113, 1730, 3142, 2604, 1256, 2206, 2736,  208, 1178, 3789,
+         129, 3428, 1977, 1105, 2217, 2709,  437, 3497, 3084, 1529, 3853, 3187,  256, 4049, 1295,  917,
+        3788, 2958, 1056, 3150, 3546, 2050, 1073, 2375,  840, 3746, 1236, 2072, 3351, 1426, 2292,  746,
+        3105, 3775, 2234,  595, 3049, 3795,  772, 2949, 1085, 3211, 1415,  682, 3961, 2590, 1469, 1943,
+         657, 2804,   63, 3199, 1879, 3754, 2256, 3528,  142,  929, 4079,  384, 1791, 3660, 2035,  637,
+        2334,  801, 1457,  498, 3846, 1551, 2047, 1000,   45, 1933, 1133,  827, 2668, 2176, 3095, 1925,
+        2441, 1411, 3980, 1650,   70, 2607, 3843, 3369, 1539,  186, 3164, 2424, 1001,   47, 2696, 3907,
+        1095, 1549,  125, 3635, 1970, 1129, 3381, 2574,  271, 1765, 3668, 2306, 1143,  305, 3760, 3465,
+        1097, 1713, 3652, 1278, 2570,  219,  805, 2781, 2099, 1620, 3220, 2865,  765, 2416, 3340, 1525,
+        3120, 3906, 2557, 2976, 3274,  748, 3654, 2512, 3979, 2963, 2269, 3409, 1468,  575, 3541,  153,
+        2790,  806,  504, 2295, 2878,  758, 1429,  311, 2220, 2919, 1720,  536, 3984, 1927, 3483,  496,
+        2061, 3335, 2821,  904, 2464,  221, 1563, 2028, 3873,  814, 2792,  427, 3321, 2940,  798, 2362,
+         440, 3002, 2118,  744, 3935, 1520, 3354, 1286, 3669,  528, 2331, 1353, 3545, 1074,  248, 2654,
+         983, 2116,  261, 1053, 1881,  151, 2830, 1235, 1666,  690,  345, 3796, 1862, 2986, 1108, 1685,
+        3421, 1996, 3647, 3223, 1036, 3602, 1914, 2751, 4023,  869, 3462, 2661, 1489, 2988,  881, 1739,
+        2603,  383, 1346, 3504, 1769, 3973, 2875,  591, 2361, 1304, 3523, 1937, 1576, 2154, 1320, 2737,
+        3990, 1456, 3440,  374, 2366, 3091, 2003,  302, 2560, 1035, 3826,   69, 1711, 3057, 4005, 1876,
+         479, 3309, 1731, 3612, 2322, 1381, 3379,  424, 2378, 3573, 2808, 1326,  104, 2414, 3967,  390,
+        1328, 2583,  197, 1266, 2150,  356, 3136,  621, 1165, 2060,  103, 1213, 3646,  292, 2471, 1219,
+        3069, 4080, 2313,  625, 3126,  459, 1222, 3651, 3113,  111, 2556,  956, 4036,   13, 3181, 1818,
+         192, 2279, 1008, 1803, 2802, 1064,  653, 3991, 3024, 1831, 3289, 2082, 2548,  514, 1391, 2879,
+        3677, 1284, 2722,  573, 3029, 4081, 2037,  932, 3173, 1973,  859, 2554, 3273,  935, 2057, 2893,
+        3841,  942, 1805, 4066, 2685, 1625, 3769, 2409, 1774, 3279, 3805, 2261,  734, 2021, 3305, 3684,
+         155, 1623,  985, 1981, 2663, 1494, 2258,  872, 1868, 1540, 3299,  518, 2329, 3556,  695, 1146,
+        3333,  613, 3764, 3218,   46, 3659, 1655, 2309, 1340,  768,  344, 2846,  906, 3715, 2185,  763,
+        2397,   12, 3926, 1606,  825,  243, 2671, 3782, 1481,  205, 4007, 1754,  503, 3703, 1567,  684,
+        3176, 2401, 2996,  639, 3307,  875, 1315,  238, 2989,  517, 1541, 2561, 3151, 1662,  534, 2216,
+         790, 2766, 3277, 3866,   27, 3560, 3235,  388, 2719, 3801, 1123, 2945, 1448, 2669, 1948, 3909,
+        2425, 2900, 1561, 2577, 1294, 2085, 3314,  215, 2795, 3481, 1575, 3972, 1243, 3329,  201, 1793,
+        3172, 1025, 2134, 3425, 2547, 1142, 1741,  545, 2957, 1160, 2170, 3441, 1413, 3072, 2242,   11,
+        1716,  458, 1454, 2265,   99, 2048, 3470, 2592, 3954, 1022, 2835,  226,  947, 4019, 2730, 1447,
+        3817, 1870,  325, 1309, 2406, 1041, 1717, 4054, 2373,  672, 2074, 3674,  360,  883, 3009,  272,
+        1331, 2006,  379,  818, 4056,  552, 2521,  961, 3876, 2049, 2461,  631, 1845, 2339, 2973, 1428,
+        3531, 2605,  447, 1312, 1934, 3724, 3257, 2294, 3543, 2591,  687, 2860,  285, 1114, 2707, 3532,
+        1170, 3334, 3696, 1042, 3905, 2834, 1701,  720, 2130, 1389, 3705, 1829, 3362, 1226,   55, 3453,
+        1038, 2482, 2998, 3626,  574, 2856, 2051,  264, 1370, 3212,  149, 1706, 2280, 3413, 1639, 3579,
+         946, 3830, 3127, 2246, 3461, 1533, 3031, 1883,  474, 1185,   35, 3081, 3570,  359, 1107, 4040,
+         636, 1699, 3804, 3100,  128, 2848,  387,  905, 1600,   51, 3881, 1848, 2438, 3785,  803, 2002,
+        2600,  190, 2740, 1856, 3148,  363, 1121, 3628,   10, 3124, 2389,  429, 2192, 2631, 1961, 3054,
+         441, 1528,  728, 2122, 1610, 3397,  783, 2982, 3622,  980, 2788, 3859, 1169, 2522,  588, 2124,
+        2738,  136, 1665, 1063, 2713,  120, 1237, 3637, 3236, 2664, 3730, 1354, 2743,  795, 2559, 2020,
+         105, 2814,  951, 2413,  752, 2177, 1343, 4028, 1990, 3162, 1292,  930, 3268, 1657,  487, 3945,
+        2233,  892, 1608,  533, 2431, 1407, 2226, 2895, 1781,  893, 3513,  669, 3925, 1507,  782, 3781,
+        2259, 3225, 3957, 2746,  114, 3887, 1212, 2230, 1564, 2485, 1911,  725, 3107,   74, 4082, 1422,
+        3247, 2448, 3419,  568, 2013, 3858, 2387,  741, 1589, 2264,  919, 1743, 2141, 3900, 1626, 3019,
+        3420, 2187, 1458, 3266, 3917, 1732, 3469, 2514,  609, 2773, 2229, 3584,  140, 2139, 3026, 1400,
+        3606, 2930, 4035, 3451,  849, 3793, 3342,  600, 4083, 2551, 1616, 1168, 3025,  250, 2869, 1117,
+        1782,  224, 1253,  880, 1964, 2523,  502, 3256,  200, 3992,  417, 3490, 1486, 1838, 2904,  848,
+         457, 1866, 1217, 3676, 3001,  376, 1785, 2780,  176, 4044,  509, 3452,  137, 3177,  404, 1233,
+         715, 3662,  328, 1917,  486,  966, 3044,  260, 1166, 3802,  340, 1530, 2897,  773, 3423,  275,
+         598, 1153, 2102,   65, 1896, 2648,  242, 1992, 1268,  343, 2799, 1968, 3455, 2367, 3631,  547,
+        2677, 3347, 2380, 3699, 3108, 1466, 3553, 1775,  850, 2887, 1307, 2254, 2716, 3761, 1096, 3448,
+        2304, 3951,  757, 2541, 1493,  978, 3161, 3506, 1148, 3087, 1892, 2880, 1052, 1473, 2307, 3808,
+        1787, 2493, 1104, 2876, 3580, 2636, 1568, 2310, 3388, 1835,  858, 2564, 4084, 1196, 2399, 1910,
+        1569, 3271, 2537, 1285, 3043, 1595, 1088, 3183, 2300, 3767, 3306,   77,  911, 1700, 1317, 2126,
+        4063, 1552,  642, 1812,  337, 1007, 2784, 2325, 3704, 2092, 3222, 1028,  617,  273, 2031, 2627,
+         194, 1562, 2841,   71, 2208, 3937,  463, 2094, 1515, 2552,  778, 2227, 3745, 2711, 3390,  922,
+        2774,  159, 4085, 2275, 1270,   59, 3870,  740, 1445, 3062, 3551, 2012,  400, 1740, 3693, 2689,
+        3929,  295,  776, 3393, 3879,  622, 2888, 3643,  815, 1500,  644, 2161, 3892, 2653,  286, 3058,
+         969,    9, 2932, 3484, 2173, 4024,  141, 1232,  562, 1554,    8, 3642, 2449, 3341, 1615, 3867,
+        1281, 3109, 3638, 1897, 3337, 1272, 2601,  691, 3609,  300, 3889, 1341,  247,  673, 1958,  480,
+        3149, 1436, 3303,  559, 1697, 3412, 2077, 2912,  202, 2368,  520, 1090, 3246, 2828,   39,  974,
+        2213, 2882, 1794, 2336,  334, 2127, 2479,   98, 1804, 2587, 2997, 1296, 3194,  511, 3515, 1929,
+        3728, 2445, 1271,  846, 2662, 1421, 3085, 3403, 2486, 3837, 1986, 2818, 1420,  764, 2891,  381,
+         925, 2165,  577, 1106,  338, 2950, 3726, 1836, 2330, 1070, 3168, 1718, 3529, 2588, 1593, 3930,
+        2183, 1016, 1930, 2968,  808, 2585, 1030, 1806, 4003, 1293, 2734, 3742, 2255,  737, 1453, 3122,
+         535, 3583, 1027, 3737, 1409,  885, 3939, 1218, 3444,  445, 4011, 1882, 1046, 2326, 1510,  699,
+        2756, 1742, 3267, 3877,  434, 2000,  698, 1852,  975, 2960,  492, 1140, 4037, 1810, 2262, 3600,
+        3250, 1727, 2684, 4051, 2357, 1678,  926,   33, 3315, 2697,  586, 2937, 2155, 1128, 3064,    7,
+        2473, 3658,  358, 3508, 2149, 3818,  405, 3221,  627, 3459, 1555,  164, 1694, 3983, 3471, 1984,
+        1322, 1642,   85, 2582, 3140, 1734, 3296, 2025, 2769,  955, 2251,  217, 2806, 3803, 3330, 1200,
+         187, 2238,  350, 1627, 2423, 3569, 2862, 3941,  316, 1460, 3492, 2388,  166, 3153,  567, 1369,
+        2474,  296, 3442, 1423,  732, 3263, 2651, 1338, 3976, 1548, 2008,  134, 4060,  822, 3449, 1367,
+         634, 1673, 2688, 1313,  130, 1491, 2741, 1204, 2452, 2131,  845, 3167, 2647, 1156,  318, 2540,
+        3920, 2776, 3310, 2053,  478, 2872,  259,  685, 1534, 3716, 3053, 1688,  813,  402, 2064, 2939,
+        3948, 3463, 1111, 3077,  787, 1245,   88, 1671, 2606, 3234, 1872,  841, 2748, 3756, 1120, 2040,
+        3914,  820, 2967, 2022,  148, 3810, 1935,  519, 2241,  839, 3675, 1262, 2428,  432, 1903, 2624,
+        3831, 3191,  842, 3998, 2344, 3373, 1952, 3714,    6, 2955, 3827, 1978,  566, 2175, 2941,  873,
+         246, 1889, 1174,  712, 4086, 1282, 2191, 3825, 2508,  121, 1318, 3566, 3216, 2602, 1771,  900,
+        1465,  582, 1949, 2768, 3814, 2113, 3372, 2314, 1181,  607, 3880, 2157, 1618,  364, 2571, 3017,
+          37, 1653, 1069, 3692, 2467, 1159, 2890, 3564, 3112,  351, 3291, 2796, 1687, 3727, 2906,  989,
+        2160,  240, 1867, 2942, 1089,  645, 3073,  888, 1752, 1393,  369, 1066, 3398, 3688, 1750, 3275,
+         647, 3752, 2462, 3464, 1588, 2695, 3383, 1094, 3121, 1954,  646, 2403, 1087, 4087,  101, 2352,
+        3238, 2530, 3645,  210, 1437,  524, 2726,  898, 3656, 3006,   58, 1267, 3614, 3326,  877, 1813,
+        3510, 2694, 2281,  399, 3205, 1527,  252,  901, 1763, 2517, 1054, 2133,  578, 3201,  107, 1594,
+        3431, 1242, 2550,  464, 3671, 1674,  235, 2546, 4018, 3323, 2385, 2847, 1532,   79, 1211, 2277,
+        1382, 2870,  367,  996, 2337,   56,  829, 1745,  353, 3620, 2864, 2095,  438, 1374, 3032, 3605,
+         333, 1667, 1006, 2260, 3278, 1840, 4048,  229, 2032, 1592, 2472, 2839,  633, 2303, 1425, 4088,
+         649, 1289, 3343, 1800,  667, 4027, 2194, 2771, 1363, 3921,  157, 3496, 1497,  894, 2291, 4010,
+         589, 3007, 3774, 1464, 2129, 2800, 3537, 2066, 1116,  610, 1816, 3871,  817, 2518, 4030, 3050,
+        3572, 1630, 2078, 3155, 3731, 1913, 2902, 3946, 2454, 1455,  889, 3779, 3324, 1644, 2015,  779,
+        1240, 2909, 3968,  701, 2616, 1068, 3079, 1385, 3429,  467, 3974, 1040, 3219, 1938,  139, 2442,
+        3068,  313, 3833,  944, 2626, 3086, 1878, 3679,  594, 2284, 2978, 1908, 3806, 2589, 1321, 2775,
+        1994,  884, 2308,   49, 3175,  774, 1335,  341, 3134, 2753,  174, 2186, 3184,  469, 1932,  920,
+        2566,  572, 3942,  232, 1401,  668, 3436, 1250,  579, 3230, 1815,   40, 2563,  571, 2801, 3891,
+        2167, 3376, 1865,   30, 3685, 1658,  422, 2402, 2854,  797, 2135, 1735,  323, 3723, 2901, 1086,
+        2043, 1603, 2827, 2119, 1403,  468, 1102,   57, 3392, 1641,  756, 1172,  257, 3352,  495, 3563,
+         212, 1656, 3328, 1155, 4089, 1809, 2436, 3822, 1612, 3666, 1378, 1029, 3518, 1587, 2782,  189,
+        2218, 1251, 2762, 1783, 3046, 2535, 2052,  173, 2296, 2704, 4002, 1297, 2203, 3712, 1124,  138,
+        2625,  473, 1398, 2350, 3004,  781, 3897, 1894, 1125, 3755, 2638, 3507, 1364, 2538,  538, 3869,
+        3226,  766, 3603,  126, 3365, 3901, 2390, 2907, 1252, 2655, 4090, 2447, 3060, 2090, 1758, 1079,
+        3083, 3847, 2529,  638, 2687,  472, 2992,  954, 2298,  683, 2615, 2987, 2034,  723, 3800, 3260,
+        1842, 3382,  792, 3613,  435, 1011, 3884, 1597, 3516, 1033,  392, 2927,  824, 3143, 1808, 3495,
+        1605,  976, 2858, 3539, 1193, 2114, 3371,  163, 3224, 1495,  249,  717, 3082,  903, 1843, 1434,
+         195, 2353, 1199, 2539, 1764,  855, 1570, 3627, 2041,  335, 3297,  549, 1480,  821, 3960, 2629,
+        2162,  378, 1461, 1975, 3629, 1299, 3402,  102, 1959, 3304,  415, 4000,   34, 2415, 1417,  990,
+        4059,  147, 2453, 1201, 2270, 3290, 2675,  754, 3071, 1759, 2104, 3616, 1459,  321, 2465,  704,
+        3074, 4057, 1936,  635,  303, 2723, 1376, 2515,  616, 2274, 2943, 1971, 3989, 2365, 3387, 2686,
+        3505, 1902, 4017,  508, 3158, 2759,  307,  722, 3089,  968, 1811, 2219, 3653, 2786,   67, 1386,
+         709, 3500,  939, 2921,  276, 2244, 1698, 3970, 1138, 2470, 1503, 1847, 1207, 3562, 3066,  409,
+        1518, 2933, 1980, 3848, 1490,    5, 1888, 1325,  324, 3777,  663, 2597, 3380, 1957, 3849, 1329,
+        2243,  168, 2520, 3725, 3152, 1707, 3596, 1012, 4091, 1724, 3446, 1186,   29, 1566,  401, 1130,
+         692, 3010, 1511,  960, 2152, 3476, 1901, 3772, 2346, 1439, 3861,  167, 1157, 3261, 2318, 3706,
+        3027, 1767, 2376, 3936, 3237,  751, 2640,  510, 2884, 3757,  867, 3445, 2791,  615, 2101, 2665,
+        3697, 1062,  488, 3163,  706, 3557, 2910, 4092, 2188, 2721, 1147, 1669,  191, 1004, 2727,  485,
+        3327, 1733,  940, 1442, 2267,  819,   60, 2001, 2680,  411,  863, 2487, 3736, 2062, 2885, 3918,
+        2202,  233, 2642, 3784,    4, 1352, 1067, 2649,  227, 3349, 2877, 2581,  606, 1583, 1907,  326,
+        1122, 2754,  216, 1572, 1075, 1921, 3673, 1373, 2145,  179, 3110, 2257,  301, 3916, 1726,  809,
+        2272, 3487, 2785, 1749, 2580, 2125,  446,  914, 3312,  122, 3156, 2358, 4020, 3056, 2147, 3599,
+        1163, 2944, 3860,  375, 3406, 2777, 3834, 3045, 1220, 3641, 3118, 1479,  537, 3186,  823, 1632,
+        3574, 1241, 3311, 1725, 2420, 2934, 3985,  624, 1753, 1184,  794, 2024, 3503, 2929,  874, 3346,
+        4061, 2036,  659, 3517, 2829,   28, 3065,  933, 3549, 1778,  726, 1362, 2595,  999, 3367,   95,
+        1915, 1372,  315,  965, 3910, 1195, 1640, 2504, 1380, 1834, 3640,  483, 1342,  736, 1556,    3,
+        1899,  721, 2657, 2038, 1192, 1801,  632, 1519, 2323,  196, 2103, 2700, 3525, 1254, 2429,  298,
+        2760, 2010,  521,  837, 3665,  419, 1989, 3128, 3538, 2225, 4039,  346, 1306, 3839, 2531,  531,
+        1521, 3178, 2586, 1339, 2283, 3882, 1628, 2463,  348, 2683, 4093, 1988, 3171, 1483, 2382, 3022,
+         665, 3955, 2475, 3353,  110, 3003, 3426, 3739,  641, 2811,  959, 2075, 2947, 3763, 2510, 3241,
+        3988, 2374,  239, 3575, 2980,  450, 2501, 3480,  941, 3952, 1784,  788,  115, 3893, 1946, 3080,
+         928, 4094, 2532, 3214, 2199, 1509,  899, 2394,   84, 1544, 2961, 2455, 1757,    2, 2009, 1176,
+        2273,  123,  997, 3747,  370, 2045,  619, 3188, 1505, 3375, 1135,   68, 3610,  489, 3824, 1198,
+        2673, 3169, 1602, 1997, 2351,  731, 1884,  347, 2268, 3934, 1506, 3414,  211, 1756,  992,  505,
+        1419, 3103, 1249, 1659,  918, 4034, 2120, 3139,  322, 2767, 1301, 3386, 2311, 1654,  597, 3374,
+        1487,   78, 1652, 1173,  209, 3450, 2807, 1224, 3770,  569, 1037, 3457,  729, 3632, 3114, 2749,
+        3886, 3473, 1871, 2999,  810, 2733, 1194, 3949, 2297,  557, 2914, 2169,  865, 2857, 1841,  213,
+        3594,  857,  423, 1131, 3540, 1450, 2861, 1059, 3204,   72, 2533,  705, 2744, 2228, 3466, 2867,
+        2117,  800, 3813, 2288, 3319,   83, 1126, 1446, 1905, 3766,  433, 3051,  972, 2916, 2572, 1134,
+        3773, 2080, 2991, 2652, 3947,  592, 1679, 3244, 2528, 1859, 3192, 2081, 2690, 1485,  950,  280,
+        1703,  708, 2395, 1438, 3370, 1736, 3586,  131,  984, 1855, 3828, 1348, 2524, 1645, 3300, 2231,
+        1482, 2076, 3038, 4022, 2506,  181, 3832, 2016, 1550, 3519, 1162, 1926, 3994, 1273,  287, 1647,
+        3589,  177, 2765,  494, 1944, 2575, 2886, 3634,  743, 2478, 2164, 1508, 4041,  251, 3576,  426,
+        2393,  674, 3608,  878, 1877, 2305, 3700,  293,  807, 3964,  143, 1279,  372, 4012, 2182, 3358,
+        1231, 2851,  461, 4032,  207, 2253, 2981, 1463, 2645, 3092,  274, 3509,  630, 4014,  352, 1014,
+        3878,   82, 2693,  599, 1760,  937, 2637, 3098,  449, 2210, 2951,  327, 3170,  851, 3751, 2381,
+        1141, 1830, 3210, 1475, 3694,  670, 1631,  241, 3293, 1098, 3498,  629, 1974, 1257, 2151, 1755,
+        2892, 1345, 3269,  413, 1392, 3015, 1031, 2109, 1476, 2849, 2319, 3522, 2990, 1788,  515, 2569,
+        3733, 2115, 3131, 1103, 2543,  866,  491, 2087, 3748,  727, 2379, 1586, 2805, 1227, 2359, 2883,
+        1776, 3322, 1248, 2276, 3195, 3618, 1351,  739, 4062,  913, 3615, 1704, 2456, 1501, 2938,  648,
+        2702, 4095,  915, 2430, 1215, 3023, 3959, 2293, 2728, 1744,    1, 2611, 3709, 2797, 3325,  923,
+        3996,  132, 1963, 2466, 3894,   48, 2599, 3588, 3137, 1083,  542, 1629,  784, 2372, 3239, 1451,
+         861,   52, 1601, 3432, 1940, 3786, 3202, 1187, 3408, 1772, 1051, 3196,    0, 1972, 3698,  543,
+        2490,  811, 3762, 1553,  389, 2067,  262, 2418, 1826, 2757, 1288,  623, 3896,  112, 1953, 3360,
+         416, 2196,   53, 3454,  386, 1821,  982,  540, 1314, 3799, 3165,  916, 1622,  171,  656, 2422,
+        1578, 3502, 1101, 2816, 1636, 3399,  688, 1748,  365, 2014, 3863, 2596, 3644, 1152,  160, 3851,
+        1887, 3555, 2712,  603, 1337, 2825, 1681,   92, 2553,  368, 3898, 2137, 3478,  864, 3042, 1368
+    };
+    return ranks;
+}
+
+
+inline const std::array<float, blueNoiseMapSize * blueNoiseMapSize>& blue_noise_map (void)
+{
+    static const std::array<float, blueNoiseMapSize * blueNoiseMapSize> map = []()
+    {
+        const uint16_t* rank = blue_noise_ranks();
+        std::array<float, blueNoiseMapSize * blueNoiseMapSize> out {};
+        for (std::size_t i = 0; i < out.size(); i++)
+            out[i] = (static_cast<float>(rank[i]) + 0.5f) / static_cast<float>(out.size());
+        return out;
+    }();
+    return map;
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_INTERPOLATOR_DITHER_MAPS__
@@ -0,0 +1,140 @@
+#ifndef __LUT_INTERPOLATOR_IMAGE_VIEW__
+#define __LUT_INTERPOLATOR_IMAGE_VIEW__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// Storage format of one color component
+enum class PixelFormat : uint32_t
+{
+    U8 = 0,     // uint8_t,  [0...255]
+    U10Packed,  // uint32_t per pixel: R - bits 0...9, G - bits 10...19, B - bits 20...29, A - bits 30...31 (interleaved only)
+    U12,        // uint16_t, [0...4095], LSB aligned
+    U16,        // uint16_t, [0...65535]
+    F16,        // IEEE 754 half float stored in uint16_t
+    F32         // float
+};
+
+enum class PixelLayout : uint32_t
+{
+    Interleaved = 0,  // RGB[A] RGB[A] ...
+    Planar            // separate plane per component: R, G, B [, A]
+};
+
+
+inline std::size_t pixel_format_bytes (const PixelFormat format) noexcept
+{
+    switch (format)
+    {
+        case PixelFormat::U8:        return 1u;
+        case PixelFormat::U10Packed: return 4u;
+        case PixelFormat::U12:
+        case PixelFormat::U16:
+        case PixelFormat::F16:       return 2u;
+        case PixelFormat::F32:       return 4u;
+    }
+    return 0u;
+}
+
+
+// --- Non-owning description of image buffer ---
+// Integer formats normalized to [0...1] on read and quantized with rounding on write; float formats used as is.
+struct ImageView
+{
+    std::array<void*, 4> plane {{ nullptr, nullptr, nullptr, nullptr }}; // interleaved: plane[0] only; planar: R, G, B, A
+    std::size_t width  = 0u;
+    std::size_t height = 0u;
+    std::size_t rowStride = 0u;  // bytes between rows (of each plane); 0 - rows tightly packed
+    PixelFormat format = PixelFormat::F32;
+    PixelLayout layout = PixelLayout::Interleaved;
+    bool hasAlpha = false;
+
+    std::size_t channels (void) const noexcept { return (true == hasAlpha ? 4u : 3u); }
+
+    // number of storage elements per pixel in one plane
+    std::size_t pixel_elements (void) const noexcept
+    {
+        return (PixelFormat::U10Packed == format || PixelLayout::Planar == layout) ? 1u : channels();
+    }
+
+    std::size_t row_bytes (void) const noexcept
+    {
+        return (0u != rowStride ? rowStride : width * pixel_elements() * pixel_format_bytes(format));
+    }
+
+    template <typename S>
+    S* row (const std::size_t plane_idx, const std::size_t y) const noexcept
+    {
+        return reinterpret_cast<S*>(static_cast<uint8_t*>(plane[plane_idx]) + y * row_bytes());
+    }
+};
+
+
+inline ImageView make_interleaved_view
+(
+    void* data,
+    const std::size_t width,
+    const std::size_t height,
+    const PixelFormat format,
+    const bool hasAlpha = false,
+    const std::size_t rowStride = 0u
+) noexcept
+{
+    ImageView view;
+    view.plane[0]  = data;
+    view.width     = width;
+    view.height    = height;
+    view.rowStride = rowStride;
+    view.format    = format;
+    view.layout    = PixelLayout::Interleaved;
+    view.hasAlpha  = hasAlpha;
+    return view;
+}
+
+
+inline ImageView make_planar_view
+(
+    void* r, void* g, void* b, void* a,
+    const std::size_t width,
+    const std::size_t height,
+    const PixelFormat format,
+    const std::size_t rowStride = 0u
+) noexcept
+{
+    ImageView view;
+    view.plane     = {{ r, g, b, a }};
+    view.width     = width;
+    view.height    = height;
+    view.rowStride = rowStride;
+    view.format    = format;
+    view.layout    = PixelLayout::Planar;
+    view.hasAlpha  = (nullptr != a);
+    return view;
+}
+
+
+inline LutErrorCode::LutState validate_image_view (const ImageView& view) noexcept
+{
+    const std::size_t planes = (PixelLayout::Planar == view.layout ? view.channels() : 1u);
+    for (std::size_t i = 0; i < planes; i++)
+        if (nullptr == view.plane[i])
+            return LutErrorCode::LutState::NotInitialized;
+
+    if (0u == view.width || 0u == view.height)
+        return LutErrorCode::LutState::IncorrectDimension;
+    if (PixelFormat::U10Packed == view.format && PixelLayout::Planar == view.layout)
+        return LutErrorCode::LutState::IncorrectDimension;
+    if (0u != view.rowStride && view.rowStride < view.width * view.pixel_elements() * pixel_format_bytes(view.format))
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    return LutErrorCode::LutState::OK;
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_INTERPOLATOR_IMAGE_VIEW__
@@ -0,0 +1,169 @@
+#ifndef __LUT_BLEND_INTERPOLATOR__
+#define __LUT_BLEND_INTERPOLATOR__
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutElement.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// minimal number of pixels processed by one worker thread
+constexpr std::size_t blendGrainPixels = 8192u;
+
+
+// --- Mix lattices of equal size: out = lutA * (1 - weight) + lutB * weight ---
+// Returns false if lattices can't be pre-mixed without changing result (different size or domain,
+// or lattice nodes outside of domain, so output clamp of separate LUTs isn't equal to clamp of mixed LUT).
+template <typename T>
+bool blend_lattice (const LatticeView<T>& lutA, const LatticeView<T>& lutB, const T weight, LutElement::lutTable3D<T>& out)
+{
+    if (!lutA.valid() || lutA.lutSize != lutB.lutSize || lutA.domainMin != lutB.domainMin || lutA.domainMax != lutB.domainMax)
+        return false;
+
+    const std::size_t elements = lutA.elements();
+    const T wA = T(1) - weight;
+    out.resize(elements);
+
+    bool inDomain = true;
+    for (std::size_t i = 0; i < elements; i += 3)
+    {
+        for (std::size_t c = 0; c < 3; c++)
+        {
+            const T a = lutA.data[i + c];
+            const T b = lutB.data[i + c];
+            inDomain = inDomain && a >= lutA.domainMin[c] && a <= lutA.domainMax[c] && b >= lutB.domainMin[c] && b <= lutB.domainMax[c];
+            out[i + c] = a * wA + b * weight;
+        }
+    }
+    return inDomain;
+}
+
+
+// --- Fused kernel: both lookups and mix computed per pixel, frame read and written once ---
+// 'weights' - per pixel weight (may be nullptr, than 'weight' used for all pixels)
+template <typename T>
+void blend_interpolation_fused
+(
+    const LatticeView<T>& lutA,
+    const LatticeView<T>& lutB,
+    const T weight,
+    const T* weights,
+    const T* src,
+    T* dst,
+    const std::size_t pixels
+) noexcept
+{
+    const bool sameLattice = (lutA.lutSize == lutB.lutSize);
+    TetraCell<T> cellA, cellB;
+    T outA[3], outB[3];
+
+    for (std::size_t i = 0; i < pixels; i++, src += 3, dst += 3)
+    {
+        tetrahedral_cell (src[0], src[1], src[2], lutA.lutSize, cellA);
+        if (false == sameLattice)
+            tetrahedral_cell (src[0], src[1], src[2], lutB.lutSize, cellB);
+
+        tetrahedral_eval (lutA.data, cellA, outA);
+        tetrahedral_eval (lutB.data, (sameLattice ? cellA : cellB), outB);
+        domain_clamp (lutA, outA);
+        domain_clamp (lutB, outB);
+
+        const T w  = (nullptr != weights ? weights[i] : weight);
+        const T wA = T(1) - w;
+        dst[0] = outA[0] * wA + outB[0] * w;
+        dst[1] = outA[1] * wA + outB[1] * w;
+        dst[2] = outA[2] * wA + outB[2] * w;
+    }
+    return;
+}
+
+
+// --- Blend two LUTs with scalar weight: dst = lutA(src) * (1 - weight) + lutB(src) * weight ---
+// LUTs of the same size pre-mixed into single lattice and interpolated once per pixel.
+// src and dst may point to the same buffer of interleaved RGB pixels.
+template <typename T>
+void blend_interpolation
+(
+    const LatticeView<T>& lutA,
+    const LatticeView<T>& lutB,
+    const T weight,
+    const T* src,
+    T* dst,
+    const std::size_t pixels,
+    const uint32_t threads = 0u
+)
+{
+    if (weight <= T(0) || weight >= T(1))
+    {
+        // one of LUTs doesn't contribute to result
+        const LatticeView<T>& lut = (weight <= T(0) ? lutA : lutB);
+        LutParallel::parallel_for (0u, pixels, blendGrainPixels,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            { tetrahedral_interpolation (lut, src + begin * 3u, dst + begin * 3u, end - begin); },
+            threads);
+        return;
+    }
+
+    LutElement::lutTable3D<T> mixed;
+    if (true == blend_lattice (lutA, lutB, weight, mixed))
+    {
+        LatticeView<T> lut = lutA;
+        lut.data = mixed.data();
+        LutParallel::parallel_for (0u, pixels, blendGrainPixels,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            { tetrahedral_interpolation (lut, src + begin * 3u, dst + begin * 3u, end - begin); },
+            threads);
+    }
+    else
+    {
+        LutParallel::parallel_for (0u, pixels, blendGrainPixels,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            { blend_interpolation_fused (lutA, lutB, weight, static_cast<const T*>(nullptr), src + begin * 3u, dst + begin * 3u, end - begin); },
+            threads);
+    }
+    return;
+}
+
+
+// --- Blend two LUTs with per-pixel weight (matte, gradient, crossfade mask) ---
+template <typename T>
+void blend_interpolation
+(
+    const LatticeView<T>& lutA,
+    const LatticeView<T>& lutB,
+    const T* weights,
+    const T* src,
+    T* dst,
+    const std::size_t pixels,
+    const uint32_t threads = 0u
+)
+{
+    LutParallel::parallel_for (0u, pixels, blendGrainPixels,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        { blend_interpolation_fused (lutA, lutB, T(0), weights + begin, src + begin * 3u, dst + begin * 3u, end - begin); },
+        threads);
+    return;
+}
+
+
+// --- Same API for LUT objects (CCubeLut3D<T>, ...); 'weight' is scalar or pointer to per-pixel weights ---
+template <typename LutObjectA, typename LutObjectB, typename T, typename W>
+auto blend_interpolation (LutObjectA& lutA, LutObjectB& lutB, const W weight, const T* src, T* dst, const std::size_t pixels, const uint32_t threads = 0u)
+    -> decltype(void(make_lattice_view (lutA)), void(make_lattice_view (lutB)))
+{
+    blend_interpolation (make_lattice_view (lutA), make_lattice_view (lutB), weight, src, dst, pixels, threads);
+    return;
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_BLEND_INTERPOLATOR__
@@ -0,0 +1,239 @@
+#ifndef __LUT_COLOR_CACHE_INTERPOLATOR__
+#define __LUT_COLOR_CACHE_INTERPOLATOR__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+
+namespace Interpolator
+{
+
+constexpr std::size_t colorCacheEntries  = 4096u;   // per thread, power of 2
+constexpr std::size_t colorCacheProbes   = 4u;      // linear probing distance before eviction
+constexpr std::size_t colorCacheGrain    = 16384u;  // pixels per parallel job
+constexpr std::size_t colorCacheSample   = 4096u;   // pixels inspected for hit rate estimation
+constexpr double      colorCacheMinHitRate = 0.6;   // estimated hit rate required for cached path
+
+
+// --- Hit rate telemetry ---
+struct ColorCacheStats
+{
+    uint64_t lookups = 0u;
+    uint64_t hits = 0u;
+
+    double hit_rate (void) const noexcept { return (0u != lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0); }
+    void merge (const ColorCacheStats& other) noexcept { lookups += other.lookups; hits += other.hits; }
+};
+
+
+// --- Open addressing table: input triplet -> LUT output ---
+// Key is bit pattern of the input triplet, so cached result identical to direct evaluation.
+template <typename T>
+class ColorCache
+{
+public:
+    using Bits = typename std::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type;
+
+    ColorCache (void) : m_entries (colorCacheEntries), m_used (colorCacheEntries, 0u) {}
+
+    void clear (void) { std::fill (m_used.begin(), m_used.end(), uint8_t(0u)); }
+
+    static std::size_t hash (const Bits* key) noexcept
+    {
+        uint64_t h = static_cast<uint64_t>(key[0]) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint64_t>(key[1]) * 0xC2B2AE3D27D4EB4Full;
+        h ^= static_cast<uint64_t>(key[2]) * 0x165667B19E3779F9ull;
+        h ^= (h >> 29);
+        return static_cast<std::size_t>(h) & (colorCacheEntries - 1u);
+    }
+
+    // returns cached output or nullptr; 'slot' receives insertion position for miss
+    const T* find (const Bits* key, std::size_t& slot) const noexcept
+    {
+        const std::size_t home = hash (key);
+        slot = home;
+        for (std::size_t i = 0; i < colorCacheProbes; i++)
+        {
+            const std::size_t idx = (home + i) & (colorCacheEntries - 1u);
+            if (0u == m_used[idx])
+            {
+                slot = idx;
+                return nullptr;
+            }
+            const Entry& e = m_entries[idx];
+            if (e.key[0] == key[0] && e.key[1] == key[1] && e.key[2] == key[2])
+                return e.value;
+        }
+        return nullptr; // probing sequence full: evict home slot
+    }
+
+    void insert (const std::size_t slot, const Bits* key, const T* value) noexcept
+    {
+        Entry& e = m_entries[slot];
+        e.key[0] = key[0]; e.key[1] = key[1]; e.key[2] = key[2];
+        e.value[0] = value[0]; e.value[1] = value[1]; e.value[2] = value[2];
+        m_used[slot] = 1u;
+        return;
+    }
+
+    static void make_key (const T* in, Bits* key) noexcept { std::memcpy (key, in, 3u * sizeof(T)); }
+
+private:
+    struct Entry
+    {
+        Bits key[3];
+        T value[3];
+    };
+    std::vector<Entry> m_entries;
+    std::vector<uint8_t> m_used;
+};
+
+
+// --- Interpolate buffer through the cache: src and dst may point to the same buffer ---
+template <typename T>
+inline void cached_interpolation (const LatticeView<T>& lut, ColorCache<T>& cache, const T* src, T* dst,
+                                  const std::size_t pixels, ColorCacheStats& stats) noexcept
+{
+    typename ColorCache<T>::Bits key[3];
+    uint64_t hits = 0u;
+    for (std::size_t i = 0; i < pixels; i++, src += 3, dst += 3)
+    {
+        ColorCache<T>::make_key (src, key);
+        std::size_t slot;
+        if (const T* cached = cache.find (key, slot))
+        {
+            dst[0] = cached[0]; dst[1] = cached[1]; dst[2] = cached[2];
+            hits++;
+            continue;
+        }
+        tetrahedral_interpolation (lut, src, dst);
+        cache.insert (slot, key, dst);
+    }
+    stats.lookups += pixels;
+    stats.hits += hits;
+    return;
+}
+
+
+// --- Apply 3D LUT memoizing distinct input colors (per thread cache) ---
+// Intended for graphics, UI captures and posterized frames with small number of distinct colors.
+template <typename T>
+LutErrorCode::LutState cached_interpolation
+(
+    const LatticeView<T>& lut,
+    const T* src,
+    T* dst,
+    const std::size_t pixels,
+    const uint32_t threads = 0u,
+    ColorCacheStats* stats = nullptr
+)
+{
+    if (!lut.valid() || nullptr == src || nullptr == dst)
+        return LutErrorCode::LutState::NotInitialized;
+
+    const uint32_t workers = (0u != threads ? threads : LutParallel::threads_number());
+    std::vector<ColorCache<T>> caches (std::min(static_cast<std::size_t>(workers), pixels / colorCacheGrain + 1u));
+    std::vector<ColorCacheStats> partial (caches.size());
+
+    LutParallel::parallel_for (0u, pixels, colorCacheGrain,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t threadIdx)
+        { cached_interpolation (lut, caches[threadIdx], src + begin * 3u, dst + begin * 3u, end - begin, partial[threadIdx]); },
+        static_cast<uint32_t>(caches.size()));
+
+    if (nullptr != stats)
+    {
+        *stats = ColorCacheStats{};
+        for (const auto& p : partial)
+            stats->merge (p);
+    }
+    return LutErrorCode::LutState::OK;
+}
+
+
+// --- Estimate cache hit rate from few runs of pixels, without LUT evaluation ---
+template <typename T>
+double color_cache_hit_rate (const T* src, const std::size_t pixels, const std::size_t samplePixels = colorCacheSample)
+{
+    if (nullptr == src || 0u == pixels)
+        return 0.0;
+
+    constexpr std::size_t runs = 4u;
+    const std::size_t runLength = std::max(std::size_t(1u), std::min(pixels, samplePixels) / runs);
+    const T zero[3] = { T(0), T(0), T(0) };
+
+    ColorCache<T> cache;
+    ColorCacheStats stats;
+    typename ColorCache<T>::Bits key[3];
+    for (std::size_t r = 0; r < runs; r++)
+    {
+        const std::size_t begin = std::min(pixels - runLength, r * (pixels / runs));
+        const T* pSrc = src + begin * 3u;
+        for (std::size_t i = 0; i < runLength; i++, pSrc += 3)
+        {
+            ColorCache<T>::make_key (pSrc, key);
+            std::size_t slot;
+            if (nullptr != cache.find (key, slot))
+                stats.hits++;
+            else
+                cache.insert (slot, key, zero);
+            stats.lookups++;
+        }
+    }
+    return stats.hit_rate();
+}
+
+
+// --- Apply 3D LUT, using color cache when estimated hit rate high enough ---
+// 'stats' (optional) receives telemetry of the cached path; lookups == 0 if direct path selected.
+template <typename T>
+LutErrorCode::LutState adaptive_interpolation
+(
+    const LatticeView<T>& lut,
+    const T* src,
+    T* dst,
+    const std::size_t pixels,
+    const uint32_t threads = 0u,
+    ColorCacheStats* stats = nullptr
+)
+{
+    if (!lut.valid() || nullptr == src || nullptr == dst)
+        return LutErrorCode::LutState::NotInitialized;
+
+    if (color_cache_hit_rate (src, pixels) >= colorCacheMinHitRate)
+        return cached_interpolation (lut, src, dst, pixels, threads, stats);
+
+    if (nullptr != stats)
+        *stats = ColorCacheStats{};
+    LutParallel::parallel_for (0u, pixels, colorCacheGrain,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        { tetrahedral_interpolation (lut, src + begin * 3u, dst + begin * 3u, end - begin); },
+        threads);
+    return LutErrorCode::LutState::OK;
+}
+
+
+template <typename LutObject, typename T>
+auto cached_interpolation (LutObject& lut, const T* src, T* dst, const std::size_t pixels,
+                           const uint32_t threads = 0u, ColorCacheStats* stats = nullptr)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return cached_interpolation (make_lattice_view (lut), src, dst, pixels, threads, stats);
+}
+
+template <typename LutObject, typename T>
+auto adaptive_interpolation (LutObject& lut, const T* src, T* dst, const std::size_t pixels,
+                             const uint32_t threads = 0u, ColorCacheStats* stats = nullptr)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return adaptive_interpolation (make_lattice_view (lut), src, dst, pixels, threads, stats);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_COLOR_CACHE_INTERPOLATOR__
@@ -0,0 +1,399 @@
+#ifndef __LUT_IMAGE_INTERPOLATOR__
+#define __LUT_IMAGE_INTERPOLATOR__
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ImageView.hpp"
+#include "DitherMaps.hpp"
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "InterpolatorStatistics.hpp"
+#include "half_float.h"
+#include "parallel_for.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// number of pixels unpacked, interpolated and packed together (working set stays in L1)
+constexpr std::size_t imageTilePixels = 128u;
+
+
+// --- Conversion of single component between storage format and normalized value ---
+template <typename S, uint32_t MaxValue>
+struct IntegerCodec
+{
+    using storage_type = S;
+
+    template <typename T>
+    static T decode (const S s) noexcept { return static_cast<T>(s) * (T(1) / static_cast<T>(MaxValue)); }
+
+    template <typename T>
+    static S encode (const T v) noexcept { return static_cast<S>(clip(v, T(0), T(1)) * static_cast<T>(MaxValue) + T(0.5)); }
+};
+
+template <PixelFormat F> struct PixelCodec;
+template <> struct PixelCodec<PixelFormat::U8>  : IntegerCodec<uint8_t,  255u>   {};
+template <> struct PixelCodec<PixelFormat::U12> : IntegerCodec<uint16_t, 4095u>  {};
+template <> struct PixelCodec<PixelFormat::U16> : IntegerCodec<uint16_t, 65535u> {};
+
+template <> struct PixelCodec<PixelFormat::F16>
+{
+    using storage_type = uint16_t;
+
+    template <typename T>
+    static T decode (const uint16_t s) noexcept { return static_cast<T>(HalfFloat::to_float(s)); }
+
+    template <typename T>
+    static uint16_t encode (const T v) noexcept { return HalfFloat::from_float(static_cast<float>(v)); }
+};
+
+template <> struct PixelCodec<PixelFormat::F32>
+{
+    using storage_type = float;
+
+    template <typename T>
+    static T decode (const float s) noexcept { return static_cast<T>(s); }
+
+    template <typename T>
+    static float encode (const T v) noexcept { return static_cast<float>(v); }
+};
+
+template <> struct PixelCodec<PixelFormat::U10Packed>
+{
+    using storage_type = uint32_t;
+};
+
+
+// --- Unpack/pack part of image row: rgb - interleaved normalized triplets, alpha - normalized alpha per pixel ---
+// On pack 'alpha' equal to nullptr means opaque output.
+template <PixelFormat F, typename T>
+struct RowCodec
+{
+    using Codec = PixelCodec<F>;
+    using S = typename Codec::storage_type;
+
+    static void unpack (const ImageView& img, const std::size_t y, const std::size_t x0, const std::size_t count, T* rgb, T* alpha) noexcept
+    {
+        if (PixelLayout::Interleaved == img.layout)
+        {
+            const std::size_t ch = img.channels();
+            const S* p = img.row<S>(0, y) + x0 * ch;
+            for (std::size_t i = 0; i < count; i++, p += ch, rgb += 3)
+            {
+                rgb[0] = Codec::template decode<T>(p[0]);
+                rgb[1] = Codec::template decode<T>(p[1]);
+                rgb[2] = Codec::template decode<T>(p[2]);
+            }
+            if (true == img.hasAlpha)
+            {
+                p = img.row<S>(0, y) + x0 * ch + 3u;
+                for (std::size_t i = 0; i < count; i++, p += ch)
+                    alpha[i] = Codec::template decode<T>(*p);
+            }
+        }
+        else
+        {
+            const S* r = img.row<S>(0, y) + x0;
+            const S* g = img.row<S>(1, y) + x0;
+            const S* b = img.row<S>(2, y) + x0;
+            for (std::size_t i = 0; i < count; i++, rgb += 3)
+            {
+                rgb[0] = Codec::template decode<T>(r[i]);
+                rgb[1] = Codec::template decode<T>(g[i]);
+                rgb[2] = Codec::template decode<T>(b[i]);
+            }
+            if (true == img.hasAlpha)
+            {
+                const S* a = img.row<S>(3, y) + x0;
+                for (std::size_t i = 0; i < count; i++)
+                    alpha[i] = Codec::template decode<T>(a[i]);
+            }
+        }
+        return;
+    }
+
+    static void pack (const ImageView& img, const std::size_t y, const std::size_t x0, const std::size_t count, const T* rgb, const T* alpha) noexcept
+    {
+        const S opaque = Codec::template encode<T>(T(1));
+        if (PixelLayout::Interleaved == img.layout)
+        {
+            const std::size_t ch = img.channels();
+            S* p = img.row<S>(0, y) + x0 * ch;
+            for (std::size_t i = 0; i < count; i++, p += ch, rgb += 3)
+            {
+                p[0] = Codec::template encode<T>(rgb[0]);
+                p[1] = Codec::template encode<T>(rgb[1]);
+                p[2] = Codec::template encode<T>(rgb[2]);
+            }
+            if (true == img.hasAlpha)
+            {
+                p = img.row<S>(0, y) + x0 * ch + 3u;
+                for (std::size_t i = 0; i < count; i++, p += ch)
+                    *p = (nullptr != alpha ? Codec::template encode<T>(alpha[i]) : opaque);
+            }
+        }
+        else
+        {
+            S* r = img.row<S>(0, y) + x0;
+            S* g = img.row<S>(1, y) + x0;
+            S* b = img.row<S>(2, y) + x0;
+            for (std::size_t i = 0; i < count; i++, rgb += 3)
+            {
+                r[i] = Codec::template encode<T>(rgb[0]);
+                g[i] = Codec::template encode<T>(rgb[1]);
+                b[i] = Codec::template encode<T>(rgb[2]);
+            }
+            if (true == img.hasAlpha)
+            {
+                S* a = img.row<S>(3, y) + x0;
+                for (std::size_t i = 0; i < count; i++)
+                    a[i] = (nullptr != alpha ? Codec::template encode<T>(alpha[i]) : opaque);
+            }
+        }
+        return;
+    }
+};
+
+
+// 10:10:10:2 packed pixels; alpha (if present) stored in 2 upper bits
+template <typename T>
+struct RowCodec<PixelFormat::U10Packed, T>
+{
+    static void unpack (const ImageView& img, const std::size_t y, const std::size_t x0, const std::size_t count, T* rgb, T* alpha) noexcept
+    {
+        constexpr T norm10 = T(1) / T(1023);
+        constexpr T norm2  = T(1) / T(3);
+        const uint32_t* p = img.row<uint32_t>(0, y) + x0;
+        for (std::size_t i = 0; i < count; i++, rgb += 3)
+        {
+            const uint32_t w = p[i];
+            rgb[0] = static_cast<T>( w        & 0x3FFu) * norm10;
+            rgb[1] = static_cast<T>((w >> 10) & 0x3FFu) * norm10;
+            rgb[2] = static_cast<T>((w >> 20) & 0x3FFu) * norm10;
+            if (true == img.hasAlpha)
+                alpha[i] = static_cast<T>(w >> 30) * norm2;
+        }
+        return;
+    }
+
+    static void pack (const ImageView& img, const std::size_t y, const std::size_t x0, const std::size_t count, const T* rgb, const T* alpha) noexcept
+    {
+        uint32_t* p = img.row<uint32_t>(0, y) + x0;
+        for (std::size_t i = 0; i < count; i++, rgb += 3)
+        {
+            const uint32_t r = static_cast<uint32_t>(clip(rgb[0], T(0), T(1)) * T(1023) + T(0.5));
+            const uint32_t g = static_cast<uint32_t>(clip(rgb[1], T(0), T(1)) * T(1023) + T(0.5));
+            const uint32_t b = static_cast<uint32_t>(clip(rgb[2], T(0), T(1)) * T(1023) + T(0.5));
+            const uint32_t a = (true == img.hasAlpha && nullptr != alpha) ? static_cast<uint32_t>(clip(alpha[i], T(0), T(1)) * T(3) + T(0.5)) : 3u;
+            p[i] = r | (g << 10) | (b << 20) | (a << 30);
+        }
+        return;
+    }
+};
+
+
+// --- Number of quantization steps of integer format (0 for float formats) ---
+inline uint32_t pixel_format_levels (const PixelFormat format) noexcept
+{
+    switch (format)
+    {
+        case PixelFormat::U8:        return 255u;
+        case PixelFormat::U10Packed: return 1023u;
+        case PixelFormat::U12:       return 4095u;
+        case PixelFormat::U16:       return 65535u;
+        default:                     break;
+    }
+    return 0u;
+}
+
+
+// --- Add dither offset in range (-0.5 ... 0.5) LSB before quantization ---
+// Threshold taken from the map by pixel coordinates, so result doesn't depend on threads number or tiling.
+template <typename T>
+inline void dither_tile (T* rgb, const std::size_t count, const std::size_t x0, const std::size_t y,
+                         const float* map, const std::size_t mapSize, const T lsb) noexcept
+{
+    const float* mapRow = map + (y % mapSize) * mapSize;
+    for (std::size_t i = 0; i < count; i++, rgb += 3)
+    {
+        const T offset = (static_cast<T>(mapRow[(x0 + i) % mapSize]) - T(0.5)) * lsb;
+        rgb[0] += offset;
+        rgb[1] += offset;
+        rgb[2] += offset;
+    }
+    return;
+}
+
+
+// --- Process rows [yBegin ... yEnd): unpack, interpolate, dither and pack tile by tile ---
+// Statistics (if requested) collected from interpolated tile before dithering and quantization.
+template <PixelFormat In, PixelFormat Out, typename T>
+void image_interpolation_rows (const LatticeView<T>& lut, const ImageView& src, const ImageView& dst, const std::size_t yBegin, const std::size_t yEnd,
+                               const DitherMode dither, FrameStatistics<T>* stats) noexcept
+{
+    T rgb[imageTilePixels * 3u];
+    T alpha[imageTilePixels];
+    const T* alphaOut = (true == src.hasAlpha ? alpha : nullptr);
+
+    const uint32_t levels = pixel_format_levels (Out);
+    const float* map = nullptr;
+    std::size_t mapSize = 0u;
+    if (0u != levels && DitherMode::Bayer == dither)
+    {
+        map = bayer_map().data();
+        mapSize = bayerMapSize;
+    }
+    else if (0u != levels && DitherMode::BlueNoise == dither)
+    {
+        map = blue_noise_map().data();
+        mapSize = blueNoiseMapSize;
+    }
+    const T lsb = (0u != levels ? T(1) / static_cast<T>(levels) : T(0));
+
+    for (std::size_t y = yBegin; y < yEnd; y++)
+    {
+        for (std::size_t x = 0; x < src.width; x += imageTilePixels)
+        {
+            const std::size_t count = std::min(imageTilePixels, src.width - x);
+            RowCodec<In, T>::unpack (src, y, x, count, rgb, alpha);
+            if (nullptr != stats)
+            {
+                StatisticsAccumulator<T> accumulator (lut, *stats, src.width);
+                TetraCell<T> cell;
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    T* p = rgb + i * 3u;
+                    tetrahedral_cell (p[0], p[1], p[2], lut.lutSize, cell);
+                    tetrahedral_eval (lut.data, cell, p);
+                    accumulator.add (p, x + i);
+                }
+            }
+            else
+                tetrahedral_interpolation (lut, rgb, rgb, count);
+            if (nullptr != map)
+                dither_tile (rgb, count, x, y, map, mapSize, lsb);
+            RowCodec<Out, T>::pack (dst, y, x, count, rgb, alphaOut);
+        }
+    }
+    return;
+}
+
+
+template <PixelFormat In, typename T>
+void image_interpolation_dispatch_out (const LatticeView<T>& lut, const ImageView& src, const ImageView& dst, const std::size_t yBegin, const std::size_t yEnd,
+                                       const DitherMode dither, FrameStatistics<T>* stats) noexcept
+{
+    switch (dst.format)
+    {
+        case PixelFormat::U8:        image_interpolation_rows<In, PixelFormat::U8,        T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::U10Packed: image_interpolation_rows<In, PixelFormat::U10Packed, T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::U12:       image_interpolation_rows<In, PixelFormat::U12,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::U16:       image_interpolation_rows<In, PixelFormat::U16,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::F16:       image_interpolation_rows<In, PixelFormat::F16,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::F32:       image_interpolation_rows<In, PixelFormat::F32,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+    }
+    return;
+}
+
+
+template <typename T>
+void image_interpolation_dispatch (const LatticeView<T>& lut, const ImageView& src, const ImageView& dst, const std::size_t yBegin, const std::size_t yEnd,
+                                   const DitherMode dither, FrameStatistics<T>* stats) noexcept
+{
+    switch (src.format)
+    {
+        case PixelFormat::U8:        image_interpolation_dispatch_out<PixelFormat::U8,        T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::U10Packed: image_interpolation_dispatch_out<PixelFormat::U10Packed, T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::U12:       image_interpolation_dispatch_out<PixelFormat::U12,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::U16:       image_interpolation_dispatch_out<PixelFormat::U16,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::F16:       image_interpolation_dispatch_out<PixelFormat::F16,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+        case PixelFormat::F32:       image_interpolation_dispatch_out<PixelFormat::F32,       T> (lut, src, dst, yBegin, yEnd, dither, stats); break;
+    }
+    return;
+}
+
+
+// --- Apply 3D LUT to image: any source format/layout to any destination format/layout ---
+// Alpha copied from source to destination (converted to destination format), or set to opaque if source
+// has no alpha. src and dst may describe the same buffer if format and layout are equal.
+// Integer output optionally dithered in the same pass (ignored for float output).
+// Optional 'stats' collected in the same pass (see statistics_interpolation()): every worker accumulates into own
+// copy, copies merged at the end of the frame; configuration kept, accumulated values reset.
+template <typename T>
+LutErrorCode::LutState image_interpolation (const LatticeView<T>& lut, const ImageView& src, const ImageView& dst, const DitherMode dither,
+                                            const uint32_t threads = 0u, FrameStatistics<T>* stats = nullptr)
+{
+    if (!lut.valid())
+        return LutErrorCode::LutState::NotInitialized;
+
+    LutErrorCode::LutState err = validate_image_view (src);
+    if (LutErrorCode::LutState::OK == err)
+        err = validate_image_view (dst);
+    if (LutErrorCode::LutState::OK != err)
+        return err;
+    if (src.width != dst.width || src.height != dst.height)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    // build threshold maps before workers started
+    if (DitherMode::Bayer == dither)
+        (void)bayer_map();
+    else if (DitherMode::BlueNoise == dither)
+        (void)blue_noise_map();
+
+    const std::size_t rowGrain = std::max(std::size_t(1u), std::size_t(8192u) / src.width);
+    if (nullptr == stats)
+    {
+        LutParallel::parallel_for (0u, src.height, rowGrain,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            { image_interpolation_dispatch (lut, src, dst, begin, end, dither, stats); },
+            threads);
+        return LutErrorCode::LutState::OK;
+    }
+
+    stats->reset();
+    const uint32_t workers = (0u != threads ? threads : LutParallel::threads_number());
+    std::vector<FrameStatistics<T>> partial (workers, *stats);
+    LutParallel::parallel_for (0u, src.height, rowGrain,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t threadIdx)
+        { image_interpolation_dispatch (lut, src, dst, begin, end, dither, &partial[threadIdx]); },
+        workers);
+
+    for (const auto& p : partial)
+        stats->merge (p);
+
+    return LutErrorCode::LutState::OK;
+}
+
+
+template <typename T>
+LutErrorCode::LutState image_interpolation (const LatticeView<T>& lut, const ImageView& src, const ImageView& dst, const uint32_t threads = 0u)
+{
+    return image_interpolation (lut, src, dst, DitherMode::None, threads);
+}
+
+
+template <typename LutObject, typename T = typename std::decay<decltype(std::declval<LutObject&>().get_data()[0])>::type>
+auto image_interpolation (LutObject& lut, const ImageView& src, const ImageView& dst, const DitherMode dither, const uint32_t threads = 0u,
+                          FrameStatistics<T>* stats = nullptr)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return image_interpolation (make_lattice_view (lut), src, dst, dither, threads, stats);
+}
+
+
+template <typename LutObject>
+auto image_interpolation (LutObject& lut, const ImageView& src, const ImageView& dst, const uint32_t threads = 0u)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return image_interpolation (make_lattice_view (lut), src, dst, threads);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_IMAGE_INTERPOLATOR__
@@ -35,7 +35,7 @@ inline LutElement::lutTableRaw<T> interpolate_1d_segment_vec
 template <typename T>
 inline LutElement::lutTableRaw<T> getTriplet(const LutElement::lutTableRaw<T>& lutData, int r, int g, int b, int lutSize)
 {
-    const int base = LutAlgorithm::getTripletIdx(r, g, b, lutSize);
+    const std::size_t base = LutAlgorithm::getTripletIdx(static_cast<std::size_t>(r), static_cast<std::size_t>(g), static_cast<std::size_t>(b), static_cast<std::size_t>(lutSize));
     return { lutData[base + 0], lutData[base + 1], lutData[base + 2] };
 }
 
@@ -0,0 +1,224 @@
+#ifndef __LUT_MASKED_INTERPOLATOR__
+#define __LUT_MASKED_INTERPOLATOR__
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// number of mask values tested together: lane of zero or full mask values processed without per pixel checks
+constexpr std::size_t maskLanePixels = 8u;
+
+
+// --- Rectangular region of interest (pixels) ---
+struct RoiRect
+{
+    std::size_t x = 0u;
+    std::size_t y = 0u;
+    std::size_t width  = 0u;
+    std::size_t height = 0u;
+};
+
+
+// --- 8 or 16 bit matte: 0 - pixel unchanged, max - LUT output, values between - linear blend ---
+struct MaskView
+{
+    const void* data = nullptr;   // nullptr - no mask
+    std::size_t rowStride = 0u;   // bytes between rows; 0 - width * bytes per value
+    bool is16bit = false;
+};
+
+
+// --- Merge ROI's covering row 'y' into sorted non-overlapping intervals [begin, end) ---
+inline void roi_row_intervals (const std::vector<RoiRect>& rois, const std::size_t y, const std::size_t width,
+                               std::vector<std::pair<std::size_t, std::size_t>>& intervals)
+{
+    intervals.clear();
+    if (true == rois.empty())
+    {
+        intervals.emplace_back (0u, width);
+        return;
+    }
+
+    for (const auto& roi : rois)
+    {
+        if (y >= roi.y && y < roi.y + roi.height && roi.x < width && 0u != roi.width)
+            intervals.emplace_back (roi.x, std::min(width, roi.x + roi.width));
+    }
+    std::sort (intervals.begin(), intervals.end());
+
+    std::size_t merged = 0u;
+    for (std::size_t i = 1u; i < intervals.size(); i++)
+    {
+        if (intervals[i].first <= intervals[merged].second)
+            intervals[merged].second = std::max(intervals[merged].second, intervals[i].second);
+        else
+            intervals[++merged] = intervals[i];
+    }
+    if (false == intervals.empty())
+        intervals.resize (merged + 1u);
+    return;
+}
+
+
+// --- Lane of mask values: all zero / all full / mixed ---
+template <typename M>
+inline int mask_lane_state (const M* mask, const std::size_t count) noexcept
+{
+    constexpr M full = static_cast<M>(~M(0));
+    if (maskLanePixels == count)
+    {
+        // test whole lane as 64 bit words
+        uint64_t w[maskLanePixels * sizeof(M) / sizeof(uint64_t)];
+        std::memcpy (w, mask, sizeof(w));
+        uint64_t orAll = 0u, andAll = ~uint64_t(0);
+        for (const uint64_t v : w)
+        {
+            orAll  |= v;
+            andAll &= v;
+        }
+        return (0u == orAll ? 0 : (~uint64_t(0) == andAll ? 1 : 2));
+    }
+
+    bool zero = true, one = true;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        zero = zero && (M(0) == mask[i]);
+        one  = one  && (full == mask[i]);
+    }
+    return (true == zero ? 0 : (true == one ? 1 : 2));
+}
+
+
+// --- Interpolate interval of the row with mask ---
+template <typename T, typename M>
+void masked_row_interval (const LatticeView<T>& lut, const T* src, T* dst, const M* mask, const std::size_t count) noexcept
+{
+    constexpr T norm = T(1) / static_cast<T>(static_cast<M>(~M(0)));
+
+    for (std::size_t x = 0; x < count; x += maskLanePixels)
+    {
+        const std::size_t lane = std::min(maskLanePixels, count - x);
+        const T* pSrc = src + x * 3u;
+        T* pDst = dst + x * 3u;
+
+        switch (mask_lane_state (mask + x, lane))
+        {
+            case 0: // outside of matte
+                if (pSrc != pDst)
+                    std::copy (pSrc, pSrc + lane * 3u, pDst);
+            break;
+
+            case 1: // inside of matte
+                tetrahedral_interpolation (lut, pSrc, pDst, lane);
+            break;
+
+            default: // matte edge
+                for (std::size_t i = 0; i < lane; i++, pSrc += 3, pDst += 3)
+                {
+                    const M m = mask[x + i];
+                    if (M(0) == m)
+                    {
+                        pDst[0] = pSrc[0]; pDst[1] = pSrc[1]; pDst[2] = pSrc[2];
+                        continue;
+                    }
+                    T out[3];
+                    tetrahedral_interpolation (lut, pSrc, out);
+                    const T w = static_cast<T>(m) * norm;
+                    pDst[0] = pSrc[0] + (out[0] - pSrc[0]) * w;
+                    pDst[1] = pSrc[1] + (out[1] - pSrc[1]) * w;
+                    pDst[2] = pSrc[2] + (out[2] - pSrc[2]) * w;
+                }
+            break;
+        }
+    }
+    return;
+}
+
+
+// --- Apply 3D LUT inside of ROI's and/or matte only ---
+// src/dst - interleaved RGB frames width x height (may be the same buffer). Empty 'rois' - complete frame.
+// Pixels outside of ROI's or with zero mask copied from src (nothing done for in-place processing), so
+// work scales with processed area.
+template <typename T>
+LutErrorCode::LutState masked_interpolation
+(
+    const LatticeView<T>& lut,
+    const T* src,
+    T* dst,
+    const std::size_t width,
+    const std::size_t height,
+    const std::vector<RoiRect>& rois,
+    const MaskView& mask = MaskView{},
+    const uint32_t threads = 0u
+)
+{
+    if (!lut.valid() || nullptr == src || nullptr == dst)
+        return LutErrorCode::LutState::NotInitialized;
+    if (0u == width || 0u == height)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    const std::size_t maskBytes  = (true == mask.is16bit ? sizeof(uint16_t) : sizeof(uint8_t));
+    const std::size_t maskStride = (0u != mask.rowStride ? mask.rowStride : width * maskBytes);
+    if (nullptr != mask.data && maskStride < width * maskBytes)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    LutParallel::parallel_for (0u, height, 1u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        {
+            std::vector<std::pair<std::size_t, std::size_t>> intervals;
+            for (std::size_t y = begin; y < end; y++)
+            {
+                const T* rowSrc = src + y * width * 3u;
+                T* rowDst = dst + y * width * 3u;
+                const uint8_t* rowMask = (nullptr != mask.data ? static_cast<const uint8_t*>(mask.data) + y * maskStride : nullptr);
+
+                roi_row_intervals (rois, y, width, intervals);
+                std::size_t x = 0u;
+                for (const auto& interval : intervals)
+                {
+                    // pixels outside of ROI
+                    if (rowSrc != rowDst && interval.first > x)
+                        std::copy (rowSrc + x * 3u, rowSrc + interval.first * 3u, rowDst + x * 3u);
+
+                    const std::size_t count = interval.second - interval.first;
+                    const T* pSrc = rowSrc + interval.first * 3u;
+                    T* pDst = rowDst + interval.first * 3u;
+                    if (nullptr == rowMask)
+                        tetrahedral_interpolation (lut, pSrc, pDst, count);
+                    else if (true == mask.is16bit)
+                        masked_row_interval (lut, pSrc, pDst, reinterpret_cast<const uint16_t*>(rowMask) + interval.first, count);
+                    else
+                        masked_row_interval (lut, pSrc, pDst, rowMask + interval.first, count);
+                    x = interval.second;
+                }
+                if (rowSrc != rowDst && width > x)
+                    std::copy (rowSrc + x * 3u, rowSrc + width * 3u, rowDst + x * 3u);
+            }
+        },
+        threads);
+
+    return LutErrorCode::LutState::OK;
+}
+
+
+template <typename LutObject, typename T>
+auto masked_interpolation (LutObject& lut, const T* src, T* dst, const std::size_t width, const std::size_t height,
+                           const std::vector<RoiRect>& rois, const MaskView& mask = MaskView{}, const uint32_t threads = 0u)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return masked_interpolation (make_lattice_view (lut), src, dst, width, height, rois, mask, threads);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_MASKED_INTERPOLATOR__
@@ -0,0 +1,148 @@
+#ifndef __LUT_MULTI_INTERPOLATOR__
+#define __LUT_MULTI_INTERPOLATOR__
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutElement.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// number of pixels with precomputed cells evaluated against all LUT bodies in turn
+constexpr std::size_t multiTilePixels = 64u;
+
+
+// --- Check that all LUTs have the same lattice size: one cell per pixel valid for every LUT body ---
+template <typename T>
+LutErrorCode::LutState multi_lut_validate (const std::vector<LatticeView<T>>& luts) noexcept
+{
+    if (true == luts.empty())
+        return LutErrorCode::LutState::NotInitialized;
+    for (const auto& lut : luts)
+    {
+        if (!lut.valid())
+            return LutErrorCode::LutState::LutSizeInvalid;
+        if (lut.lutSize != luts[0].lutSize)
+            return LutErrorCode::LutState::IncorrectDimension;
+    }
+    return LutErrorCode::LutState::OK;
+}
+
+
+// --- Interpolate 'pixels' points against N LUT bodies: dst[k] receives output of luts[k] ---
+// Lattice offsets, tetrahedron case and weights computed once per pixel for all LUTs.
+template <typename T>
+void multi_lut_eval
+(
+    const std::vector<LatticeView<T>>& luts,
+    const T* src,
+    T* const* dst,
+    const std::size_t pixels
+) noexcept
+{
+    const std::size_t nLuts = luts.size();
+    const LutElement::lutSize lutSize = luts[0].lutSize;
+    std::array<TetraCell<T>, multiTilePixels> cells;
+
+    for (std::size_t tile = 0; tile < pixels; tile += multiTilePixels)
+    {
+        const std::size_t tilePixels = std::min(multiTilePixels, pixels - tile);
+        const T* pSrc = src + tile * 3u;
+        for (std::size_t i = 0; i < tilePixels; i++, pSrc += 3)
+            tetrahedral_cell (pSrc[0], pSrc[1], pSrc[2], lutSize, cells[i]);
+
+        for (std::size_t k = 0; k < nLuts; k++)
+        {
+            const LatticeView<T>& lut = luts[k];
+            T* pDst = dst[k] + tile * 3u;
+            for (std::size_t i = 0; i < tilePixels; i++, pDst += 3)
+            {
+                tetrahedral_eval (lut.data, cells[i], pDst);
+                domain_clamp (lut, pDst);
+            }
+        }
+    }
+    return;
+}
+
+
+// --- Apply N LUTs of the same size to one image: dst[k] - interleaved RGB output buffer for luts[k] ---
+template <typename T>
+LutErrorCode::LutState multi_lut_interpolation
+(
+    const std::vector<LatticeView<T>>& luts,
+    const T* src,
+    const std::vector<T*>& dst,
+    const std::size_t pixels,
+    const uint32_t threads = 0u
+)
+{
+    const LutErrorCode::LutState err = multi_lut_validate (luts);
+    if (LutErrorCode::LutState::OK != err)
+        return err;
+    if (dst.size() != luts.size())
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    LutParallel::parallel_for (0u, pixels, multiTilePixels * 16u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        {
+            std::vector<T*> chunkDst (dst.size());
+            for (std::size_t k = 0; k < dst.size(); k++)
+                chunkDst[k] = dst[k] + begin * 3u;
+            multi_lut_eval (luts, src + begin * 3u, chunkDst.data(), end - begin);
+        },
+        threads);
+
+    return LutErrorCode::LutState::OK;
+}
+
+
+// --- Apply N LUTs of the same size to one image and place results into contact sheet ---
+// Image 'width' x 'height' rendered by luts[k] placed into cell (k % columns, k / columns) of the sheet.
+// Sheet buffer: interleaved RGB, (columns * width) x (rows * height) pixels, rows = ceil(N / columns).
+template <typename T>
+LutErrorCode::LutState multi_lut_contact_sheet
+(
+    const std::vector<LatticeView<T>>& luts,
+    const T* src,
+    const std::size_t width,
+    const std::size_t height,
+    const std::size_t columns,
+    T* sheet,
+    const uint32_t threads = 0u
+)
+{
+    const LutErrorCode::LutState err = multi_lut_validate (luts);
+    if (LutErrorCode::LutState::OK != err)
+        return err;
+    if (0u == width || 0u == height || 0u == columns)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    const std::size_t sheetPitch = columns * width * 3u;
+
+    LutParallel::parallel_for (0u, height, 1u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        {
+            std::vector<T*> rowDst (luts.size());
+            for (std::size_t y = begin; y < end; y++)
+            {
+                for (std::size_t k = 0; k < luts.size(); k++)
+                    rowDst[k] = sheet + ((k / columns) * height + y) * sheetPitch + (k % columns) * width * 3u;
+                multi_lut_eval (luts, src + y * width * 3u, rowDst.data(), width);
+            }
+        },
+        threads);
+
+    return LutErrorCode::LutState::OK;
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_MULTI_INTERPOLATOR__
@@ -0,0 +1,119 @@
+#ifndef __LUT_NEUTRAL_AXIS_INTERPOLATOR__
+#define __LUT_NEUTRAL_AXIS_INTERPOLATOR__
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutElement.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// number of pixels checked together for achromatic content
+constexpr std::size_t neutralTilePixels = 64u;
+
+
+// --- Copy diagonal of the lattice (nodes with r == g == b) into dense 1D curve of lutSize triplets ---
+template <typename T>
+void extract_neutral_axis (const LatticeView<T>& lut, LutElement::lutTable3D<T>& axis)
+{
+    const std::size_t diagStride = (lut.lutSize * lut.lutSize + lut.lutSize + 1u) * 3u;
+    axis.resize(lut.lutSize * 3u);
+    for (std::size_t i = 0; i < lut.lutSize; i++)
+    {
+        axis[i * 3 + 0] = lut.data[i * diagStride + 0];
+        axis[i * 3 + 1] = lut.data[i * diagStride + 1];
+        axis[i * 3 + 2] = lut.data[i * diagStride + 2];
+    }
+    return;
+}
+
+
+// --- Interpolate achromatic point (r == g == b == v) on neutral axis ---
+// For neutral input tetrahedral cell degenerates to the main diagonal of the cube with weights
+// (1 - t, 0, 0, t), so linear lookup in the diagonal curve gives the same result as 3D evaluation.
+template <typename T>
+inline void neutral_axis_eval (const T* axis, const LutElement::lutSize& lutSize, const T v, T* out) noexcept
+{
+    T t;
+    const int x0 = lattice_coordinate (v, static_cast<int>(lutSize) - 1, t);
+    const T w0 = T(1) - t;
+
+    const T* p0 = axis + static_cast<std::size_t>(x0) * 3u;
+    const T* p3 = p0 + 3;
+    out[0] = p0[0] * w0 + p3[0] * t;
+    out[1] = p0[1] * w0 + p3[1] * t;
+    out[2] = p0[2] * w0 + p3[2] * t;
+    return;
+}
+
+
+// --- Interpolate buffer of interleaved RGB pixels with neutral-axis fast path ---
+// Tiles of pure achromatic pixels processed by 1D lookup only; mixed tiles select path per pixel.
+// 'axis' - diagonal curve of 'lut' (see extract_neutral_axis() or CCubeLut3D::getNeutralAxis()).
+template <typename T>
+void neutral_axis_interpolation (const LatticeView<T>& lut, const T* axis, const T* src, T* dst, const std::size_t pixels) noexcept
+{
+    for (std::size_t tile = 0; tile < pixels; tile += neutralTilePixels)
+    {
+        const std::size_t tilePixels = std::min(neutralTilePixels, pixels - tile);
+        const T* pSrc = src + tile * 3u;
+        T* pDst = dst + tile * 3u;
+
+        bool achromatic = true;
+        for (std::size_t i = 0; i < tilePixels * 3u; i += 3)
+            achromatic = achromatic && (pSrc[i] == pSrc[i + 1]) && (pSrc[i] == pSrc[i + 2]);
+
+        if (true == achromatic)
+        {
+            for (std::size_t i = 0; i < tilePixels; i++, pSrc += 3, pDst += 3)
+            {
+                neutral_axis_eval (axis, lut.lutSize, pSrc[0], pDst);
+                domain_clamp (lut, pDst);
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < tilePixels; i++, pSrc += 3, pDst += 3)
+            {
+                if (pSrc[0] == pSrc[1] && pSrc[0] == pSrc[2])
+                {
+                    neutral_axis_eval (axis, lut.lutSize, pSrc[0], pDst);
+                    domain_clamp (lut, pDst);
+                }
+                else
+                    tetrahedral_interpolation (lut, pSrc, pDst);
+            }
+        }
+    }
+    return;
+}
+
+
+// --- Multi-threaded version for LUT object (CCubeLut3D<T>): src and dst may point to the same buffer ---
+template <typename LutObject, typename T>
+LutErrorCode::LutState neutral_axis_interpolation (LutObject& lutObj, const T* src, T* dst, const std::size_t pixels, const uint32_t threads = 0u)
+{
+    // cached diagonal taken first: view only reads LUT body
+    const LutElement::lutTable3D<T>& axis = lutObj.getNeutralAxis();
+    const LatticeView<T> lut = make_lattice_view (lutObj);
+    if (!lut.valid() || axis.size() != lut.lutSize * 3u)
+        return LutErrorCode::LutState::NotInitialized;
+
+    LutParallel::parallel_for (0u, pixels, neutralTilePixels * 128u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        { neutral_axis_interpolation (lut, axis.data(), src + begin * 3u, dst + begin * 3u, end - begin); },
+        threads);
+
+    return LutErrorCode::LutState::OK;
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_NEUTRAL_AXIS_INTERPOLATOR__
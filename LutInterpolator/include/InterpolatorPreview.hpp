@@ -0,0 +1,215 @@
+#ifndef __LUT_PREVIEW_INTERPOLATOR__
+#define __LUT_PREVIEW_INTERPOLATOR__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// lattice size of reduced LUT used by preview tiers: 17^3 x 3 floats ~ 58 KB
+constexpr LutElement::lutSize previewLutSize = 17u;
+
+enum class PreviewQuality : uint32_t
+{
+    Final = 0,      // full LUT, tetrahedral interpolation
+    Trilinear,      // reduced LUT, trilinear interpolation
+    Nearest         // reduced LUT, nearest lattice node
+};
+
+
+// --- Trilinear interpolation of interleaved RGB pixels: src and dst may point to the same buffer ---
+template <typename T>
+inline void trilinear_interpolation (const LatticeView<T>& lut, const T* src, T* dst, const std::size_t pixels) noexcept
+{
+    const int maxIdx = static_cast<int>(lut.lutSize) - 1;
+    const std::size_t sG = 3u * lut.lutSize;
+    const std::size_t sB = sG * lut.lutSize;
+
+    for (std::size_t i = 0; i < pixels; i++, src += 3, dst += 3)
+    {
+        T tx, ty, tz;
+        const int x0 = lattice_coordinate (src[0], maxIdx, tx);
+        const int y0 = lattice_coordinate (src[1], maxIdx, ty);
+        const int z0 = lattice_coordinate (src[2], maxIdx, tz);
+        const T* p = lut.data + static_cast<std::size_t>(z0) * sB + static_cast<std::size_t>(y0) * sG + static_cast<std::size_t>(x0) * 3u;
+
+        for (std::size_t c = 0; c < 3u; c++)
+        {
+            const T c00 = p[c]           + (p[c + 3u]           - p[c])           * tx;
+            const T c10 = p[c + sG]      + (p[c + sG + 3u]      - p[c + sG])      * tx;
+            const T c01 = p[c + sB]      + (p[c + sB + 3u]      - p[c + sB])      * tx;
+            const T c11 = p[c + sB + sG] + (p[c + sB + sG + 3u] - p[c + sB + sG]) * tx;
+            const T c0  = c00 + (c10 - c00) * ty;
+            const T c1  = c01 + (c11 - c01) * ty;
+            dst[c] = c0 + (c1 - c0) * tz;
+        }
+        domain_clamp (lut, dst);
+    }
+    return;
+}
+
+
+// --- Nearest lattice node lookup: src and dst may point to the same buffer ---
+template <typename T>
+inline void nearest_interpolation (const LatticeView<T>& lut, const T* src, T* dst, const std::size_t pixels) noexcept
+{
+    const T fMax = static_cast<T>(lut.lutSize - 1u);
+    const std::size_t sG = 3u * lut.lutSize;
+    const std::size_t sB = sG * lut.lutSize;
+
+    for (std::size_t i = 0; i < pixels; i++, src += 3, dst += 3)
+    {
+        const std::size_t x = static_cast<std::size_t>(clip(src[0], T(0), T(1)) * fMax + T(0.5));
+        const std::size_t y = static_cast<std::size_t>(clip(src[1], T(0), T(1)) * fMax + T(0.5));
+        const std::size_t z = static_cast<std::size_t>(clip(src[2], T(0), T(1)) * fMax + T(0.5));
+        const T* p = lut.data + z * sB + y * sG + x * 3u;
+        dst[0] = p[0]; dst[1] = p[1]; dst[2] = p[2];
+        domain_clamp (lut, dst);
+    }
+    return;
+}
+
+
+template <typename T>
+inline void preview_quality_run (const LatticeView<T>& lut, const PreviewQuality quality, const T* src, T* dst, const std::size_t pixels) noexcept
+{
+    switch (quality)
+    {
+        case PreviewQuality::Nearest:   nearest_interpolation (lut, src, dst, pixels);     break;
+        case PreviewQuality::Trilinear: trilinear_interpolation (lut, src, dst, pixels);   break;
+        default:                        tetrahedral_interpolation (lut, src, dst, pixels); break;
+    }
+    return;
+}
+
+
+// --- Apply 3D LUT on interleaved RGB frame with selected quality tier ---
+// step > 1: LUT evaluated only on every step-th pixel of every step-th row (plus last row/column), other
+// pixels bilinearly upsampled from the evaluated grid. 'lut' is LUT used by the tier (full or reduced).
+// For step > 1 src and dst must not overlap.
+template <typename T>
+LutErrorCode::LutState preview_interpolation
+(
+    const LatticeView<T>& lut,
+    const T* src,
+    T* dst,
+    const std::size_t width,
+    const std::size_t height,
+    const PreviewQuality quality,
+    const std::size_t step = 1u,
+    const uint32_t threads = 0u
+)
+{
+    if (!lut.valid() || nullptr == src || nullptr == dst)
+        return LutErrorCode::LutState::NotInitialized;
+    if (0u == width || 0u == height || 0u == step)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    if (1u == step)
+    {
+        LutParallel::parallel_for (0u, width * height, 16384u,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            { preview_quality_run (lut, quality, src + begin * 3u, dst + begin * 3u, end - begin); },
+            threads);
+        return LutErrorCode::LutState::OK;
+    }
+
+    // sample positions: multiples of step plus last pixel
+    auto grid_positions = [step](const std::size_t size)
+    {
+        std::vector<std::size_t> pos;
+        for (std::size_t p = 0; p < size; p += step)
+            pos.push_back (p);
+        if (pos.back() != size - 1u)
+            pos.push_back (size - 1u);
+        return pos;
+    };
+    const std::vector<std::size_t> gx = grid_positions (width);
+    const std::vector<std::size_t> gy = grid_positions (height);
+    const std::size_t gw = gx.size();
+    std::vector<T> grid (gw * gy.size() * 3u);
+
+    LutParallel::parallel_for (0u, gy.size(), 1u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        {
+            std::vector<T> samples (gw * 3u);
+            for (std::size_t j = begin; j < end; j++)
+            {
+                const T* row = src + gy[j] * width * 3u;
+                for (std::size_t i = 0; i < gw; i++)
+                    std::copy (row + gx[i] * 3u, row + gx[i] * 3u + 3u, &samples[i * 3u]);
+                preview_quality_run (lut, quality, samples.data(), &grid[j * gw * 3u], gw);
+            }
+        },
+        threads);
+
+    // horizontal upsampling weights shared by all rows
+    std::vector<std::size_t> col0 (width);
+    std::vector<T> colW (width);
+    for (std::size_t x = 0; x < width; x++)
+    {
+        const std::size_t i0 = (1u == gw ? 0u : std::min(x / step, gw - 2u));
+        col0[x] = i0 * 3u;
+        colW[x] = (1u == gw ? T(0) : static_cast<T>(x - gx[i0]) / static_cast<T>(gx[i0 + 1u] - gx[i0]));
+    }
+    const std::size_t colNext = (1u == gw ? 0u : 3u);
+
+    LutParallel::parallel_for (0u, height, 8u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        {
+            std::vector<T> line (gw * 3u);
+            for (std::size_t y = begin; y < end; y++)
+            {
+                // vertical pass on grid row pair, then horizontal expansion
+                const std::size_t j0 = (1u == gy.size() ? 0u : std::min(y / step, gy.size() - 2u));
+                const std::size_t j1 = (1u == gy.size() ? j0 : j0 + 1u);
+                const T wy = (j1 != j0 ? static_cast<T>(y - gy[j0]) / static_cast<T>(gy[j1] - gy[j0]) : T(0));
+                const T* g0 = &grid[j0 * gw * 3u];
+                const T* g1 = &grid[j1 * gw * 3u];
+                for (std::size_t i = 0; i < gw * 3u; i++)
+                    line[i] = g0[i] + (g1[i] - g0[i]) * wy;
+
+                T* out = dst + y * width * 3u;
+                for (std::size_t x = 0; x < width; x++, out += 3)
+                {
+                    const T* l = &line[col0[x]];
+                    const T wx = colW[x];
+                    out[0] = l[0] + (l[colNext + 0u] - l[0]) * wx;
+                    out[1] = l[1] + (l[colNext + 1u] - l[1]) * wx;
+                    out[2] = l[2] + (l[colNext + 2u] - l[2]) * wx;
+                }
+            }
+        },
+        threads);
+
+    return LutErrorCode::LutState::OK;
+}
+
+
+// --- Tier selected per call: reduced LUT taken from (and cached by) the LUT object ---
+template <typename LutObject, typename T>
+auto preview_interpolation (LutObject& lut, const T* src, T* dst, const std::size_t width, const std::size_t height,
+                            const PreviewQuality quality, const std::size_t step = 1u, const uint32_t threads = 0u)
+    -> decltype(lut.getPreviewLut (previewLutSize), make_lattice_view (lut), LutErrorCode::LutState())
+{
+    if (PreviewQuality::Final == quality)
+        return preview_interpolation (make_lattice_view (lut), src, dst, width, height, quality, step, threads);
+
+    const auto domain = lut.getMinMaxDomain();
+    const auto& reduced = lut.getPreviewLut (previewLutSize);
+    const LutElement::lutSize reducedSize = std::min(previewLutSize, lut.getLutSize());
+    return preview_interpolation (make_lattice_view (reduced, reducedSize, domain.first, domain.second),
+                                  src, dst, width, height, quality, step, threads);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_PREVIEW_INTERPOLATOR__
@@ -0,0 +1,169 @@
+#ifndef __LUT_SCANLINE_INTERPOLATOR__
+#define __LUT_SCANLINE_INTERPOLATOR__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+
+namespace Interpolator
+{
+
+// --- Cell reuse telemetry ---
+struct ScanlineStats
+{
+    uint64_t pixels = 0u;
+    uint64_t cellHits = 0u;     // pixels evaluated from corners of the previous pixel cube
+
+    double hit_rate (void) const noexcept { return (0u != pixels ? static_cast<double>(cellHits) / static_cast<double>(pixels) : 0.0); }
+    void merge (const ScanlineStats& other) noexcept { pixels += other.pixels; cellHits += other.cellHits; }
+};
+
+
+// --- 8 corners of the lattice cube; corner index bits: 0 - red, 1 - green, 2 - blue ---
+template <typename T>
+struct CubeCorners
+{
+    T c[8][3];
+    std::size_t base = ~std::size_t(0);     // offset of lower corner, ~0 - nothing loaded
+
+    void load (const T* lutData, const std::size_t cubeBase, const std::size_t sG, const std::size_t sB) noexcept
+    {
+        const std::size_t offset[8] = { 0u, 3u, sG, sG + 3u, sB, sB + 3u, sB + sG, sB + sG + 3u };
+        for (std::size_t i = 0; i < 8u; i++)
+        {
+            const T* p = lutData + cubeBase + offset[i];
+            c[i][0] = p[0]; c[i][1] = p[1]; c[i][2] = p[2];
+        }
+        base = cubeBase;
+        return;
+    }
+};
+
+
+// --- Select tetrahedron as corner indexes; same partition and weights as tetrahedral_select() ---
+template <typename T>
+inline void tetrahedral_select_corners (const T tx, const T ty, const T tz, int (&idx)[4], T (&w)[4]) noexcept
+{
+    idx[0] = 0; idx[3] = 7;
+    if (tx >= ty)
+    {
+        if (ty >= tz)      { idx[1] = 1; idx[2] = 3; w[0] = T(1) - tx; w[1] = tx - ty; w[2] = ty - tz; w[3] = tz; } // R > G > B
+        else if (tx >= tz) { idx[1] = 1; idx[2] = 5; w[0] = T(1) - tx; w[1] = tx - tz; w[2] = tz - ty; w[3] = ty; } // R > B > G
+        else               { idx[1] = 4; idx[2] = 5; w[0] = T(1) - tz; w[1] = tz - tx; w[2] = tx - ty; w[3] = ty; } // B > R > G
+    }
+    else
+    {
+        if (tz >= ty)      { idx[1] = 4; idx[2] = 6; w[0] = T(1) - tz; w[1] = tz - ty; w[2] = ty - tx; w[3] = tx; } // B > G > R
+        else if (tz >= tx) { idx[1] = 2; idx[2] = 6; w[0] = T(1) - ty; w[1] = ty - tz; w[2] = tz - tx; w[3] = tx; } // G > B > R
+        else               { idx[1] = 2; idx[2] = 3; w[0] = T(1) - ty; w[1] = ty - tx; w[2] = tx - tz; w[3] = tz; } // G > R > B
+    }
+    return;
+}
+
+
+// --- Interpolate run of pixels keeping corners of the last cube; corners refetched only when cube changes ---
+// src and dst may point to the same buffer. 'corners' may be carried between consecutive runs.
+template <typename T>
+inline void scanline_interpolation
+(
+    const LatticeView<T>& lut,
+    CubeCorners<T>& corners,
+    const T* src,
+    T* dst,
+    const std::size_t pixels,
+    ScanlineStats& stats
+) noexcept
+{
+    const int maxIdx = static_cast<int>(lut.lutSize) - 1;
+    const std::size_t sG = 3u * lut.lutSize;
+    const std::size_t sB = sG * lut.lutSize;
+
+    uint64_t hits = 0u;
+    for (std::size_t i = 0; i < pixels; i++, src += 3, dst += 3)
+    {
+        T tx, ty, tz;
+        const int x0 = lattice_coordinate (src[0], maxIdx, tx);
+        const int y0 = lattice_coordinate (src[1], maxIdx, ty);
+        const int z0 = lattice_coordinate (src[2], maxIdx, tz);
+        const std::size_t base = static_cast<std::size_t>(z0) * sB + static_cast<std::size_t>(y0) * sG + static_cast<std::size_t>(x0) * 3u;
+
+        if (base == corners.base)
+            hits++;
+        else
+            corners.load (lut.data, base, sG, sB);
+
+        int idx[4]; T w[4];
+        tetrahedral_select_corners (tx, ty, tz, idx, w);
+        const T* p0 = corners.c[idx[0]];
+        const T* p1 = corners.c[idx[1]];
+        const T* p2 = corners.c[idx[2]];
+        const T* p3 = corners.c[idx[3]];
+        dst[0] = p0[0] * w[0] + p1[0] * w[1] + p2[0] * w[2] + p3[0] * w[3];
+        dst[1] = p0[1] * w[0] + p1[1] * w[1] + p2[1] * w[2] + p3[1] * w[3];
+        dst[2] = p0[2] * w[0] + p1[2] * w[1] + p2[2] * w[2] + p3[2] * w[3];
+        domain_clamp (lut, dst);
+    }
+    stats.pixels += pixels;
+    stats.cellHits += hits;
+    return;
+}
+
+
+// --- Apply 3D LUT to interleaved RGB frame along scanlines ---
+// Profitable for smooth footage and large LUTs, where neighbouring pixels usually share the lattice cube.
+// 'stats' (optional) receives cube reuse rate.
+template <typename T>
+LutErrorCode::LutState scanline_interpolation
+(
+    const LatticeView<T>& lut,
+    const T* src,
+    T* dst,
+    const std::size_t width,
+    const std::size_t height,
+    const uint32_t threads = 0u,
+    ScanlineStats* stats = nullptr
+)
+{
+    if (!lut.valid() || nullptr == src || nullptr == dst)
+        return LutErrorCode::LutState::NotInitialized;
+    if (0u == width || 0u == height)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    const uint32_t workers = (0u != threads ? threads : LutParallel::threads_number());
+    std::vector<ScanlineStats> partial (workers);
+
+    const std::size_t rowGrain = std::max(std::size_t(1u), std::size_t(8192u) / width);
+    LutParallel::parallel_for (0u, height, rowGrain,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t threadIdx)
+        {
+            CubeCorners<T> corners;
+            for (std::size_t y = begin; y < end; y++)
+                scanline_interpolation (lut, corners, src + y * width * 3u, dst + y * width * 3u, width, partial[threadIdx]);
+        },
+        workers);
+
+    if (nullptr != stats)
+    {
+        *stats = ScanlineStats{};
+        for (const auto& p : partial)
+            stats->merge (p);
+    }
+    return LutErrorCode::LutState::OK;
+}
+
+
+template <typename LutObject, typename T>
+auto scanline_interpolation (LutObject& lut, const T* src, T* dst, const std::size_t width, const std::size_t height,
+                             const uint32_t threads = 0u, ScanlineStats* stats = nullptr)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return scanline_interpolation (make_lattice_view (lut), src, dst, width, height, threads, stats);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_SCANLINE_INTERPOLATOR__
@@ -0,0 +1,206 @@
+#ifndef __LUT_STATISTICS_INTERPOLATOR__
+#define __LUT_STATISTICS_INTERPOLATOR__
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// --- Scopes of the graded frame collected while LUT applied ---
+// histogram   - per channel, 'histogramBins' bins over LUT output domain
+// clipped     - pixels with at least one channel outside of LUT domain before clamping
+// waveform    - luma (Rec.709 weights) distribution per image column group: waveformColumns x waveformBins,
+//               luma range [0...1]; disabled if waveformColumns == 0
+template <typename T>
+struct FrameStatistics
+{
+    std::size_t histogramBins   = 256u;
+    std::size_t waveformColumns = 0u;
+    std::size_t waveformBins    = 256u;
+
+    std::array<std::vector<uint64_t>, 3> histogram;
+    std::vector<uint64_t> waveform;
+    std::array<T, 3> minValue {{ std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max() }};
+    std::array<T, 3> maxValue {{ std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest() }};
+    uint64_t clippedPixels = 0u;
+    uint64_t pixels = 0u;
+
+    FrameStatistics (void) = default;
+    FrameStatistics (const std::size_t histBins, const std::size_t wfColumns = 0u, const std::size_t wfBins = 256u)
+    {
+        reset (histBins, wfColumns, wfBins);
+    }
+
+    void reset (const std::size_t histBins, const std::size_t wfColumns, const std::size_t wfBins)
+    {
+        histogramBins   = std::max(std::size_t(1u), histBins);
+        waveformColumns = wfColumns;
+        waveformBins    = std::max(std::size_t(1u), wfBins);
+        for (auto& h : histogram)
+            h.assign (histogramBins, 0u);
+        waveform.assign (waveformColumns * waveformBins, 0u);
+        minValue.fill (std::numeric_limits<T>::max());
+        maxValue.fill (std::numeric_limits<T>::lowest());
+        clippedPixels = pixels = 0u;
+        return;
+    }
+
+    void reset (void) { reset (histogramBins, waveformColumns, waveformBins); }
+
+    void merge (const FrameStatistics& other)
+    {
+        for (std::size_t c = 0; c < 3; c++)
+        {
+            for (std::size_t i = 0; i < histogram[c].size() && i < other.histogram[c].size(); i++)
+                histogram[c][i] += other.histogram[c][i];
+            minValue[c] = std::min(minValue[c], other.minValue[c]);
+            maxValue[c] = std::max(maxValue[c], other.maxValue[c]);
+        }
+        for (std::size_t i = 0; i < waveform.size() && i < other.waveform.size(); i++)
+            waveform[i] += other.waveform[i];
+        clippedPixels += other.clippedPixels;
+        pixels += other.pixels;
+        return;
+    }
+};
+
+
+// --- Accumulation of statistics pixel by pixel into statistics of one worker ---
+// 'width' - frame width for waveform column mapping.
+template <typename T>
+class StatisticsAccumulator
+{
+public:
+    StatisticsAccumulator (const LatticeView<T>& lut, FrameStatistics<T>& stats, const std::size_t width) noexcept
+        : m_lut (lut), m_stats (stats), m_width (width),
+          m_maxBin (static_cast<int>(stats.histogramBins) - 1), m_maxWfBin (static_cast<int>(stats.waveformBins) - 1)
+    {
+        for (std::size_t c = 0; c < 3; c++)
+            m_binScale[c] = static_cast<T>(stats.histogramBins) / std::max(lut.domainMax[c] - lut.domainMin[c], std::numeric_limits<T>::min());
+    }
+
+    // interpolated (not clamped yet) pixel of column x: accumulated and clamped to LUT domain in place
+    inline void add (T* rgb, const std::size_t x) noexcept
+    {
+        bool clipped = false;
+        for (std::size_t c = 0; c < 3; c++)
+        {
+            const T v = rgb[c];
+            clipped = clipped || v < m_lut.domainMin[c] || v > m_lut.domainMax[c];
+            m_stats.minValue[c] = std::min(m_stats.minValue[c], v);
+            m_stats.maxValue[c] = std::max(m_stats.maxValue[c], v);
+            rgb[c] = clip(v, m_lut.domainMin[c], m_lut.domainMax[c]);
+            const int bin = std::min(static_cast<int>((rgb[c] - m_lut.domainMin[c]) * m_binScale[c]), m_maxBin);
+            m_stats.histogram[c][bin]++;
+        }
+        m_stats.clippedPixels += (true == clipped ? 1u : 0u);
+
+        if (0u != m_stats.waveformColumns)
+        {
+            const T luma = T(0.2126) * rgb[0] + T(0.7152) * rgb[1] + T(0.0722) * rgb[2];
+            const int bin = std::min(static_cast<int>(clip(luma, T(0), T(1)) * static_cast<T>(m_stats.waveformBins)), m_maxWfBin);
+            const std::size_t column = x * m_stats.waveformColumns / m_width;
+            m_stats.waveform[column * m_stats.waveformBins + static_cast<std::size_t>(bin)]++;
+        }
+        m_stats.pixels++;
+        return;
+    }
+
+private:
+    const LatticeView<T>& m_lut;
+    FrameStatistics<T>& m_stats;
+    const std::size_t m_width;
+    const int m_maxBin;
+    const int m_maxWfBin;
+    std::array<T, 3> m_binScale;
+};
+
+
+// --- Interpolate rows [yBegin ... yEnd) of interleaved RGB frame and accumulate statistics ---
+template <typename T>
+void statistics_interpolation_rows
+(
+    const LatticeView<T>& lut,
+    const T* src,
+    T* dst,
+    const std::size_t width,
+    const std::size_t yBegin,
+    const std::size_t yEnd,
+    FrameStatistics<T>& stats
+) noexcept
+{
+    StatisticsAccumulator<T> accumulator (lut, stats, width);
+    TetraCell<T> cell;
+    for (std::size_t y = yBegin; y < yEnd; y++)
+    {
+        const T* pSrc = src + y * width * 3u;
+        T* pDst = dst + y * width * 3u;
+        for (std::size_t x = 0; x < width; x++, pSrc += 3, pDst += 3)
+        {
+            tetrahedral_cell (pSrc[0], pSrc[1], pSrc[2], lut.lutSize, cell);
+            tetrahedral_eval (lut.data, cell, pDst);
+            accumulator.add (pDst, x);
+        }
+    }
+    return;
+}
+
+
+// --- Apply 3D LUT to interleaved RGB frame and collect scopes in the same pass ---
+// Every worker accumulates into own copy of statistics, copies merged at the end of the frame.
+// 'stats' configuration (bins, waveform columns) kept, accumulated values reset.
+// minValue/maxValue and 'clippedPixels' reflect LUT output before clamping to domain.
+template <typename T>
+LutErrorCode::LutState statistics_interpolation
+(
+    const LatticeView<T>& lut,
+    const T* src,
+    T* dst,
+    const std::size_t width,
+    const std::size_t height,
+    FrameStatistics<T>& stats,
+    const uint32_t threads = 0u
+)
+{
+    if (!lut.valid() || nullptr == src || nullptr == dst)
+        return LutErrorCode::LutState::NotInitialized;
+    if (0u == width || 0u == height)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    stats.reset();
+    const uint32_t workers = (0u != threads ? threads : LutParallel::threads_number());
+    std::vector<FrameStatistics<T>> partial (workers, stats);
+
+    const std::size_t rowGrain = std::max(std::size_t(1u), std::size_t(8192u) / width);
+    LutParallel::parallel_for (0u, height, rowGrain,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t threadIdx)
+        { statistics_interpolation_rows (lut, src, dst, width, begin, end, partial[threadIdx]); },
+        workers);
+
+    for (const auto& p : partial)
+        stats.merge (p);
+
+    return LutErrorCode::LutState::OK;
+}
+
+
+template <typename LutObject, typename T>
+auto statistics_interpolation (LutObject& lut, const T* src, T* dst, const std::size_t width, const std::size_t height,
+                               FrameStatistics<T>& stats, const uint32_t threads = 0u)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return statistics_interpolation (make_lattice_view (lut), src, dst, width, height, stats, threads);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_STATISTICS_INTERPOLATOR__
@@ -0,0 +1,209 @@
+#ifndef __LUT_SUB_CUBE_INTERPOLATOR__
+#define __LUT_SUB_CUBE_INTERPOLATOR__
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutElement.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+// sub-cube used if it's at least 'subCubeMinRatio' times smaller than complete lattice
+constexpr std::size_t subCubeMinRatio = 4u;
+// lattices smaller than this (in bytes) fit into L1/L2 and used directly
+constexpr std::size_t subCubeMinLatticeBytes = 64u * 1024u;
+
+
+// --- Compact copy of region of the lattice: nodes [origin ... origin + size - 1] along each axis ---
+template <typename T>
+struct SubLattice
+{
+    const T* data = nullptr;
+    LutElement::lutSize lutSize = 0u;                   // size of complete lattice
+    std::array<std::size_t, 3> origin {{ 0u, 0u, 0u }};  // first node of region (r, g, b)
+    std::array<std::size_t, 3> size   {{ 0u, 0u, 0u }};  // number of nodes in region (r, g, b)
+    std::array<T, 3> domainMin {{ static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) }};
+    std::array<T, 3> domainMax {{ static_cast<T>(1), static_cast<T>(1), static_cast<T>(1) }};
+
+    std::size_t elements (void) const noexcept { return size[0] * size[1] * size[2] * 3u; }
+};
+
+
+// --- NaN/Inf test on bit pattern: not folded away by -ffinite-math-only ---
+template <typename T>
+inline bool finite_bits (const T v) noexcept
+{
+    using Bits = typename std::conditional<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>::type;
+    static_assert(sizeof(T) == sizeof(Bits), "finite_bits: unsupported floating point type");
+    const Bits expMask = (sizeof(T) == sizeof(uint32_t) ? static_cast<Bits>(0x7F800000u) : static_cast<Bits>(0x7FF0000000000000ull));
+    Bits bits;
+    std::memcpy (&bits, &v, sizeof(bits));
+    return expMask != (bits & expMask);
+}
+
+
+// --- Bounding box of interleaved RGB pixels ---
+// Returns false if any pixel is NaN or Inf: min/max skip NaN, but lattice_coordinate() may place it
+// into any cube of the lattice, so such image has no reliable bounds.
+template <typename T>
+bool image_bounds (const T* src, const std::size_t pixels, std::array<T, 3>& minVal, std::array<T, 3>& maxVal) noexcept
+{
+    T min0 = src[0], min1 = src[1], min2 = src[2];
+    T max0 = min0,   max1 = min1,   max2 = min2;
+    bool finite = true;
+    for (std::size_t i = 0; i < pixels * 3u; i += 3)
+    {
+        min0 = std::min(min0, src[i    ]);  max0 = std::max(max0, src[i    ]);
+        min1 = std::min(min1, src[i + 1]);  max1 = std::max(max1, src[i + 1]);
+        min2 = std::min(min2, src[i + 2]);  max2 = std::max(max2, src[i + 2]);
+        finite &= (finite_bits (src[i]) & finite_bits (src[i + 1]) & finite_bits (src[i + 2]));
+    }
+    minVal = {{ min0, min1, min2 }};
+    maxVal = {{ max0, max1, max2 }};
+    return finite;
+}
+
+
+// --- Region of lattice containing all cubes touched by points inside of [minVal ... maxVal] ---
+template <typename T>
+void sub_lattice_region
+(
+    const LutElement::lutSize& lutSize,
+    const std::array<T, 3>& minVal,
+    const std::array<T, 3>& maxVal,
+    std::array<std::size_t, 3>& origin,
+    std::array<std::size_t, 3>& size
+) noexcept
+{
+    const int maxIdx = static_cast<int>(lutSize) - 1;
+    T frac;
+    for (std::size_t c = 0; c < 3; c++)
+    {
+        const int lo = lattice_coordinate (minVal[c], maxIdx, frac);
+        const int hi = lattice_coordinate (maxVal[c], maxIdx, frac) + 1;
+        origin[c] = static_cast<std::size_t>(lo);
+        size[c]   = static_cast<std::size_t>(hi - lo + 1);
+    }
+    return;
+}
+
+
+// --- Copy region of the lattice into contiguous buffer ---
+template <typename T>
+void extract_sub_lattice
+(
+    const LatticeView<T>& lut,
+    const std::array<std::size_t, 3>& origin,
+    const std::array<std::size_t, 3>& size,
+    std::vector<T>& buffer,
+    SubLattice<T>& sub
+)
+{
+    sub.lutSize   = lut.lutSize;
+    sub.origin    = origin;
+    sub.size      = size;
+    sub.domainMin = lut.domainMin;
+    sub.domainMax = lut.domainMax;
+    buffer.resize(sub.elements());
+
+    const std::size_t rowElements = size[0] * 3u;
+    T* pDst = buffer.data();
+    for (std::size_t b = origin[2]; b < origin[2] + size[2]; b++)
+        for (std::size_t g = origin[1]; g < origin[1] + size[1]; g++, pDst += rowElements)
+        {
+            const T* pSrc = lut.data + ((b * lut.lutSize + g) * lut.lutSize + origin[0]) * 3u;
+            std::copy(pSrc, pSrc + rowElements, pDst);
+        }
+
+    sub.data = buffer.data();
+    return;
+}
+
+
+// --- Interpolate buffer of interleaved RGB pixels from sub-lattice ---
+// All pixels must be inside of the region sub-lattice built for (see sub_lattice_region()).
+template <typename T>
+void sub_lattice_interpolation (const SubLattice<T>& sub, const T* src, T* dst, const std::size_t pixels) noexcept
+{
+    const int maxIdx = static_cast<int>(sub.lutSize) - 1;
+    const std::size_t sR = 3u;
+    const std::size_t sG = sR * sub.size[0];
+    const std::size_t sB = sG * sub.size[1];
+    TetraCell<T> cell;
+    T tx, ty, tz;
+
+    for (std::size_t i = 0; i < pixels; i++, src += 3, dst += 3)
+    {
+        const std::size_t x0 = static_cast<std::size_t>(lattice_coordinate (src[0], maxIdx, tx)) - sub.origin[0];
+        const std::size_t y0 = static_cast<std::size_t>(lattice_coordinate (src[1], maxIdx, ty)) - sub.origin[1];
+        const std::size_t z0 = static_cast<std::size_t>(lattice_coordinate (src[2], maxIdx, tz)) - sub.origin[2];
+
+        tetrahedral_select (tx, ty, tz, z0 * sB + y0 * sG + x0 * sR, sR, sG, sB, cell);
+        tetrahedral_eval (sub.data, cell, dst);
+        dst[0] = clip(dst[0], sub.domainMin[0], sub.domainMax[0]);
+        dst[1] = clip(dst[1], sub.domainMin[1], sub.domainMax[1]);
+        dst[2] = clip(dst[2], sub.domainMin[2], sub.domainMax[2]);
+    }
+    return;
+}
+
+
+// --- Tetrahedral interpolation of the image with automatic sub-cube extraction ---
+// If image touches small part of large lattice, this part copied into compact buffer (reused between
+// calls from the same thread) and shared by all worker threads. Returns true if sub-cube mode was used.
+template <typename T>
+bool subcube_interpolation (const LatticeView<T>& lut, const T* src, T* dst, const std::size_t pixels, const uint32_t threads = 0u)
+{
+    if (0u == pixels || !lut.valid())
+        return false;
+
+    bool useSubCube = false;
+    SubLattice<T> sub;
+    thread_local std::vector<T> subBuffer;
+
+    if (static_cast<std::size_t>(lut.elements()) * sizeof(T) >= subCubeMinLatticeBytes)
+    {
+        std::array<T, 3> minVal, maxVal;
+        std::array<std::size_t, 3> origin, size;
+        const bool bounded = image_bounds (src, pixels, minVal, maxVal);
+        sub_lattice_region (lut.lutSize, minVal, maxVal, origin, size);
+        if (true == bounded && size[0] * size[1] * size[2] * 3u * subCubeMinRatio <= static_cast<std::size_t>(lut.elements()))
+        {
+            extract_sub_lattice (lut, origin, size, subBuffer, sub);
+            useSubCube = true;
+        }
+    }
+
+    LutParallel::parallel_for (0u, pixels, 8192u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        {
+            if (true == useSubCube)
+                sub_lattice_interpolation (sub, src + begin * 3u, dst + begin * 3u, end - begin);
+            else
+                tetrahedral_interpolation (lut, src + begin * 3u, dst + begin * 3u, end - begin);
+        },
+        threads);
+
+    return useSubCube;
+}
+
+
+template <typename LutObject, typename T>
+auto subcube_interpolation (LutObject& lut, const T* src, T* dst, const std::size_t pixels, const uint32_t threads = 0u)
+    -> decltype(make_lattice_view (lut), bool())
+{
+    return subcube_interpolation (make_lattice_view (lut), src, dst, pixels, threads);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_SUB_CUBE_INTERPOLATOR__
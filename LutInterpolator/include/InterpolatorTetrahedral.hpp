@@ -13,6 +13,141 @@
 namespace Interpolator
 {
 
+// Location of point inside of the lattice: 4 vertexes of enclosing tetrahedron (element offsets of
+// red component in flat LUT body) and barycentric weights of these vertexes. Cell depends only
+// on input point and lattice size, so the same cell may be evaluated against any LUT body of equal size.
+template <typename T>
+struct TetraCell
+{
+    std::array<std::size_t, 4> offset;
+    std::array<T, 4> weight;
+};
+
+
+// --- Select tetrahedron and weights for fractional position (tx, ty, tz) inside of the cube ---
+// base - offset of cube lower corner, sR/sG/sB - element strides of lattice along red/green/blue axis.
+template <typename T>
+inline void tetrahedral_select
+(
+    const T tx, const T ty, const T tz,
+    const std::size_t base,
+    const std::size_t sR, const std::size_t sG, const std::size_t sB,
+    TetraCell<T>& cell
+) noexcept
+{
+    cell.offset[0] = base;
+    cell.offset[3] = base + sR + sG + sB;
+
+    // Determine which tetrahedron the point is in: path from black to white corner along the largest fractions
+    if (tx >= ty)
+    {
+        if (ty >= tz) { // R > G > B
+            cell.offset[1] = base + sR;      cell.offset[2] = base + sR + sG;
+            cell.weight = {{ T(1) - tx, tx - ty, ty - tz, tz }};
+        } else if (tx >= tz) { // R > B > G
+            cell.offset[1] = base + sR;      cell.offset[2] = base + sR + sB;
+            cell.weight = {{ T(1) - tx, tx - tz, tz - ty, ty }};
+        } else { // B > R > G
+            cell.offset[1] = base + sB;      cell.offset[2] = base + sR + sB;
+            cell.weight = {{ T(1) - tz, tz - tx, tx - ty, ty }};
+        }
+    }
+    else
+    { // G > R
+        if (tz >= ty) { // B > G > R
+            cell.offset[1] = base + sB;      cell.offset[2] = base + sG + sB;
+            cell.weight = {{ T(1) - tz, tz - ty, ty - tx, tx }};
+        } else if (tz >= tx) { // G > B > R
+            cell.offset[1] = base + sG;      cell.offset[2] = base + sG + sB;
+            cell.weight = {{ T(1) - ty, ty - tz, tz - tx, tx }};
+        } else { // G > R > B
+            cell.offset[1] = base + sG;      cell.offset[2] = base + sR + sG;
+            cell.weight = {{ T(1) - ty, ty - tx, tx - tz, tz }};
+        }
+    }
+    return;
+}
+
+
+// --- Lower corner of the cube enclosing lattice coordinate and fraction inside of this cube ---
+// Input coordinate clipped to [0...1]; last node treated as upper corner of last cube.
+template <typename T>
+inline int lattice_coordinate (const T v, const int maxIdx, T& frac) noexcept
+{
+    const T f = clip(v, T(0.0), T(1.0)) * static_cast<T>(maxIdx);
+    const int i0 = std::min(static_cast<int>(f), maxIdx - 1);
+    frac = f - static_cast<T>(i0);
+    return i0;
+}
+
+
+// --- Compute tetrahedron cell for point (r, g, b); input coordinates clipped to [0...1] ---
+template <typename T>
+inline void tetrahedral_cell (T r, T g, T b, const LutElement::lutSize& lutSize, TetraCell<T>& cell) noexcept
+{
+    const int maxIdx = static_cast<int>(lutSize) - 1;
+    T tx, ty, tz;
+    const int x0 = lattice_coordinate (r, maxIdx, tx);
+    const int y0 = lattice_coordinate (g, maxIdx, ty);
+    const int z0 = lattice_coordinate (b, maxIdx, tz);
+
+    const std::size_t sR = 3u;
+    const std::size_t sG = sR * lutSize;
+    const std::size_t sB = sG * lutSize;
+    const std::size_t base = static_cast<std::size_t>(z0) * sB + static_cast<std::size_t>(y0) * sG + static_cast<std::size_t>(x0) * sR;
+
+    tetrahedral_select (tx, ty, tz, base, sR, sG, sB, cell);
+    return;
+}
+
+
+// --- Evaluate precomputed cell against LUT body (no output clamping) ---
+template <typename T>
+inline void tetrahedral_eval (const T* lutData, const TetraCell<T>& cell, T* out) noexcept
+{
+    const T* p0 = lutData + cell.offset[0];
+    const T* p1 = lutData + cell.offset[1];
+    const T* p2 = lutData + cell.offset[2];
+    const T* p3 = lutData + cell.offset[3];
+    out[0] = p0[0] * cell.weight[0] + p1[0] * cell.weight[1] + p2[0] * cell.weight[2] + p3[0] * cell.weight[3];
+    out[1] = p0[1] * cell.weight[0] + p1[1] * cell.weight[1] + p2[1] * cell.weight[2] + p3[1] * cell.weight[3];
+    out[2] = p0[2] * cell.weight[0] + p1[2] * cell.weight[1] + p2[2] * cell.weight[2] + p3[2] * cell.weight[3];
+    return;
+}
+
+
+// --- Clamp interpolated value to LUT domain ---
+template <typename T>
+inline void domain_clamp (const LatticeView<T>& lut, T* out) noexcept
+{
+    out[0] = clip(out[0], lut.domainMin[0], lut.domainMax[0]);
+    out[1] = clip(out[1], lut.domainMin[1], lut.domainMax[1]);
+    out[2] = clip(out[2], lut.domainMin[2], lut.domainMax[2]);
+    return;
+}
+
+
+// --- Interpolate one RGB point: in and out may point to the same triplet ---
+template <typename T>
+inline void tetrahedral_interpolation (const LatticeView<T>& lut, const T* in, T* out) noexcept
+{
+    TetraCell<T> cell;
+    tetrahedral_cell (in[0], in[1], in[2], lut.lutSize, cell);
+    tetrahedral_eval (lut.data, cell, out);
+    domain_clamp (lut, out);
+    return;
+}
+
+
+// --- Interpolate buffer of interleaved RGB pixels: src and dst may point to the same buffer ---
+template <typename T>
+inline void tetrahedral_interpolation (const LatticeView<T>& lut, const T* src, T* dst, const std::size_t pixels) noexcept
+{
+    for (std::size_t i = 0; i < pixels; i++, src += 3, dst += 3)
+        tetrahedral_interpolation (lut, src, dst);
+    return;
+}
+
 
 template <typename T>
 LutElement::lutTableRaw<T> tetrahedral_interpolation
@@ -24,105 +159,14 @@ LutElement::lutTableRaw<T> tetrahedral_interpolation
     const LutElement::lutSize& lutSize
 )
 {
-    const int res_r = lutSize.res_r;
-    const int res_g = lutSize.res_g;
-    const int res_b = lutSize.res_b;
-
-    // --- Input Coordinate Clamping ---
-    T x = clip(r, T(0.0), T(1.0));
-    T y = clip(g, T(0.0), T(1.0));
-    T z = clip(b, T(0.0), T(1.0));
-
-    // Fallback if not fully 3D
-    if (res_r <= 1 || res_g <= 1 || res_b <= 1)
-	{
-        return trilinear_interpolation(lutData, r, g, b, domain_min, domain_max, lutSize);
-    }
-
-    // --- Calculate Indices and Fractional Weights ---
-    T fx = x * static_cast<T>(res_r - 1);
-    T fy = y * static_cast<T>(res_g - 1);
-    T fz = z * static_cast<T>(res_b - 1);
-
-    int x0 = static_cast<int>(std::floor(fx));
-    int y0 = static_cast<int>(std::floor(fy));
-    int z0 = static_cast<int>(std::floor(fz));
-
-    int x1 = clip(x0 + 1, 0, res_r - 1);
-    int y1 = clip(y0 + 1, 0, res_g - 1);
-    int z1 = clip(z0 + 1, 0, res_b - 1);
-    x0 = clip(x0, 0, res_r - 1);
-    y0 = clip(y0, 0, res_g - 1);
-    z0 = clip(z0, 0, res_b - 1);
-
-    T tx = fx - static_cast<T>(x0);
-    T ty = fy - static_cast<T>(y0);
-    T tz = fz - static_cast<T>(z0);
-
-    // Helper lambda to fetch a point
-    auto get_point = [&](int r_idx, int g_idx, int b_idx) -> std::array<T, 3>
-	{
-        std::size_t tripletIndex = (static_cast<std::size_t>(b_idx) * res_g * res_r) + (static_cast<std::size_t>(g_idx) * res_r) + r_idx;
-        std::size_t flatIndexR = tripletIndex * 3;
-        return { lutData[flatIndexR], lutData[flatIndexR + 1], lutData[flatIndexR + 2] };
-    };
-
-    // Fetch all 8 corner values of the cube
-    std::array<T, 3> c000 = get_point(x0, y0, z0); // Black corner
-    std::array<T, 3> c100 = get_point(x1, y0, z0); // Red corner
-    std::array<T, 3> c010 = get_point(x0, y1, z0); // Green corner
-    std::array<T, 3> c001 = get_point(x0, y0, z1); // Blue corner
-    std::array<T, 3> c110 = get_point(x1, y1, z0); // Yellow corner
-    std::array<T, 3> c101 = get_point(x1, y0, z1); // Magenta corner
-    std::array<T, 3> c011 = get_point(x0, y1, z1); // Cyan corner
-    std::array<T, 3> c111 = get_point(x1, y1, z1); // White corner
-
-    LutElement::lutTableRaw<T> interpolated_val(3);
-    
-    // Determine which tetrahedron the point is in and interpolate
-    if (tx > ty)
-	{
-        if (ty > tz) { // R > G > B
-            interpolated_val[0] = (c000[0] + (c100[0]-c000[0])*tx + (c010[0]-c000[0])*ty + (c001[0]-c000[0])*tz);
-            interpolated_val[1] = (c000[1] + (c100[1]-c000[1])*tx + (c010[1]-c000[1])*ty + (c001[1]-c000[1])*tz);
-            interpolated_val[2] = (c000[2] + (c100[2]-c000[2])*tx + (c010[2]-c000[2])*ty + (c001[2]-c000[2])*tz);
-        } else if (tx > tz) { // R > B > G
-            interpolated_val[0] = (c000[0] + (c100[0]-c000[0])*tx + (c001[0]-c000[0])*tz + (c010[0]-c000[0])*ty);
-            interpolated_val[1] = (c000[1] + (c100[1]-c000[1])*tx + (c001[1]-c000[1])*tz + (c010[1]-c000[1])*ty);
-            interpolated_val[2] = (c000[2] + (c100[2]-c000[2])*tx + (c001[2]-c000[2])*tz + (c010[2]-c000[2])*ty);
-        } else { // B > R > G
-            interpolated_val[0] = (c001[0] + (c101[0]-c001[0])*tx + (c011[0]-c001[0])*ty + (c111[0]-c101[0]-c011[0]+c001[0])*tz);
-            interpolated_val[1] = (c001[1] + (c101[1]-c001[1])*tx + (c011[1]-c001[1])*ty + (c111[1]-c101[1]-c011[1]+c001[1])*tz);
-            interpolated_val[2] = (c001[2] + (c101[2]-c001[2])*tx + (c011[2]-c001[2])*ty + (c111[2]-c101[2]-c011[2]+c001[2])*tz);
-        }
-    } 
-	else
-	{ // G >= R
-        if (tz > ty) { // B > G > R
-            interpolated_val[0] = (c001[0] + (c011[0]-c001[0])*ty + (c101[0]-c001[0])*tx + (c111[0]-c011[0]-c101[0]+c001[0])*tz);
-            interpolated_val[1] = (c001[1] + (c011[1]-c001[1])*ty + (c101[1]-c001[1])*tx + (c111[1]-c011[1]-c101[1]+c001[1])*tz);
-            interpolated_val[2] = (c001[2] + (c011[2]-c001[2])*ty + (c101[2]-c001[2])*tx + (c111[2]-c011[2]-c101[2]+c001[2])*tz);
-        } else if (tz > tx) { // G > B > R
-            interpolated_val[0] = (c010[0] + (c110[0]-c010[0])*tx + (c011[0]-c010[0])*tz + (c111[0]-c110[0]-c011[0]+c010[0])*ty);
-            interpolated_val[1] = (c010[1] + (c110[1]-c010[1])*tx + (c011[1]-c010[1])*tz + (c111[1]-c110[1]-c011[1]+c010[1])*ty);
-            interpolated_val[2] = (c010[2] + (c110[2]-c010[2])*tx + (c011[2]-c010[2])*tz + (c111[2]-c110[2]-c011[2]+c010[2])*ty);
-        } else { // G > R > B
-            interpolated_val[0] = (c010[0] + (c110[0]-c010[0])*tx + (c001[0]-c000[0])*tz + (c111[0]-c110[0]-c101[0]+c100[0])*ty);
-            interpolated_val[1] = (c010[1] + (c110[1]-c010[1])*tx + (c001[1]-c000[1])*tz + (c111[1]-c110[1]-c101[1]+c100[1])*ty);
-            interpolated_val[2] = (c010[2] + (c110[2]-c010[2])*tx + (c001[2]-c000[2])*tz + (c111[2]-c110[2]-c101[2]+c100[2])*ty);
-        }
-    }
-    
-    // --- Output Clamping ---
+    const LatticeView<T> lut = make_lattice_view (lutData, lutSize, domain_min, domain_max);
+    const T in[3] = { r, g, b };
     LutElement::lutTableRaw<T> clamped_val(3);
-    clamped_val[0] = clip(interpolated_val[0], domain_min[0], domain_max[0]);
-    clamped_val[1] = clip(interpolated_val[1], domain_min[1], domain_max[1]);
-    clamped_val[2] = clip(interpolated_val[2], domain_min[2], domain_max[2]);
-
+    tetrahedral_interpolation (lut, in, clamped_val.data());
     return clamped_val;
 }
 
-)
+} // namespace Interpolator
 
 
-#endif // __LUT_TETRAHEDRAL_INTERPOLATOR__
\ No newline at end of file
+#endif // __LUT_TETRAHEDRAL_INTERPOLATOR__
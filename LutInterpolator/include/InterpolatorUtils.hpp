@@ -1,6 +1,11 @@
 #ifndef __LUT_INTERPOLATOR_UTILS__
 #define __LUT_INTERPOLATOR_UTILS__
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include "lutElement.h"
+
 namespace Interpolator
 {
 
@@ -11,6 +16,50 @@ namespace Interpolator
         return std::max(min_val, std::min(max_val, value));
     }
 
+
+    // --- Non-owning view of flat 3D LUT body (red changes fastest, triplet per node) ---
+    template <typename T>
+    struct LatticeView
+    {
+        const T* data = nullptr;
+        LutElement::lutSize lutSize = 0u;
+        std::array<T, 3> domainMin {{ static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) }};
+        std::array<T, 3> domainMax {{ static_cast<T>(1), static_cast<T>(1), static_cast<T>(1) }};
+
+        bool valid (void) const noexcept { return (nullptr != data && lutSize >= 2u); }
+        LutElement::lutSize elements (void) const noexcept { return lutSize * lutSize * lutSize * 3u; }
+    };
+
+
+    template <typename T>
+    inline LatticeView<T> make_lattice_view
+    (
+        const LutElement::lutTable3D<T>& lutData,
+        const LutElement::lutSize& lutSize,
+        const LutElement::lutTableRaw<T>& domain_min,
+        const LutElement::lutTableRaw<T>& domain_max
+    )
+    {
+        LatticeView<T> view;
+        view.data = lutData.data();
+        view.lutSize = lutSize;
+        for (size_t c = 0; c < 3 && c < domain_min.size() && c < domain_max.size(); c++)
+        {
+            view.domainMin[c] = domain_min[c];
+            view.domainMax[c] = domain_max[c];
+        }
+        return view;
+    }
+
+    // build view from LUT object (CCubeLut3D<T>, ...). View valid while LUT object alive and not reloaded.
+    // LUT body read through const access: non-const get_data() is modification of LUT and drops its caches.
+    template <typename LutObject>
+    inline auto make_lattice_view (LutObject& lut) -> LatticeView<typename std::decay<decltype(lut.get_data()[0])>::type>
+    {
+        const auto domain = lut.getMinMaxDomain();
+        return make_lattice_view (static_cast<const LutObject&>(lut).get_data(), lut.getLutSize(), domain.first, domain.second);
+    }
+
 } // namespace Interpolator3D
 
 
@@ -0,0 +1,204 @@
+#ifndef __LUT_YCBCR_INTERPOLATOR__
+#define __LUT_YCBCR_INTERPOLATOR__
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutErrors.h"
+
+namespace Interpolator
+{
+
+enum class YCbCrMatrix : uint32_t
+{
+    Rec709 = 0,
+    Rec2020       // non-constant luminance
+};
+
+enum class YCbCrSubsampling : uint32_t
+{
+    S420 = 0,     // chroma plane: half width, half height (P010 style)
+    S422          // chroma plane: half width, full height (P210 style)
+};
+
+
+// --- 10 bit YCbCr frame: luma plane and interleaved CbCr plane of uint16_t samples ---
+// msbAligned: sample stored in bits 6...15 (P010/P210), otherwise in bits 0...9.
+struct YCbCrFrame
+{
+    uint16_t* luma   = nullptr;
+    uint16_t* chroma = nullptr;
+    std::size_t width  = 0u;
+    std::size_t height = 0u;
+    std::size_t lumaStride   = 0u;  // bytes between luma rows; 0 - width * 2
+    std::size_t chromaStride = 0u;  // bytes between chroma rows; 0 - width * 2
+    YCbCrSubsampling subsampling = YCbCrSubsampling::S420;
+    bool msbAligned = true;
+    bool fullRange  = false;        // false - video range: Y [64...940], CbCr [64...960]
+
+    std::size_t luma_stride   (void) const noexcept { return (0u != lumaStride   ? lumaStride   : width * sizeof(uint16_t)); }
+    std::size_t chroma_stride (void) const noexcept { return (0u != chromaStride ? chromaStride : width * sizeof(uint16_t)); }
+    std::size_t chroma_height (void) const noexcept { return (YCbCrSubsampling::S420 == subsampling ? height / 2u : height); }
+
+    uint16_t* luma_row (const std::size_t y) const noexcept
+    {
+        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(luma) + y * luma_stride());
+    }
+    uint16_t* chroma_row (const std::size_t y) const noexcept
+    {
+        return reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(chroma) + y * chroma_stride());
+    }
+};
+
+
+// --- Conversion constants for selected matrix and range ---
+template <typename T>
+struct YCbCrCoefficients
+{
+    T kr, kg, kb;
+    T crToR, cbToB, cbToG, crToG;   // decode: R = Y + crToR * Cr, B = Y + cbToB * Cb, G = Y - cbToG * Cb - crToG * Cr
+    T yScale, yOffset, cScale, cOffset;
+
+    YCbCrCoefficients (const YCbCrMatrix matrix, const bool fullRange) noexcept
+    {
+        kr = (YCbCrMatrix::Rec2020 == matrix ? T(0.2627) : T(0.2126));
+        kb = (YCbCrMatrix::Rec2020 == matrix ? T(0.0593) : T(0.0722));
+        kg = T(1) - kr - kb;
+        crToR = T(2) * (T(1) - kr);
+        cbToB = T(2) * (T(1) - kb);
+        cbToG = kb * cbToB / kg;
+        crToG = kr * crToR / kg;
+        yScale  = (true == fullRange ? T(1023) : T(876));
+        yOffset = (true == fullRange ? T(0)    : T(64));
+        cScale  = (true == fullRange ? T(1023) : T(896));
+        cOffset = T(512);
+    }
+};
+
+
+// --- Process one chroma site: 'n' luma samples sharing one CbCr pair ---
+// Pixels converted to RGB, interpolated and converted back in registers; output chroma is average of the site.
+// Source samples of the site read before destination written, so source and destination may be the same.
+template <typename T, std::size_t n>
+inline void ycbcr_site
+(
+    const LatticeView<T>& lut,
+    const YCbCrCoefficients<T>& kIn,
+    const YCbCrCoefficients<T>& kOut,
+    const uint32_t inShift,
+    const uint32_t outShift,
+    const uint16_t* const (&srcY)[n],
+    const uint16_t* srcC,
+    uint16_t* const (&dstY)[n],
+    uint16_t* dstC
+) noexcept
+{
+    const T cb = (static_cast<T>(srcC[0] >> inShift) - kIn.cOffset) / kIn.cScale;
+    const T cr = (static_cast<T>(srcC[1] >> inShift) - kIn.cOffset) / kIn.cScale;
+    const T dR = kIn.crToR * cr;
+    const T dG = kIn.cbToG * cb + kIn.crToG * cr;
+    const T dB = kIn.cbToB * cb;
+
+    T sumB = T(0), sumR = T(0);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const T luma = (static_cast<T>(*srcY[i] >> inShift) - kIn.yOffset) / kIn.yScale;
+        T rgb[3] = { luma + dR, luma - dG, luma + dB };
+        tetrahedral_interpolation (lut, rgb, rgb);
+
+        const T outY = kOut.kr * rgb[0] + kOut.kg * rgb[1] + kOut.kb * rgb[2];
+        sumR += rgb[0] - outY;
+        sumB += rgb[2] - outY;
+        *dstY[i] = static_cast<uint16_t>(static_cast<uint32_t>(clip(outY * kOut.yScale + kOut.yOffset + T(0.5), T(0), T(1023))) << outShift);
+    }
+
+    const T avg = T(1) / static_cast<T>(n);
+    const T outCb = sumB * avg / kOut.cbToB;
+    const T outCr = sumR * avg / kOut.crToR;
+    dstC[0] = static_cast<uint16_t>(static_cast<uint32_t>(clip(outCb * kOut.cScale + kOut.cOffset + T(0.5), T(0), T(1023))) << outShift);
+    dstC[1] = static_cast<uint16_t>(static_cast<uint32_t>(clip(outCr * kOut.cScale + kOut.cOffset + T(0.5), T(0), T(1023))) << outShift);
+    return;
+}
+
+
+// --- Apply 3D LUT to 10 bit YCbCr 4:2:0 / 4:2:2 frame without intermediate RGB buffers ---
+// src and dst may describe the same frame (in-place). Chroma upsampled by replication (co-sited),
+// downsampled by averaging of the 2x2 (4:2:0) or 2x1 (4:2:2) site.
+template <typename T>
+LutErrorCode::LutState ycbcr_interpolation
+(
+    const LatticeView<T>& lut,
+    const YCbCrFrame& src,
+    const YCbCrFrame& dst,
+    const YCbCrMatrix matrix,
+    const uint32_t threads = 0u
+)
+{
+    if (!lut.valid())
+        return LutErrorCode::LutState::NotInitialized;
+    if (nullptr == src.luma || nullptr == src.chroma || nullptr == dst.luma || nullptr == dst.chroma)
+        return LutErrorCode::LutState::NotInitialized;
+    if (0u == src.width || 0u == src.height || 0u != (src.width & 1u) ||
+        (YCbCrSubsampling::S420 == src.subsampling && 0u != (src.height & 1u)) ||
+        src.width != dst.width || src.height != dst.height || src.subsampling != dst.subsampling)
+        return LutErrorCode::LutState::IncorrectDimension;
+
+    const YCbCrCoefficients<T> kIn  (matrix, src.fullRange);
+    const YCbCrCoefficients<T> kOut (matrix, dst.fullRange);
+    const uint32_t inShift  = (true == src.msbAligned ? 6u : 0u);
+    const uint32_t outShift = (true == dst.msbAligned ? 6u : 0u);
+    const bool is420 = (YCbCrSubsampling::S420 == src.subsampling);
+
+    LutParallel::parallel_for (0u, src.chroma_height(), 16u,
+        [&](const std::size_t begin, const std::size_t end, const uint32_t)
+        {
+            for (std::size_t cy = begin; cy < end; cy++)
+            {
+                const std::size_t y0 = (true == is420 ? cy * 2u : cy);
+                const uint16_t* srcY0 = src.luma_row (y0);
+                const uint16_t* srcC  = src.chroma_row (cy);
+                uint16_t* dstY0 = dst.luma_row (y0);
+                uint16_t* dstC  = dst.chroma_row (cy);
+
+                if (true == is420)
+                {
+                    const uint16_t* srcY1 = src.luma_row (y0 + 1u);
+                    uint16_t* dstY1 = dst.luma_row (y0 + 1u);
+                    for (std::size_t x = 0; x < src.width; x += 2u)
+                    {
+                        const uint16_t* const sY[4] = { srcY0 + x, srcY0 + x + 1u, srcY1 + x, srcY1 + x + 1u };
+                        uint16_t* const dY[4] = { dstY0 + x, dstY0 + x + 1u, dstY1 + x, dstY1 + x + 1u };
+                        ycbcr_site (lut, kIn, kOut, inShift, outShift, sY, srcC + x, dY, dstC + x);
+                    }
+                }
+                else
+                {
+                    for (std::size_t x = 0; x < src.width; x += 2u)
+                    {
+                        const uint16_t* const sY[2] = { srcY0 + x, srcY0 + x + 1u };
+                        uint16_t* const dY[2] = { dstY0 + x, dstY0 + x + 1u };
+                        ycbcr_site (lut, kIn, kOut, inShift, outShift, sY, srcC + x, dY, dstC + x);
+                    }
+                }
+            }
+        },
+        threads);
+
+    return LutErrorCode::LutState::OK;
+}
+
+
+template <typename LutObject>
+auto ycbcr_interpolation (LutObject& lut, const YCbCrFrame& src, const YCbCrFrame& dst, const YCbCrMatrix matrix, const uint32_t threads = 0u)
+    -> decltype(make_lattice_view (lut), LutErrorCode::LutState())
+{
+    return ycbcr_interpolation (make_lattice_view (lut), src, dst, matrix, threads);
+}
+
+} // namespace Interpolator
+
+#endif // __LUT_YCBCR_INTERPOLATOR__
@@ -0,0 +1,183 @@
+#ifndef __LUT_LIBRARY_TEMPORAL_APPLIER__
+#define __LUT_LIBRARY_TEMPORAL_APPLIER__
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutElement.h"
+#include "lutErrors.h"
+#include "lutCube3D.h"
+
+namespace Lut
+{
+
+/*
+   Stateful 3D LUT applier for video streams with static content (locked-off shots, screen capture, UI overlays).
+
+   Applier keeps copy of previous input and output frames. Frame split on tiles of tileWidth x tileHeight pixels;
+   input tile compared row by row against previous frame (memcmp) and LUT evaluated only for changed tiles,
+   output of unchanged tiles copied from previous output frame. History dropped when LUT or frame size changed.
+*/
+template <typename T, typename = std::enable_if_t<std::is_floating_point<T>::value>>
+class CTemporalApplier
+{
+public:
+    using CTemporalApplierT = T;
+
+    static constexpr std::size_t tileWidth  = 64u;
+    static constexpr std::size_t tileHeight = 16u;
+
+    struct FrameStats
+    {
+        uint64_t tiles = 0u;
+        uint64_t reusedTiles = 0u;
+
+        double reuse_rate (void) const noexcept { return (0u != tiles ? static_cast<double>(reusedTiles) / static_cast<double>(tiles) : 0.0); }
+    };
+
+    CTemporalApplier (void) = default;
+    ~CTemporalApplier(void) = default;
+
+    // 3D LUT: flat body, red changes fastest (layout of Cube 3D LUT); LUT body copied into the applier
+    LutErrorCode::LutState SetLut
+    (
+        const LutElement::lutTable3D<T>& lutBody,
+        const LutElement::lutSize lutSize,
+        const LutElement::lutTableRaw<T>& domainMin = { T(0), T(0), T(0) },
+        const LutElement::lutTableRaw<T>& domainMax = { T(1), T(1), T(1) }
+    )
+    {
+        if (lutSize < 2u || lutBody.size() < lutSize * lutSize * lutSize * 3u)
+            return LutErrorCode::LutState::LutSizeInvalid;
+        if (3 != domainMin.size() || 3 != domainMax.size())
+            return LutErrorCode::LutState::IncorrectDimension;
+
+        m_body.assign (lutBody.cbegin(), lutBody.cbegin() + lutSize * lutSize * lutSize * 3u);
+        m_lut.data = m_body.data();
+        m_lut.lutSize = lutSize;
+        for (int c = 0; c < 3; c++)
+        {
+            m_lut.domainMin[c] = domainMin[c];
+            m_lut.domainMax[c] = domainMax[c];
+        }
+        Reset();
+        return LutErrorCode::LutState::OK;
+    }
+
+    LutErrorCode::LutState SetLut (CCubeLut3D<T>& lut)
+    {
+        const auto domain = lut.getMinMaxDomain();
+        return SetLut (static_cast<const CCubeLut3D<T>&>(lut).get_data(), lut.getLutSize(), domain.first, domain.second);
+    }
+
+    // drop frame history: next frame processed completely
+    void Reset (void) noexcept
+    {
+        m_width = m_height = 0u;
+        m_hasHistory = false;
+        return;
+    }
+
+    const FrameStats& LastFrameStats (void) const noexcept { return m_lastStats; }
+    const FrameStats& TotalStats (void) const noexcept { return m_totalStats; }
+
+    // apply LUT on next frame of interleaved RGB pixels; src and dst may point to the same buffer
+    LutErrorCode::LutState Apply (const T* src, T* dst, const std::size_t width, const std::size_t height, const uint32_t threads = 0u)
+    {
+        if (!m_lut.valid() || nullptr == src || nullptr == dst)
+            return LutErrorCode::LutState::NotInitialized;
+        if (0u == width || 0u == height)
+            return LutErrorCode::LutState::IncorrectDimension;
+
+        if (width != m_width || height != m_height)
+        {
+            m_width = width;
+            m_height = height;
+            m_prevIn.resize (width * height * 3u);
+            m_prevOut.resize (width * height * 3u);
+            m_hasHistory = false;
+        }
+
+        const std::size_t tilesX = (width  + tileWidth  - 1u) / tileWidth;
+        const std::size_t tilesY = (height + tileHeight - 1u) / tileHeight;
+        const uint32_t workers = (0u != threads ? threads : LutParallel::threads_number());
+        std::vector<uint64_t> reused (workers, 0u);
+
+        LutParallel::parallel_for (0u, tilesY, 1u,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t threadIdx)
+            {
+                for (std::size_t ty = begin; ty < end; ty++)
+                    for (std::size_t tx = 0; tx < tilesX; tx++)
+                        reused[threadIdx] += (true == ApplyTile (src, dst, tx * tileWidth, ty * tileHeight) ? 1u : 0u);
+            },
+            workers);
+
+        m_hasHistory = true;
+        m_lastStats.tiles = tilesX * tilesY;
+        m_lastStats.reusedTiles = 0u;
+        for (const auto r : reused)
+            m_lastStats.reusedTiles += r;
+        m_totalStats.tiles += m_lastStats.tiles;
+        m_totalStats.reusedTiles += m_lastStats.reusedTiles;
+        return LutErrorCode::LutState::OK;
+    }
+
+
+private:
+    LutElement::lutTable3D<T> m_body;
+    Interpolator::LatticeView<T> m_lut {};
+    std::vector<T> m_prevIn;
+    std::vector<T> m_prevOut;
+    std::size_t m_width = 0u;
+    std::size_t m_height = 0u;
+    bool m_hasHistory = false;
+    FrameStats m_lastStats;
+    FrameStats m_totalStats;
+
+    // returns true if tile reused from previous frame
+    bool ApplyTile (const T* src, T* dst, const std::size_t x0, const std::size_t y0) noexcept
+    {
+        const std::size_t w = std::min(tileWidth,  m_width  - x0);
+        const std::size_t h = std::min(tileHeight, m_height - y0);
+        const std::size_t rowElements = w * 3u;
+
+        bool unchanged = m_hasHistory;
+        for (std::size_t y = y0; y < y0 + h && true == unchanged; y++)
+        {
+            const std::size_t offset = (y * m_width + x0) * 3u;
+            unchanged = (0 == std::memcmp (src + offset, m_prevIn.data() + offset, rowElements * sizeof(T)));
+        }
+
+        for (std::size_t y = y0; y < y0 + h; y++)
+        {
+            const std::size_t offset = (y * m_width + x0) * 3u;
+            if (true == unchanged)
+                std::memcpy (dst + offset, m_prevOut.data() + offset, rowElements * sizeof(T));
+            else
+            {
+                // keep input first: src and dst may be the same buffer
+                std::memcpy (m_prevIn.data() + offset, src + offset, rowElements * sizeof(T));
+                Interpolator::tetrahedral_interpolation (m_lut, m_prevIn.data() + offset, m_prevOut.data() + offset, w);
+                std::memcpy (dst + offset, m_prevOut.data() + offset, rowElements * sizeof(T));
+            }
+        }
+        return unchanged;
+    }
+
+}; // CTemporalApplier
+
+template <typename T, typename U>
+constexpr std::size_t CTemporalApplier<T, U>::tileWidth;
+template <typename T, typename U>
+constexpr std::size_t CTemporalApplier<T, U>::tileHeight;
+
+} // namespace Lut
+
+#endif // __LUT_LIBRARY_TEMPORAL_APPLIER__
@@ -0,0 +1,338 @@
+#ifndef __LUT_LIBRARY_TRANSFORM_CHAIN__
+#define __LUT_LIBRARY_TRANSFORM_CHAIN__
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include "InterpolatorUtils.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "parallel_for.h"
+#include "lutElement.h"
+#include "lutErrors.h"
+#include "lutCube1D.h"
+#include "lutCube3D.h"
+
+namespace Lut
+{
+
+/*
+   Ordered list of typed color transforms (CLF ProcessList analog) executed in one pass over image.
+
+   Supported stages:
+     - Matrix: 3x3 matrix with optional offset (CLF Matrix 3x3 / 3x4);
+     - Range:  linear scale of [minIn...maxIn] to [minOut...maxOut] with optional clamp (CLF Range);
+     - Lut1D:  per-channel 1D LUT with linear interpolation (CLF LUT1D / Cube 1D);
+     - Lut3D:  3D LUT with tetrahedral interpolation (CLF LUT3D / Cube 3D).
+
+   Image is processed by tiles of 'chainTilePixels' pixels: all stages applied on a tile while it stays
+   in L1 cache, so no intermediate frames are created. Stages fused on insertion:
+     - adjacent matrices merged into single matrix;
+     - scale and offset of Range folded into preceding Matrix, only clamp (if required) left as separate stage;
+     - Range without clamp converted to Matrix (and merged with neighbour matrices).
+*/
+template <typename T, typename = std::enable_if_t<std::is_floating_point<T>::value>>
+class CTransformChain
+{
+public:
+    enum class StageType
+    {
+        Matrix = 0,
+        Range,
+        Lut1D,
+        Lut3D
+    };
+
+    static constexpr std::size_t chainTilePixels = 128u;
+
+    CTransformChain (void) = default;
+    ~CTransformChain(void) = default;
+
+    std::size_t stages (void) const noexcept { return m_stages.size(); }
+    StageType stage_type (const std::size_t idx) const { return m_stages.at(idx).type; }
+    bool empty (void) const noexcept { return m_stages.empty(); }
+    void clear (void) noexcept { m_stages.clear(); }
+
+    // matrix in row-major order: out[i] = m[3*i] * r + m[3*i+1] * g + m[3*i+2] * b + offset[i]
+    LutErrorCode::LutState AddMatrix (const std::array<T, 9>& m, const std::array<T, 3>& offset = {{ T(0), T(0), T(0) }})
+    {
+        if (!m_stages.empty() && StageType::Matrix == m_stages.back().type)
+        {
+            // M2 * (M1 * x + o1) + o2 = (M2 * M1) * x + (M2 * o1 + o2)
+            Stage& prev = m_stages.back();
+            std::array<T, 12> fused;
+            for (int i = 0; i < 3; i++)
+            {
+                for (int j = 0; j < 3; j++)
+                    fused[i * 4 + j] = m[i * 3 + 0] * prev.mtx[0 * 4 + j] + m[i * 3 + 1] * prev.mtx[1 * 4 + j] + m[i * 3 + 2] * prev.mtx[2 * 4 + j];
+                fused[i * 4 + 3] = m[i * 3 + 0] * prev.mtx[3] + m[i * 3 + 1] * prev.mtx[7] + m[i * 3 + 2] * prev.mtx[11] + offset[i];
+            }
+            prev.mtx = fused;
+            return LutErrorCode::LutState::OK;
+        }
+
+        Stage stage;
+        stage.type = StageType::Matrix;
+        for (int i = 0; i < 3; i++)
+        {
+            stage.mtx[i * 4 + 0] = m[i * 3 + 0];
+            stage.mtx[i * 4 + 1] = m[i * 3 + 1];
+            stage.mtx[i * 4 + 2] = m[i * 3 + 2];
+            stage.mtx[i * 4 + 3] = offset[i];
+        }
+        m_stages.push_back(std::move(stage));
+        return LutErrorCode::LutState::OK;
+    }
+
+    // per-channel range: out = (in - minIn) * (maxOut - minOut) / (maxIn - minIn) + minOut [clamped to minOut...maxOut]
+    LutErrorCode::LutState AddRange
+    (
+        const std::array<T, 3>& minIn,  const std::array<T, 3>& maxIn,
+        const std::array<T, 3>& minOut, const std::array<T, 3>& maxOut,
+        const bool clamp = true
+    )
+    {
+        std::array<T, 3> scale, offset;
+        for (int c = 0; c < 3; c++)
+        {
+            if (maxIn[c] == minIn[c])
+                return LutErrorCode::LutState::DomainBoundReversed;
+            scale[c]  = (maxOut[c] - minOut[c]) / (maxIn[c] - minIn[c]);
+            offset[c] = minOut[c] - minIn[c] * scale[c];
+        }
+
+        const bool prevMatrix = (!m_stages.empty() && StageType::Matrix == m_stages.back().type);
+        if (true == prevMatrix || false == clamp)
+        {
+            // fold linear part of the range into matrix
+            const std::array<T, 9> diag {{ scale[0], T(0), T(0), T(0), scale[1], T(0), T(0), T(0), scale[2] }};
+            AddMatrix (diag, offset);
+            if (false == clamp)
+                return LutErrorCode::LutState::OK;
+            // leave clamp only
+            scale  = {{ T(1), T(1), T(1) }};
+            offset = {{ T(0), T(0), T(0) }};
+        }
+
+        Stage stage;
+        stage.type = StageType::Range;
+        for (int c = 0; c < 3; c++)
+        {
+            stage.mtx[c * 4 + 0] = scale[c];
+            stage.mtx[c * 4 + 1] = offset[c];
+            stage.mtx[c * 4 + 2] = std::min(minOut[c], maxOut[c]);
+            stage.mtx[c * 4 + 3] = std::max(minOut[c], maxOut[c]);
+        }
+        m_stages.push_back(std::move(stage));
+        return LutErrorCode::LutState::OK;
+    }
+
+    LutErrorCode::LutState AddRange (const T minIn, const T maxIn, const T minOut, const T maxOut, const bool clamp = true)
+    {
+        return AddRange ({{ minIn, minIn, minIn }}, {{ maxIn, maxIn, maxIn }}, {{ minOut, minOut, minOut }}, {{ maxOut, maxOut, maxOut }}, clamp);
+    }
+
+    // per-channel 1D LUT: flat body with RGB triplet per entry (layout of Cube 1D LUT)
+    LutErrorCode::LutState AddLut1D
+    (
+        const LutElement::lutTable3D<T>& lutBody,
+        const LutElement::lutSize lutSize,
+        const LutElement::lutTableRaw<T>& domainMin = { T(0), T(0), T(0) },
+        const LutElement::lutTableRaw<T>& domainMax = { T(1), T(1), T(1) }
+    )
+    {
+        if (lutSize < 2u || lutBody.size() < lutSize * 3u)
+            return LutErrorCode::LutState::LutSizeInvalid;
+        if (3 != domainMin.size() || 3 != domainMax.size())
+            return LutErrorCode::LutState::IncorrectDimension;
+
+        Stage stage;
+        stage.type = StageType::Lut1D;
+        stage.lutSize = lutSize;
+        stage.body.assign(lutBody.cbegin(), lutBody.cbegin() + lutSize * 3u);
+        for (int c = 0; c < 3; c++)
+        {
+            if (domainMax[c] <= domainMin[c])
+                return LutErrorCode::LutState::DomainBoundReversed;
+            // normalized lattice coordinate: (in - min) * (size - 1) / (max - min)
+            stage.mtx[c * 4 + 0] = static_cast<T>(lutSize - 1) / (domainMax[c] - domainMin[c]);
+            stage.mtx[c * 4 + 1] = domainMin[c];
+        }
+        m_stages.push_back(std::move(stage));
+        return LutErrorCode::LutState::OK;
+    }
+
+    LutErrorCode::LutState AddLut1D (CCubeLut1D<T>& lut)
+    {
+        const auto domain = lut.getMinMaxDomain();
+        return AddLut1D (lut.get_data(), lut.getLutSize(), domain.first, domain.second);
+    }
+
+    // 3D LUT: flat body, red changes fastest (layout of Cube 3D LUT); LUT body copied into the chain.
+    // Unlike Lut1D stage, input not normalized by domain: domain treated as in Interpolator 3D kernels -
+    // input coordinate clipped to [0...1] and interpolated value clamped to [domainMin...domainMax].
+    // For 3D LUT with other input range add Range stage to [0...1] in front of it.
+    LutErrorCode::LutState AddLut3D
+    (
+        const LutElement::lutTable3D<T>& lutBody,
+        const LutElement::lutSize lutSize,
+        const LutElement::lutTableRaw<T>& domainMin = { T(0), T(0), T(0) },
+        const LutElement::lutTableRaw<T>& domainMax = { T(1), T(1), T(1) }
+    )
+    {
+        if (lutSize < 2u || lutBody.size() < lutSize * lutSize * lutSize * 3u)
+            return LutErrorCode::LutState::LutSizeInvalid;
+        if (3 != domainMin.size() || 3 != domainMax.size())
+            return LutErrorCode::LutState::IncorrectDimension;
+
+        Stage stage;
+        stage.type = StageType::Lut3D;
+        stage.lutSize = lutSize;
+        stage.body.assign(lutBody.cbegin(), lutBody.cbegin() + lutSize * lutSize * lutSize * 3u);
+        for (int c = 0; c < 3; c++)
+        {
+            stage.mtx[c * 4 + 2] = domainMin[c];
+            stage.mtx[c * 4 + 3] = domainMax[c];
+        }
+        m_stages.push_back(std::move(stage));
+        return LutErrorCode::LutState::OK;
+    }
+
+    LutErrorCode::LutState AddLut3D (CCubeLut3D<T>& lut)
+    {
+        const auto domain = lut.getMinMaxDomain();
+        return AddLut3D (static_cast<const CCubeLut3D<T>&>(lut).get_data(), lut.getLutSize(), domain.first, domain.second);
+    }
+
+
+    // apply chain on buffer of interleaved RGB pixels; src and dst may point to the same buffer
+    void Apply (const T* src, T* dst, const std::size_t pixels, const uint32_t threads = 0u) const
+    {
+        LutParallel::parallel_for (0u, pixels, chainTilePixels * 64u,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            {
+                ApplyRange (src + begin * 3u, dst + begin * 3u, end - begin);
+            },
+            threads);
+        return;
+    }
+
+    // apply chain on single RGB triplet
+    std::array<T, 3> Apply (const T r, const T g, const T b) const
+    {
+        std::array<T, 3> rgb {{ r, g, b }};
+        ApplyRange (rgb.data(), rgb.data(), 1u);
+        return rgb;
+    }
+
+
+private:
+    struct Stage
+    {
+        StageType type = StageType::Matrix;
+        // Matrix: 3x4 row-major [m00 m01 m02 o0 | m10 m11 m12 o1 | m20 m21 m22 o2]
+        // Range:  per channel   [scale offset clampMin clampMax]
+        // Lut1D:  per channel   [scale domainMin - -]
+        // Lut3D:  per channel   [- - domainMin domainMax]
+        std::array<T, 12> mtx {};
+        LutElement::lutSize lutSize = 0u;
+        LutElement::lutTable3D<T> body;
+    };
+
+    std::vector<Stage> m_stages;
+
+
+    void ApplyRange (const T* src, T* dst, const std::size_t pixels) const
+    {
+        T tile[chainTilePixels * 3u];
+
+        for (std::size_t p = 0; p < pixels; p += chainTilePixels)
+        {
+            const std::size_t n = std::min(chainTilePixels, pixels - p);
+            std::copy (src + p * 3u, src + (p + n) * 3u, tile);
+
+            for (const auto& stage : m_stages)
+            {
+                switch (stage.type)
+                {
+                    case StageType::Matrix: apply_matrix (stage, tile, n); break;
+                    case StageType::Range:  apply_range  (stage, tile, n); break;
+                    case StageType::Lut1D:  apply_lut1d  (stage, tile, n); break;
+                    case StageType::Lut3D:  apply_lut3d  (stage, tile, n); break;
+                }
+            }
+
+            std::copy (tile, tile + n * 3u, dst + p * 3u);
+        }
+        return;
+    }
+
+    static void apply_matrix (const Stage& s, T* tile, const std::size_t n) noexcept
+    {
+        const std::array<T, 12> m = s.mtx;
+        for (std::size_t i = 0; i < n; i++, tile += 3)
+        {
+            const T r = tile[0], g = tile[1], b = tile[2];
+            tile[0] = m[0] * r + m[1] * g + m[2]  * b + m[3];
+            tile[1] = m[4] * r + m[5] * g + m[6]  * b + m[7];
+            tile[2] = m[8] * r + m[9] * g + m[10] * b + m[11];
+        }
+        return;
+    }
+
+    static void apply_range (const Stage& s, T* tile, const std::size_t n) noexcept
+    {
+        const std::array<T, 12> m = s.mtx;
+        for (std::size_t i = 0; i < n; i++, tile += 3)
+        {
+            tile[0] = Interpolator::clip(tile[0] * m[0] + m[1], m[2],  m[3]);
+            tile[1] = Interpolator::clip(tile[1] * m[4] + m[5], m[6],  m[7]);
+            tile[2] = Interpolator::clip(tile[2] * m[8] + m[9], m[10], m[11]);
+        }
+        return;
+    }
+
+    static void apply_lut1d (const Stage& s, T* tile, const std::size_t n) noexcept
+    {
+        const T* body = s.body.data();
+        const int maxIdx = static_cast<int>(s.lutSize) - 1;
+        const T fMax = static_cast<T>(maxIdx);
+        for (std::size_t i = 0; i < n; i++, tile += 3)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                const T f  = Interpolator::clip((tile[c] - s.mtx[c * 4 + 1]) * s.mtx[c * 4 + 0], T(0), fMax);
+                const int i0 = std::min(static_cast<int>(f), maxIdx - 1);
+                const T t  = f - static_cast<T>(i0);
+                const T v0 = body[i0 * 3 + c];
+                const T v1 = body[i0 * 3 + 3 + c];
+                tile[c] = v0 + (v1 - v0) * t;
+            }
+        }
+        return;
+    }
+
+    static void apply_lut3d (const Stage& s, T* tile, const std::size_t n) noexcept
+    {
+        Interpolator::LatticeView<T> lut;
+        lut.data = s.body.data();
+        lut.lutSize = s.lutSize;
+        for (int c = 0; c < 3; c++)
+        {
+            lut.domainMin[c] = s.mtx[c * 4 + 2];
+            lut.domainMax[c] = s.mtx[c * 4 + 3];
+        }
+        Interpolator::tetrahedral_interpolation (lut, tile, tile, n);
+        return;
+    }
+
+}; // CTransformChain
+
+template <typename T, typename U>
+constexpr std::size_t CTransformChain<T, U>::chainTilePixels;
+
+} // namespace Lut
+
+#endif // __LUT_LIBRARY_TRANSFORM_CHAIN__
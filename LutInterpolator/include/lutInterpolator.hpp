@@ -4,5 +4,19 @@
 #include "algorithm.h"
 #include "compute_mode.h"
 #include "InterpolatorLinear.hpp"
+#include "InterpolatorTetrahedral.hpp"
+#include "InterpolatorBlend.hpp"
+#include "InterpolatorMulti.hpp"
+#include "InterpolatorNeutral.hpp"
+#include "InterpolatorSubCube.hpp"
+#include "InterpolatorImage.hpp"
+#include "InterpolatorYCbCr.hpp"
+#include "InterpolatorMasked.hpp"
+#include "InterpolatorStatistics.hpp"
+#include "InterpolatorColorCache.hpp"
+#include "InterpolatorScanline.hpp"
+#include "InterpolatorPreview.hpp"
+#include "TransformChain.hpp"
+#include "TemporalApplier.hpp"
 
 #endif // __LUT_LIBRARY_LUT_INTERPOLATOR_INTERFACE__
@@ -4,12 +4,22 @@
 #include "lutElement.h"
 #include "lutErrors.h"
 #include "string_view.h"
+#include "text_tokenizer.h"
+#include "mapped_file.h"
+#include "parallel_text.h"
+#include "lutLayout.h"
+#include "load_budget.h"
+#include "lutAsync.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <cctype>
 #include <cmath>
 #include <array>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
 
 template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr> 
 class CLut3DL
@@ -19,75 +29,148 @@ public:
     LutErrorCode::LutState getLastError(void) { return m_error; }
     LutElement::lutSize getLutSize(void) const { return m_lutSize; }
     LutElement::lutSize getLutComponentSize(const LutElement::LutComponent component) const { (void)component; return getLutSize(); }
+    // 3DL iterates blue fastest; body converted to canonical (red fastest) order on load
+    static constexpr LutElement::AxisOrder getNativeAxisOrder (void) noexcept { return LutElement::AxisOrder::BlueFastest; }
+
+    // resource limits applied to every following load (untrusted files); all limits disabled by default
+    void setLoadLimits (const LutLimits::LoadLimits& limits) noexcept { m_limits = limits; }
+    const LutLimits::LoadLimits& getLoadLimits (void) const noexcept { return m_limits; }
 
     LutErrorCode::LutState LoadFile(std::ifstream& lutFile)
     {
-        // clear file stream status
+        // clear file stream status and read complete file content
         lutFile.clear();
-        // cleanup internal objects before start parse file content
+        lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
+        const std::string content { std::istreambuf_iterator<char>(lutFile), std::istreambuf_iterator<char>() };
+        return LoadFromMemory (content.data(), content.size());
+    }
+
+
+    // parse 3DL comments and grid line only (LUT body not read): on success 'bodyOffset' receives offset of the first
+    // body row. LUT size taken from grid line, without grid line body rows counted. Output bit depth of integer body
+    // known only if declared in comments (0 otherwise), float body reported with zero bit depths.
+    LutErrorCode::LutState LoadHeader (const char* data, const std::size_t size, std::size_t& bodyOffset)
+    {
         _cleanup();
-        /* check line separator used in 3DL LUT file */
-        const char lineSeparator = getLineSeparator(lutFile);
-        if ('\0' == lineSeparator)
+        bodyOffset = size;
+        if (nullptr == data || 0u == size)
             return LutErrorCode::LutState::CouldNotParseTableData;
 
-        /* unconditional seek on start of file for start parsing */
-        lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
+        char separator = '\n';
+        const char* body = read_header (data, size, separator);
+        bodyOffset = static_cast<std::size_t>(body - data);
+        const std::size_t bodyBytes = size - bodyOffset;
+        if (m_gridLine.size() > LutElement::lut3DMaxSize)
+            return LutErrorCode::LutState::LutSizeOutOfRange;
 
-        std::string stringBuffer, keyword;
+        std::size_t entries = m_gridLine.size() * m_gridLine.size() * m_gridLine.size();
+        if (0u == entries)
+        {
+            LutText::CTextTokenizer text (body, bodyBytes, separator);
+            string_view line;
+            while (text.next_line (line))
+            {
+                line = LutText::trim (line);
+                if (0u != line.size() && LutText::is_number_start (line[0]))
+                    entries++;
+            }
+        }
+        m_lutSize = static_cast<size_t>(std::round(std::cbrt(static_cast<double>(entries))));
+        if (0u == entries || m_lutSize * m_lutSize * m_lutSize != entries)
+        {
+            m_lutSize = 0u;
+            return LutErrorCode::LutState::LutSizeInvalid;
+        }
 
-        LutErrorCode::LutState loadStatus = LutErrorCode::LutState::OK;
-        bool bGridLine = false;
+        m_bIntegerBody = is_integer_row (body, bodyBytes);
+        if (true == m_bIntegerBody)
+        {
+            const T gridMax = (0u != m_gridLine.size() ? *std::max_element (m_gridLine.begin(), m_gridLine.end()) : static_cast<T>(0));
+            const uint32_t inBits = comment_bit_depth ("INPUT RANGE:");
+            m_inBits  = (0u != inBits ? inBits : (static_cast<T>(0) != gridMax ? bits_for_value (static_cast<double>(gridMax)) : 0u));
+            m_outBits = comment_bit_depth ("OUTPUT RANGE:");
+            m_rangeIn  = (0u != m_inBits  ? static_cast<T>((1u << m_inBits)  - 1u) : static_cast<T>(0));
+            m_rangeOut = (0u != m_outBits ? static_cast<T>((1u << m_outBits) - 1u) : static_cast<T>(0));
+        }
+        else
+            set_bit_depth();
+        return LutErrorCode::LutState::OK;
+    }
 
-        do {
-            stringBuffer.clear();
 
-            if (LutErrorCode::LutState::OK == (loadStatus = ReadLine (lutFile, stringBuffer, lineSeparator)))
-            {
-                keyword.clear();
-                std::istringstream line(stringBuffer);
-                line >> keyword;
+    // parse 3DL LUT from text buffer (buffer not required after return)
+    LutErrorCode::LutState LoadFromMemory (const char* data, const std::size_t size)
+    {
+        const LutLimits::CLoadBudget budget (m_limits);
+        return LoadFromMemory (data, size, budget);
+    }
 
-                if (std::isdigit(static_cast<unsigned char>(keyword[0])) || '-' == keyword[0] || '.' == keyword[0])
-                {
-                    //  we read digits or numerical sign
-                    if (true == bGridLine)
-                    {
-                        const std::array<T, 3> rowVal = ParseTableRow(stringBuffer);
-                        m_lutBody.insert(m_lutBody.end(), rowVal.begin(), rowVal.end());
-                    }
-                    else
-                    {
-                        // check if we reed Grid Line or Lut Body
-                        if (true == _containsMoreThanThreeNumbers(stringBuffer))
-                            fillGridLine (stringBuffer);
-                        else // possible GridLine not mandatory - so let's switch to parse LUT Body 
-                        {
-                            const std::array<T, 3> rowVal = ParseTableRow(stringBuffer);
-                            m_lutBody.insert(m_lutBody.end(), rowVal.begin(), rowVal.end());
-                        }
-                        // grid line must precede LUT body; if missing, jump directly to LUT body parsing. 
-                        bGridLine = true;
-                    } // if (true == bGridLine)
-
-                } // if (std::isdigit(static_cast<unsigned char>(keyword[0])) || keyword[0] == '-' || keyword[0] == '.')
-
-            } // if (LutErrorCode::LutState::OK == (loadStatus = ReadLine (lutFile, stringBuffer, lineSeparator)))
-
-        } while (loadStatus == LutErrorCode::LutState::OK);
-
-        const size_t bodySize = m_lutBody.size();
+    // parse 3DL LUT from text buffer with budget of caller: limits, deadline, cancellation and progress
+    LutErrorCode::LutState LoadFromMemory (const char* data, const std::size_t size, const LutLimits::CLoadBudget& budget)
+    {
+        // cleanup internal objects before start parse buffer content
+        _cleanup();
+        if (nullptr == data || 0u == size)
+            return LutErrorCode::LutState::CouldNotParseTableData;
+
+        if (false == budget.input_allowed (size))
+            return (m_error = LutErrorCode::LutState::ResourceLimitExceeded);
+
+        char separator = '\n';
+        const char* body = read_header (data, size, separator);
+
+        // grid line defines LUT size before body parsed; without grid line number of parsed rows limited by budget
+        const std::size_t gridSize = m_gridLine.size();
+        const std::size_t maxRows  = budget.max_lattice_points (3u * sizeof(T));
+        if (gridSize > LutElement::lut3DMaxSize)
+            return (m_error = LutErrorCode::LutState::LutSizeOutOfRange);
+        if (gridSize * gridSize * gridSize > maxRows)
+            return (m_error = LutErrorCode::LutState::ResourceLimitExceeded);
+
+        // LUT body: numerical rows parsed in parallel, number of rows defines LUT size. Integer code values
+        // (first row contains only unsigned integers) parsed directly to uint16, float parsing used otherwise
+        const std::size_t bodyBytes = static_cast<std::size_t>(data + size - body);
+        auto const is_number_row = [](const string_view& row) { return LutText::is_number_start (row[0]); };
+        LutText::RowsParseResult rows;
+        budget.start_progress (bodyBytes);
+        if (true == is_integer_row (body, bodyBytes))
+        {
+            rows = LutText::parse_rows (body, bodyBytes, separator, maxRows, 3u, m_lutBodyNative, is_number_row, 0u, &budget);
+            m_bIntegerBody = rows.ok();
+        }
+        if (false == m_bIntegerBody && false == rows.stopped)
+        {
+            m_lutBodyNative.clear();
+            budget.start_progress (bodyBytes);
+            rows = LutText::parse_rows (body, bodyBytes, separator, maxRows, 3u, m_lutBody, is_number_row, 0u, &budget);
+        }
+        else if (false == m_bNativeStorageOnly)
+            m_lutBody.assign (m_lutBodyNative.begin(), m_lutBodyNative.end());
+        const bool bParseError = !rows.ok();
+        set_bit_depth();
+
+        const size_t bodySize = rows.parsed * 3ull;
         const size_t entries  = bodySize / 3ull;
-        const size_t gridSize = m_gridLine.size();
-        m_lutSize = static_cast<size_t>(std::cbrt(static_cast<T>(entries)));
-        if (0ull != gridSize && gridSize != m_lutSize)
+        m_lutSize = static_cast<size_t>(std::round(std::cbrt(static_cast<double>(entries))));
+        if (true == rows.stopped || rows.rows > maxRows)
+        {
+            m_lutSize = 0u;
+            m_error = (true == rows.stopped ? LutAsync::stop_reason (budget) : LutErrorCode::LutState::ResourceLimitExceeded);
+        }
+        else if (true == bParseError || 0ull == entries || m_lutSize * m_lutSize * m_lutSize != entries)
+            m_error = LutErrorCode::LutState::CouldNotParseTableData;
+        else if (0ull != gridSize && gridSize != m_lutSize)
         { 
             std::cout << "Lut size not match to Lut Grid size!!!" << std::endl;
             std::cout << "Grid size = " << gridSize << " Lut size = " << m_lutSize << " [Body size = " << bodySize << "]" << std::endl;
             m_error = LutErrorCode::LutState::CouldNotParseTableData;
         } 
         else   
-            m_error = LutErrorCode::LutState::OK;         
+        {
+            LutLayout::normalize_axis_order (m_lutBody, m_lutSize, getNativeAxisOrder());
+            LutLayout::normalize_axis_order (m_lutBodyNative, m_lutSize, getNativeAxisOrder());
+            m_error = LutErrorCode::LutState::OK;
+        }
  
         return m_error;
     }
@@ -95,21 +178,7 @@ public:
 
     LutErrorCode::LutState LoadFile(const string_view& lutFileName)
     {
-        LutErrorCode::LutState err = LutErrorCode::LutState::OK;
-        if (!lutFileName.empty() && lutFileName != m_lutName)
-        {
-            std::ifstream file3DL{ lutFileName };
-            if (!file3DL.good())
-                return LutErrorCode::LutState::FileNotOpened;
-
-            err = LoadFile(file3DL);
-            file3DL.close();
-
-            if (LutErrorCode::LutState::OK == err)
-            m_lutName = lutFileName;
-         }
-         m_error = err;
-         return err;
+        return LoadFile (std::string (lutFileName.begin(), lutFileName.end()));
     }
 
     LutErrorCode::LutState LoadFile (const char* lutFileName)
@@ -119,16 +188,27 @@ public:
 
 
     LutErrorCode::LutState LoadFile(const std::string& lutFileName)
+    {
+        const LutLimits::CLoadBudget budget (m_limits);
+        return LoadFile (lutFileName, budget);
+    }
+
+    // load file on library I/O pool (see lutAsync.h): progress reported as bytes of LUT body parsed
+    LutAsync::CLoadHandle LoadFileAsync (const std::string& lutFileName, LutLimits::ProgressCallback progress = nullptr)
+    {
+        return LutAsync::launch (m_limits, [this, lutFileName](const LutLimits::CLoadBudget& budget) { return LoadFile (lutFileName, budget); }, std::move (progress));
+    }
+
+    LutErrorCode::LutState LoadFile(const std::string& lutFileName, const LutLimits::CLoadBudget& budget)
     {
         LutErrorCode::LutState err = LutErrorCode::LutState::OK;
         if (!lutFileName.empty() && lutFileName != m_lutName)
         {
-            std::ifstream file3DL{ lutFileName };
+            const LutText::CMappedFile file3DL { lutFileName };
             if (!file3DL.good())
                 return LutErrorCode::LutState::FileNotOpened;
 
-            err = LoadFile(file3DL);
-            file3DL.close();
+            err = LoadFromMemory (file3DL.data(), file3DL.size(), budget);
 
             if (LutErrorCode::LutState::OK == err)
                 m_lutName = lutFileName;
@@ -170,8 +250,30 @@ public:
     const LutElement::lutTable3D<T>& get_data(void) const noexcept { return m_lutBody; }
 
 
+    // maximal input (grid) and output (body) code values, e.g. 1023 and 4095 for 10 bits to 12 bits LUT
     const std::pair<T, T> get_inout_range(void) const { return std::make_pair(m_rangeIn, m_rangeOut); }
 
+    // bit depth of input/output code values; 0 for LUT with floating point body
+    uint32_t getInputBitDepth  (void) const noexcept { return m_inBits; }
+    uint32_t getOutputBitDepth (void) const noexcept { return m_outBits; }
+
+    // integer LUT body stored as parsed code values: normalized value = code * get_native_scale()
+    bool isIntegerBody (void) const noexcept { return m_bIntegerBody; }
+    const LutElement::lutTable3D<uint16_t>& get_native_data (void) const noexcept { return m_lutBodyNative; }
+    T get_native_scale (void) const noexcept { return (static_cast<T>(0) != m_rangeOut ? static_cast<T>(1) / m_rangeOut : static_cast<T>(1)); }
+
+    // integer LUT bodies kept only in native uint16 form (get_data() empty), applied on next load
+    void setNativeStorageOnly (const bool bNativeOnly) noexcept { m_bNativeStorageOnly = bNativeOnly; }
+
+    // smallest of usual bit depths (8, 10, 12, 14, 16) able to hold code value
+    static uint32_t bits_for_value (const double maxValue) noexcept
+    {
+        uint32_t bits = 8u;
+        while (bits < 16u && maxValue > static_cast<double>((1u << bits) - 1u))
+            bits += 2u;
+        return bits;
+    }
+
 
 private:
     LutElement::lutTable3D<T> m_lutBody;
@@ -186,6 +288,13 @@ private:
     T m_rangeIn;
     T m_rangeOut;
 
+    LutElement::lutTable3D<uint16_t> m_lutBodyNative;
+    uint32_t m_inBits  = 0u;
+    uint32_t m_outBits = 0u;
+    bool m_bIntegerBody = false;
+    bool m_bNativeStorageOnly = false;
+    LutLimits::LoadLimits m_limits;
+
     static constexpr char symbNewLine        = '\n';
     static constexpr char symbCarriageReturn = '\r';
     static constexpr char symbCommentMarker  = '#';
@@ -202,111 +311,126 @@ private:
        m_gridLine.clear();
        m_nativeComments.clear();
        m_rangeIn = m_rangeOut = static_cast<T>(0);
+       m_lutBodyNative.clear();
+       m_inBits = m_outBits = 0u;
+       m_bIntegerBody = false;
        m_error = LutErrorCode::LutState::NotInitialized;
        return;
     }
 
 
-    bool _containsMoreThanThreeNumbers (const std::string& line)
+    // header: comments, keywords and optional grid line; first numerical row without grid line marks begin of LUT body
+    const char* read_header (const char* data, const std::size_t size, char& separator)
     {
-        std::stringstream ss(line);
-        std::string temp_token;
-        int count = 0;
+        LutText::CTextTokenizer text (data, size);
+        string_view line, keyword;
+        const char* body = data + size;
+        bool bGridLine = false;
 
-        // Count the numbers, stopping as soon as we find the 4th one.
-        while (ss >> temp_token)
+        while (LutErrorCode::LutState::OK == ReadLine (text, line))
         {
-            count++;
-            if (count > 3)
-                return true;
+            string_view args = line;
+            LutText::next_token (args, keyword);
+
+            if (LutText::is_number_start(keyword[0]))
+            {
+                if (false == bGridLine && LutText::count_tokens(line, 4u) > 3u)
+                {
+                    fillGridLine (line);
+                    bGridLine = true;
+                }
+                else
+                {
+                    body = line.data();
+                    break;
+                }
+            }
         }
-        return false;
+        separator = text.separator();
+        return body;
     }
 
 
-    void fillGridLine (const std::string& line)
+    // not more than lut3DMaxSize + 1 values read: longer grid line (or body without line breaks) rejected by size check
+    void fillGridLine (string_view line)
     {
-        std::istringstream data_line (line);
         m_gridLine.clear();
-        while (true)
-        {
-            T value{};
-            data_line >> value;
-            if (data_line.fail())
-                break;
+        string_view token;
+        T value{};
+        while (m_gridLine.size() <= LutElement::lut3DMaxSize && LutText::next_token (line, token) && LutText::parse_number (token, value))
             m_gridLine.push_back(value);
-        }
-
         return;
     }
 
 
-    char getLineSeparator (std::ifstream& lutFile)
+    // first row of LUT body contains only unsigned integer values
+    static bool is_integer_row (const char* body, const std::size_t size)
     {
-        char lineSeparator{ '\0' };
-        for (int32_t i = 0; i < 1024; i++)
-        {
-            auto c = lutFile.get();
-            if (c == static_cast<decltype(c)>(symbNewLine))
-            {
-                lineSeparator = symbNewLine;
-                break;
-            }
-
-            if (c == static_cast<decltype(c)>(symbCarriageReturn))
-            {
-                if (symbCarriageReturn == lutFile.get())
-                    break;
-
-                lineSeparator = symbCarriageReturn;
-                std::cout << "This file uses non - complient line separator \\r(0x0D)" << std::endl;
-                break;
-            } // if (c == static_cast<decltype(c)>(symbCarriageReturn))
-
-        }// for (int32_t i = 0; i < 1024; i++)
-
-        return lineSeparator;
-    } // char getLineSeparator (std::ifstream& lutFile)
+        LutText::CTextTokenizer text (body, size);
+        string_view line, token;
+        if (false == text.next_line (line))
+            return false;
+        std::size_t tokens = 0u;
+        uint16_t value = 0u;
+        for (; LutText::next_token (line, token); tokens++)
+            if (false == LutText::parse_number (token, value))
+                return false;
+        return (0u != tokens);
+    }
 
+    // bit depth declared in comments, e.g. "# INPUT RANGE: 10" (LUTCalc); 0 if not declared
+    uint32_t comment_bit_depth (const char* key) const
+    {
+        const std::size_t pos = m_nativeComments.find (key);
+        if (std::string::npos == pos)
+            return 0u;
+        string_view rest (m_nativeComments.data() + pos + std::strlen(key), m_nativeComments.size() - pos - std::strlen(key));
+        string_view token;
+        uint32_t bits = 0u;
+        if (!LutText::next_token (rest, token) || !LutText::parse_integer (token, bits) || bits < 1u || bits > 16u)
+            return 0u;
+        return bits;
+    }
 
-    LutErrorCode::LutState ReadLine (std::ifstream& lutFile, std::string& strBuffer, const char& lineSeparator)
+    // input range from grid line, output range from LUT body; integer bit depths from comments or from maximal values
+    void set_bit_depth (void)
     {
-        while (0u == strBuffer.size() || symbCommentMarker == strBuffer[0])
+        const T gridMax = (0u != m_gridLine.size() ? *std::max_element (m_gridLine.begin(), m_gridLine.end()) : static_cast<T>(0));
+        if (true == m_bIntegerBody)
         {
-            if (lutFile.eof())
-                return LutErrorCode::LutState::PrematureEndOfFile;
-
-            std::getline(lutFile, strBuffer, lineSeparator);
-            if (lutFile.fail())
-                return LutErrorCode::LutState::ReadError;
-
-            if (symbCommentMarker == strBuffer[0])
-            {
-                m_nativeComments += strBuffer;
-                m_nativeComments += symbNewLine;
-            }
+            const uint16_t bodyMax = (0u != m_lutBodyNative.size() ? *std::max_element (m_lutBodyNative.begin(), m_lutBodyNative.end()) : 0u);
+            const uint32_t inBits  = comment_bit_depth ("INPUT RANGE:");
+            const uint32_t outBits = comment_bit_depth ("OUTPUT RANGE:");
+            m_inBits  = (0u != inBits  ? inBits  : bits_for_value (static_cast<double>(0 != gridMax ? gridMax : static_cast<T>(bodyMax))));
+            m_outBits = (0u != outBits ? outBits : bits_for_value (static_cast<double>(bodyMax)));
+            m_rangeIn  = static_cast<T>((1u << m_inBits)  - 1u);
+            m_rangeOut = static_cast<T>((1u << m_outBits) - 1u);
         }
-        return LutErrorCode::LutState::OK;
-    } // LutErrorCode::LutState ReadLine(std::ifstream& lutFile, std::string& strBuffer, const char& lineSeparator)
-
+        else
+        {
+            m_rangeIn  = gridMax;
+            m_rangeOut = static_cast<T>(1);
+        }
+        return;
+    }
 
-    const std::array<T, 3> ParseTableRow (const std::string& strBuffer)
+    // next line with content: empty lines skipped, comments collected
+    LutErrorCode::LutState ReadLine (LutText::CTextTokenizer& text, string_view& line)
     {
-        std::array<T, 3> lutRawData;
-        std::istringstream data_line (strBuffer);
-
-        for (int32_t i = 0; i < 3; i++)
+        while (text.next_line (line))
         {
-            data_line >> lutRawData[i];
-            if (data_line.fail())
+            if (0u != line.size() && symbCommentMarker == line[0])
             {
-                m_error = LutErrorCode::LutState::CouldNotParseTableData;
-                break;
+                m_nativeComments.append (line.data(), line.size());
+                m_nativeComments += symbNewLine;
+                continue;
             }
-        } // for (int32_t i = 0; i < 3; i++)
-
-        return lutRawData;
-    } // std::array<T, 3> ParseTableRow (const std::string& strBuffer)
+            line = LutText::trim (line);
+            if (0u != line.size())
+                return LutErrorCode::LutState::OK;
+        }
+        return LutErrorCode::LutState::PrematureEndOfFile;
+    } // LutErrorCode::LutState ReadLine (LutText::CTextTokenizer& text, string_view& line)
 
 };
 
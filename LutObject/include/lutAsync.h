@@ -0,0 +1,120 @@
+#ifndef __LUT_LIBRARY_LUT_ASYNC__
+#define __LUT_LIBRARY_LUT_ASYNC__
+
+#include "lutErrors.h"
+#include "load_budget.h"
+#include "io_pool.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <utility>
+
+/*
+   Asynchronous load of LUT files: LoadFileAsync of LUT classes posts load to library I/O pool and returns
+   CLoadHandle. Handle reports AsyncIoPended until load completed, then result of load. LUT object must not
+   be accessed or destroyed until load completed; exception thrown by loader rethrown from status()/wait().
+*/
+namespace LutAsync
+{
+    // state shared between handle and running load
+    struct CLoadControl
+    {
+        std::atomic<bool> cancel { false };
+        std::atomic<std::size_t> done  { 0u };
+        std::atomic<std::size_t> total { 0u };
+    };
+
+    class CLoadHandle
+    {
+    public:
+        CLoadHandle (void) = default;
+        CLoadHandle (std::shared_ptr<CLoadControl> control, std::shared_future<LutErrorCode::LutState> result)
+            : m_control (std::move (control)), m_result (std::move (result)) {}
+
+        bool valid (void) const noexcept { return m_result.valid(); }
+
+        // AsyncIoPended while load in progress, result of load after completion
+        LutErrorCode::LutState status (void) const
+        {
+            if (false == valid())
+                return LutErrorCode::LutState::NotInitialized;
+            return (std::future_status::ready == m_result.wait_for (std::chrono::seconds (0)) ? m_result.get() : LutErrorCode::LutState::AsyncIoPended);
+        }
+
+        // block till load completed
+        LutErrorCode::LutState wait (void) const
+        {
+            return (true == valid() ? m_result.get() : LutErrorCode::LutState::NotInitialized);
+        }
+
+        // block not longer than 'timeout': AsyncIoPended if load still in progress
+        template <typename Rep, typename Period>
+        LutErrorCode::LutState wait_for (const std::chrono::duration<Rep, Period>& timeout) const
+        {
+            if (false == valid())
+                return LutErrorCode::LutState::NotInitialized;
+            return (std::future_status::ready == m_result.wait_for (timeout) ? m_result.get() : LutErrorCode::LutState::AsyncIoPended);
+        }
+
+        // request stop of load: load completes with Cancelled status (or its own result if already completed)
+        void cancel (void) noexcept
+        {
+            if (nullptr != m_control)
+                m_control->cancel.store (true, std::memory_order_relaxed);
+            return;
+        }
+
+        // progress of current load phase as (done, total) bytes
+        std::pair<std::size_t, std::size_t> progress (void) const noexcept
+        {
+            if (nullptr == m_control)
+                return std::make_pair (static_cast<std::size_t>(0u), static_cast<std::size_t>(0u));
+            return std::make_pair (m_control->done.load (std::memory_order_relaxed), m_control->total.load (std::memory_order_relaxed));
+        }
+
+    private:
+        std::shared_ptr<CLoadControl> m_control;
+        std::shared_future<LutErrorCode::LutState> m_result;
+    };
+
+
+    // status of load stopped by budget
+    inline LutErrorCode::LutState stop_reason (const LutLimits::CLoadBudget& budget) noexcept
+    {
+        return (true == budget.cancelled() ? LutErrorCode::LutState::Cancelled : LutErrorCode::LutState::ResourceLimitExceeded);
+    }
+
+
+    // post load (callable taking budget and returning LutState) to I/O pool (library pool by default);
+    // load not started till pool destroyed completes with Cancelled status
+    template <typename F>
+    CLoadHandle launch (const LutLimits::LoadLimits& limits, F&& load, LutLimits::ProgressCallback progress = nullptr,
+                        LutParallel::CIoPool& pool = LutParallel::io_pool())
+    {
+        auto control = std::make_shared<CLoadControl>();
+        auto task = std::make_shared<std::packaged_task<LutErrorCode::LutState()>>(
+            [control, limits, load = std::forward<F>(load), progress = std::move (progress)]() mutable
+            {
+                if (true == control->cancel.load (std::memory_order_relaxed))
+                    return LutErrorCode::LutState::Cancelled;
+                const LutLimits::CLoadBudget budget (limits, &control->cancel,
+                    [&control, &progress](const std::size_t done, const std::size_t total)
+                    {
+                        control->total.store (total, std::memory_order_relaxed);
+                        control->done.store (done, std::memory_order_relaxed);
+                        if (progress)
+                            progress (done, total);
+                    });
+                return load (budget);
+            });
+
+        CLoadHandle handle (control, task->get_future().share());
+        pool.post ([task]() { (*task)(); },
+                   [task, control]() { control->cancel.store (true, std::memory_order_relaxed); (*task)(); });
+        return handle;
+    }
+
+} // namespace LutAsync
+
+#endif /* __LUT_LIBRARY_LUT_ASYNC__ */
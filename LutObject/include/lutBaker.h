@@ -0,0 +1,195 @@
+#ifndef __LUT_LIBRARY_LUT_BAKER__
+#define __LUT_LIBRARY_LUT_BAKER__
+
+#include "lutElement.h"
+#include "lutErrors.h"
+#include "lutCube1D.h"
+#include "lutCube3D.h"
+#include "parallel_for.h"
+#include <type_traits>
+#include <utility>
+#include <string>
+#include <array>
+
+/*
+   Generate (bake) LUT content directly from C++ callable, without text round-trip.
+
+   Two kinds of functors are accepted:
+     - point functor: result f (T r, T g, T b), where result supports operator[] for indexes 0...2
+       (std::array<T,3>, std::vector<T>, ...);
+     - block functor: void f (const T* rgbIn, T* rgbOut, size_t points), processes 'points' interleaved
+       RGB triplets at once; this is the preferable form for SIMD implementations. Output pointer
+       references LUT body itself, so block functor writes results in place.
+
+   Lattice is traversed in memory order of LUT body (red fastest, then green, then blue) and split on
+   contiguous parts processed by worker threads. Functor may be called concurrently from different
+   threads. Exception thrown by functor is rethrown to caller of Bake/Fill after all worker threads
+   stopped; LUT content is undefined in this case.
+   For 1D LUT the functor receives the same lattice index on all channels: f (x_r, x_g, x_b).
+*/
+namespace LutBaker
+{
+    // C++14 replacement of std::void_t
+    template <typename...> struct make_void { using type = void; };
+    template <typename... Ts> using void_t = typename make_void<Ts...>::type;
+
+    template <typename F, typename T, typename = void>
+    struct is_block_functor : std::false_type {};
+
+    template <typename F, typename T>
+    struct is_block_functor<F, T, void_t<decltype(std::declval<F&>()(std::declval<const T*>(), std::declval<T*>(), std::declval<size_t>()))>> : std::true_type {};
+
+    // number of lattice points handled by one functor call
+    constexpr size_t bakeBlockPoints = 256u;
+
+
+    template <typename T, typename F>
+    inline void bake_block (F& func, const T* rgbIn, T* rgbOut, const size_t points, std::true_type /* block functor */)
+    {
+        func (rgbIn, rgbOut, points);
+        return;
+    }
+
+    template <typename T, typename F>
+    inline void bake_block (F& func, const T* rgbIn, T* rgbOut, const size_t points, std::false_type /* point functor */)
+    {
+        for (size_t i = 0; i < points; i++, rgbIn += 3, rgbOut += 3)
+        {
+            const auto out = func (rgbIn[0], rgbIn[1], rgbIn[2]);
+            rgbOut[0] = static_cast<T>(out[0]);
+            rgbOut[1] = static_cast<T>(out[1]);
+            rgbOut[2] = static_cast<T>(out[2]);
+        }
+        return;
+    }
+
+
+    // fill lattice of 'lutSize' nodes per channel (dims = 1 for 1D LUT or dims = 3 for 3D LUT)
+    template <typename T, typename F>
+    void bake_lattice
+    (
+        T* lutBody,
+        const LutElement::lutSize lutSize,
+        const uint32_t dims,
+        const LutElement::lutTableRaw<T>& domainMin,
+        const LutElement::lutTableRaw<T>& domainMax,
+        F& func,
+        const uint32_t threads
+    )
+    {
+        // input coordinates of lattice nodes per channel: computed once and shared between threads
+        std::array<LutElement::lutTableRaw<T>, 3> grid;
+        const T divisor = static_cast<T>(lutSize - 1);
+        for (size_t c = 0; c < 3; c++)
+        {
+            grid[c].resize(lutSize);
+            for (LutElement::lutSize i = 0; i < lutSize; i++)
+                grid[c][i] = domainMin[c] + (domainMax[c] - domainMin[c]) * static_cast<T>(i) / divisor;
+        }
+
+        const LutElement::lutSize totalPoints = (3u == dims ? lutSize * lutSize * lutSize : lutSize);
+        const auto isBlock = is_block_functor<F, T>{};
+
+        LutParallel::parallel_for (0u, totalPoints, bakeBlockPoints,
+            [&](const size_t begin, const size_t end, const uint32_t)
+            {
+                std::array<T, bakeBlockPoints * 3> rgbIn;
+
+                // lattice indexes of first point in chunk
+                size_t r = begin % lutSize;
+                size_t g = (3u == dims ? (begin / lutSize) % lutSize : r);
+                size_t b = (3u == dims ? begin / (lutSize * lutSize) : r);
+
+                for (size_t p = begin; p < end; p += bakeBlockPoints)
+                {
+                    const size_t points = std::min(bakeBlockPoints, end - p);
+                    for (size_t i = 0; i < points; i++)
+                    {
+                        rgbIn[i * 3 + 0] = grid[0][r];
+                        rgbIn[i * 3 + 1] = grid[1][g];
+                        rgbIn[i * 3 + 2] = grid[2][b];
+
+                        if (3u == dims)
+                        {
+                            if (++r == lutSize)
+                            {
+                                r = 0u;
+                                if (++g == lutSize)
+                                    g = 0u, b++;
+                            }
+                        }
+                        else
+                            g = b = ++r;
+                    }
+                    bake_block (func, rgbIn.data(), lutBody + p * 3, points, isBlock);
+                }
+            },
+            threads);
+
+        return;
+    }
+
+
+    // fill already created 3D LUT (see CCubeLut3D::CreateLut) using its size and domain
+    template <typename T, typename F>
+    LutErrorCode::LutState Fill (CCubeLut3D<T>& lut, F&& func, const uint32_t threads = 0u)
+    {
+        const LutElement::lutSize lutSize = lut.getLutSize();
+        if (0u == lutSize || lut.get_data().size() != lutSize * lutSize * lutSize * 3u)
+            return LutErrorCode::LutState::NotInitialized;
+
+        const auto domain = lut.getMinMaxDomain();
+        bake_lattice (lut.get_data().data(), lutSize, 3u, domain.first, domain.second, func, threads);
+        return LutErrorCode::LutState::OK;
+    }
+
+    // fill already created 1D LUT (see CCubeLut1D::CreateLut) using its size and domain
+    template <typename T, typename F>
+    LutErrorCode::LutState Fill (CCubeLut1D<T>& lut, F&& func, const uint32_t threads = 0u)
+    {
+        const LutElement::lutSize lutSize = lut.getLutSize();
+        if (0u == lutSize || lut.get_data().size() != lutSize * 3u)
+            return LutErrorCode::LutState::NotInitialized;
+
+        const auto domain = lut.getMinMaxDomain();
+        bake_lattice (lut.get_data().data(), lutSize, 1u, domain.first, domain.second, func, threads);
+        return LutErrorCode::LutState::OK;
+    }
+
+
+    // create LUT with defined size (default domain [0...1]) and fill it from functor
+    template <typename LutObject, typename F>
+    LutErrorCode::LutState Bake (LutObject& lut, const LutElement::lutSize lutSize, F&& func, const uint32_t threads = 0u)
+    {
+        const LutErrorCode::LutState err = lut.CreateLut (lutSize);
+        return (LutErrorCode::LutState::OK == err ? Fill (lut, std::forward<F>(func), threads) : err);
+    }
+
+    // create LUT with defined size and domain and fill it from functor
+    template <typename LutObject, typename T, typename F>
+    LutErrorCode::LutState Bake
+    (
+        LutObject& lut,
+        const LutElement::lutSize lutSize,
+        const LutElement::lutTableRaw<T>& domainMin,
+        const LutElement::lutTableRaw<T>& domainMax,
+        F&& func,
+        const uint32_t threads = 0u
+    )
+    {
+        const LutErrorCode::LutState err = lut.CreateLut (lutSize, domainMin, domainMax);
+        return (LutErrorCode::LutState::OK == err ? Fill (lut, std::forward<F>(func), threads) : err);
+    }
+
+    // bake LUT and save it directly in format of LutObject (CCubeLut3D<T>, CCubeLut1D<T>, ...)
+    template <typename LutObject, typename F>
+    LutErrorCode::LutState BakeToFile (const std::string& fileName, const LutElement::lutSize lutSize, F&& func, const uint32_t threads = 0u)
+    {
+        LutObject lut;
+        const LutErrorCode::LutState err = Bake (lut, lutSize, std::forward<F>(func), threads);
+        return (LutErrorCode::LutState::OK == err ? lut.SaveFile (fileName) : err);
+    }
+
+} // namespace LutBaker
+
+#endif // __LUT_LIBRARY_LUT_BAKER__
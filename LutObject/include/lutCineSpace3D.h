@@ -4,9 +4,20 @@
 #include "lutElement.h"
 #include "lutErrors.h"
 #include "string_view.h"
+#include "text_tokenizer.h"
+#include "mapped_file.h"
+#include "parallel_text.h"
+#include "load_budget.h"
+#include "lutAsync.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 
 template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr> 
@@ -17,35 +28,96 @@ class CCineSpaceLut3D
 	LutErrorCode::LutState getLastError  (void)         { return m_error; }
 	LutElement::lutSize getLutSize (void)               { return m_lutSize; }
 	LutElement::lutSize getLutComponentSize (const LutElement::LutComponent component) {return m_lutComponentSize[static_cast<uint32_t>(component)];}
+	static constexpr LutElement::AxisOrder getNativeAxisOrder (void) noexcept { return LutElement::AxisOrder::RedFastest; }
+	/* content of metadata block, lines joined by space */
+	LutElement::lutTitle const getTitle (void) const { return m_title; }
+
+	/* pre-LUT of component as (input, output) values: empty if file has no pre-LUT */
+	const std::pair<std::vector<T>, std::vector<T>> getPreLut (const LutElement::LutComponent component) const
+	{
+		switch (component)
+		{
+			case LutElement::LutComponent::Red:   return std::make_pair (m_preLut_R_in, m_preLut_R_out);
+			case LutElement::LutComponent::Green: return std::make_pair (m_preLut_G_in, m_preLut_G_out);
+			default:                              return std::make_pair (m_preLut_B_in, m_preLut_B_out);
+		}
+	}
+
+	/* true if pre-LUT of every component maps its input range linearly onto [0...1] (or file has no pre-LUT):
+	   such pre-LUT is equal to input domain of LUT (see getPreLutDomain) */
+	bool isLinearPreLut (const T tolerance = static_cast<T>(1e-5)) const
+	{
+		const std::vector<T>* preLut[3][2] = { { &m_preLut_R_in, &m_preLut_R_out }, { &m_preLut_G_in, &m_preLut_G_out }, { &m_preLut_B_in, &m_preLut_B_out } };
+		for (uint32_t c = 0u; c < 3u; c++)
+		{
+			const std::vector<T>& in  = *preLut[c][0];
+			const std::vector<T>& out = *preLut[c][1];
+			if (true == in.empty())
+				continue;
+			if (in.size() < 2u || in.back() <= in.front())
+				return false;
+			const T range = in.back() - in.front();
+			for (std::size_t i = 0u; i < in.size(); i++)
+				if (std::abs (out[i] - (in[i] - in.front()) / range) > tolerance)
+					return false;
+		}
+		return true;
+	}
+
+	/* input domain: range of pre-LUT input values, [0...1] if file has no pre-LUT */
+	const std::pair<LutElement::lutTableRaw<T>, LutElement::lutTableRaw<T>> getPreLutDomain (void) const
+	{
+		LutElement::lutTableRaw<T> domainMin (3, static_cast<T>(0)), domainMax (3, static_cast<T>(1));
+		const std::vector<T>* preLutIn[3] = { &m_preLut_R_in, &m_preLut_G_in, &m_preLut_B_in };
+		for (uint32_t c = 0u; c < 3u; c++)
+		{
+			if (false == preLutIn[c]->empty())
+			{
+				domainMin[c] = preLutIn[c]->front();
+				domainMax[c] = preLutIn[c]->back();
+			}
+		}
+		return std::make_pair (domainMin, domainMax);
+	}
+
+	/* resource limits applied to every following load (untrusted files); all limits disabled by default */
+	void setLoadLimits (const LutLimits::LoadLimits& limits) noexcept { m_limits = limits; }
+	const LutLimits::LoadLimits& getLoadLimits (void) const noexcept { return m_limits; }
 	
 	LutErrorCode::LutState LoadFile (std::ifstream& lutFile)
 	{
-        bool bValid = true;
-		// clear file stream status
+		// clear file stream status and read complete file content
 		lutFile.clear();
+		lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
+		const std::string content { std::istreambuf_iterator<char>(lutFile), std::istreambuf_iterator<char>() };
+		return LoadFromMemory (content.data(), content.size());
+	}
+
+	/* parse CSP 3D LUT markers, metadata, pre-LUT and size line only (LUT body not read): on success 'bodyOffset'
+	   receives offset of the line following LUT size line */
+	LutErrorCode::LutState LoadHeader (const char* data, const std::size_t size, std::size_t& bodyOffset)
+	{
 		/* cleanup internal objects before parsing */
 		_cleanup();
-		/* check line separator used in 3D CUBE file */
-		const char lineSeparator = getLineSeparator(lutFile);
-		if ('\0' == lineSeparator)
+		bodyOffset = size;
+		if (nullptr == data || 0u == size)
 			return LutErrorCode::LutState::CouldNotParseTableData;
 
-		lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
+		LutText::CTextTokenizer text (data, size);
 		LutErrorCode::LutState loadStatus = LutErrorCode::LutState::OK;
-		std::string stringBuffer;
+		string_view line;
 		bool bMarkerFound = false;
 		/* read first line - "CSPLUTV100" value mandatory */
-		if (LutErrorCode::LutState::OK == (loadStatus = ReadLine (lutFile, stringBuffer, lineSeparator)))
+		if (LutErrorCode::LutState::OK == (loadStatus = ReadLine (text, line)))
 		{
-			if ("CSPLUTV100" == stringBuffer) /* CSP LUT marker detected */
+			if ("CSPLUTV100" == line) /* CSP LUT marker detected */
 			{
 				/* read LUT dimension "3D" value mandatory */
-				stringBuffer.clear();
-				if (LutErrorCode::LutState::OK == (loadStatus = ReadLine (lutFile, stringBuffer, lineSeparator)))
+				if (LutErrorCode::LutState::OK == (loadStatus = ReadLine (text, line)))
 				{
-					if ("3D" == stringBuffer)
+					if ("3D" == line)
 						bMarkerFound = true;
-					else if ("1D" == stringBuffer)
+					else if ("1D" == line)
 						loadStatus = LutErrorCode::LutState::IncorrectDimension;
 					else
 						loadStatus = LutErrorCode::LutState::UnknownOrRepeatedKeyword;	
@@ -57,81 +129,91 @@ class CCineSpaceLut3D
 		
 		if (false == bMarkerFound) return loadStatus;
 		/* CSP markers found - continue parse ... */
-		bool bMetaData = false;
-		stringBuffer.clear();
-		loadStatus = ReadLine(lutFile, stringBuffer, lineSeparator);
-		if (LutErrorCode::LutState::OK == loadStatus && "BEGIN METADATA" == stringBuffer)
+		loadStatus = ReadLine(text, line);
+		if (LutErrorCode::LutState::OK == loadStatus && "BEGIN METADATA" == line)
 		{
-			bMetaData = true;
-			/* we found metadata section. Just skeep it */
-			do {
-				stringBuffer.clear();
-				loadStatus = ReadLine (lutFile, stringBuffer, lineSeparator);
-			} while (LutErrorCode::LutState::OK == loadStatus && "END METADATA" != stringBuffer);
-		}
+			/* we found metadata section: keep it as LUT title */
+			while (LutErrorCode::LutState::OK == (loadStatus = ReadLine (text, line)) && "END METADATA" != line)
+			{
+				if (false == m_title.empty())
+					m_title += symbSpace;
+				m_title.append (line.data(), line.size());
+			}
 
-		if (true == bMetaData)
-		{
-			stringBuffer.clear();
-			loadStatus = ReadLine(lutFile, stringBuffer, lineSeparator);
+			if (LutErrorCode::LutState::OK == loadStatus)
+				loadStatus = ReadLine(text, line);
 		}
+
 		/* check if pre-LUT data available in CSP file */
-		if (LutErrorCode::LutState::OK == loadStatus && true == is_pre_lut(stringBuffer))
+		if (LutErrorCode::LutState::OK == loadStatus && true == is_pre_lut(line))
 		{
-			loadStatus = readPreLutData(lutFile, stringBuffer, lineSeparator);
-			stringBuffer.clear();
-			loadStatus = ReadLine(lutFile, stringBuffer, lineSeparator);
+			loadStatus = readPreLutData(text, line);
+			if (LutErrorCode::LutState::OK == loadStatus)
+				loadStatus = ReadLine(text, line);
 		}
 		
-		if (LutErrorCode::LutState::OK == loadStatus && 0u != stringBuffer.size())
+		if (LutErrorCode::LutState::OK == loadStatus)
 		{
 			/* read LUT body (channels dimension and LUT values itself */
-			std::istringstream lutDim (stringBuffer);
+			string_view token;
 			for (uint32_t i = 0u; i < 3u; i++)
-				lutDim >> m_lutComponentSize[i];
+				if (!LutText::next_token(line, token) || !LutText::parse_integer(token, m_lutComponentSize[i]))
+					m_lutComponentSize[i] = 0u;
 		}
 
 		if (0u != m_lutComponentSize[0] && 0u != m_lutComponentSize[1] && 0u != m_lutComponentSize[2])
 		{
-            // resize vectors holds LUT tables/
-			set_lut_size();
-			
-            // load LUT table from file/
-            const LutElement::lutSize lutLines = m_lutComponentSize[0] * m_lutComponentSize[1] * m_lutComponentSize[2];
-            for (LutElement::lutSize idx = 0; idx < lutLines && true == bValid; idx++)
-            {
-                stringBuffer.clear();
-                if (LutErrorCode::LutState::OK == (loadStatus = ReadLine(lutFile, stringBuffer, lineSeparator)))
-                {
-                    const std::array<T, 3> lutLineVal = ParseTableRow(stringBuffer);
-                    m_lutBody.insert(m_lutBody.end(), lutLineVal.cbegin(), lutLineVal.cend());
-                }
-                else
-                    bValid = false;
-            }
-
+			if (LutErrorCode::LutState::OK != set_lut_size())
+				return LutErrorCode::LutState::LutSizeOutOfRange;
+			bodyOffset = text.position();
 		} // if (0u != m_lutComponentSize[0] && 0u != m_lutComponentSize[1] && 0u != m_lutComponentSize[2])
 
-		return (true == bValid) ? LutErrorCode::LutState::OK : LutErrorCode::LutState::CouldNotParseTableData;
+		return LutErrorCode::LutState::OK;
 	}
-	
-	LutErrorCode::LutState LoadFile (const string_view& lutFileName)
+
+	/* parse CSP 3D LUT from text buffer (buffer not required after return) */
+	LutErrorCode::LutState LoadFromMemory (const char* data, const std::size_t size)
 	{
-		LutErrorCode::LutState err = LutErrorCode::LutState::OK;
-		if (!lutFileName.empty() && lutFileName != m_lutName)
+		const LutLimits::CLoadBudget budget (m_limits);
+		return LoadFromMemory (data, size, budget);
+	}
+
+	/* parse CSP 3D LUT from text buffer with budget of caller: limits, deadline, cancellation and progress */
+	LutErrorCode::LutState LoadFromMemory (const char* data, const std::size_t size, const LutLimits::CLoadBudget& budget)
+	{
+		bool bValid = true;
+		if (false == budget.input_allowed (size))
 		{
-			std::ifstream cspFile3D{ lutFileName };
-			if (!cspFile3D.good())
-				return LutErrorCode::LutState::FileNotOpened;
+			_cleanup();
+			return LutErrorCode::LutState::ResourceLimitExceeded;
+		}
 
-			err = LoadFile(cspFile3D);
-			cspFile3D.close();
+		std::size_t bodyOffset = 0u;
+		const LutErrorCode::LutState loadStatus = LoadHeader (data, size, bodyOffset);
+		if (LutErrorCode::LutState::OK != loadStatus)
+			return loadStatus;
 
-			if (LutErrorCode::LutState::OK == err)
-				m_lutName = lutFileName;
+		if (0u != m_lutSize)
+		{
+            // load LUT table from buffer: rows following the size line parsed in parallel. LUT body sized by parser
+            // from rows actually present, not from size declared in header
+            const LutElement::lutSize lutLines = m_lutComponentSize[0] * m_lutComponentSize[1] * m_lutComponentSize[2];
+            if (lutLines > budget.max_lattice_points (3u * sizeof(T)))
+                return LutErrorCode::LutState::ResourceLimitExceeded;
+            budget.start_progress (size - bodyOffset);
+            const auto rows = LutText::parse_rows (data + bodyOffset, size - bodyOffset, LutText::CTextTokenizer (data, size).separator(), lutLines, 3u, m_lutBody,
+                                                   [](const string_view&) { return true; }, 0u, &budget);
+            if (true == rows.stopped)
+                return LutAsync::stop_reason (budget);
+            bValid = (true == rows.ok() && lutLines == rows.parsed);
 		}
-		m_error = err;
-		return err;
+
+		return (true == bValid) ? LutErrorCode::LutState::OK : LutErrorCode::LutState::CouldNotParseTableData;
+	}
+	
+	LutErrorCode::LutState LoadFile (const string_view& lutFileName)
+	{
+		return LoadFile (std::string (lutFileName.begin(), lutFileName.end()));
 	}
 	
 	LutErrorCode::LutState LoadFile (const char* lutFileName)
@@ -140,16 +222,27 @@ class CCineSpaceLut3D
 	}
 
 	LutErrorCode::LutState LoadFile (const std::string& lutFileName)
+	{
+		const LutLimits::CLoadBudget budget (m_limits);
+		return LoadFile (lutFileName, budget);
+	}
+
+	/* load file on library I/O pool (see lutAsync.h): progress reported as bytes of LUT body parsed */
+	LutAsync::CLoadHandle LoadFileAsync (const std::string& lutFileName, LutLimits::ProgressCallback progress = nullptr)
+	{
+		return LutAsync::launch (m_limits, [this, lutFileName](const LutLimits::CLoadBudget& budget) { return LoadFile (lutFileName, budget); }, std::move (progress));
+	}
+
+	LutErrorCode::LutState LoadFile (const std::string& lutFileName, const LutLimits::CLoadBudget& budget)
 	{ 
 		LutErrorCode::LutState err = LutErrorCode::LutState::OK;
 		if (!lutFileName.empty() && lutFileName != m_lutName)
 		{
-			std::ifstream cspFile3D{ lutFileName };
+			const LutText::CMappedFile cspFile3D { lutFileName };
 			if (!cspFile3D.good())
 				return LutErrorCode::LutState::FileNotOpened;
 
-			err = LoadFile(cspFile3D);
-			cspFile3D.close();
+			err = LoadFromMemory (cspFile3D.data(), cspFile3D.size(), budget);
 
 			if (LutErrorCode::LutState::OK == err)
 				m_lutName = lutFileName;
@@ -178,10 +271,13 @@ class CCineSpaceLut3D
 		return LutErrorCode::LutState::NonImplemented;
 	}
 
+	const LutElement::lutTable3D<T>& get_data(void) const noexcept { return m_lutBody; }
+
 	
  private:
  	LutElement::lutTable3D<T> m_lutBody;
  	LutElement::lutFileName   m_lutName;
+	LutElement::lutTitle      m_title;
 	LutElement::lutSize       m_lutSize;
 	LutElement::lutSize       m_lutComponentSize[3];
 	LutErrorCode::LutState    m_error = LutErrorCode::LutState::NotInitialized;
@@ -196,6 +292,8 @@ class CCineSpaceLut3D
 	std::vector<T> m_preLut_G_out;
 	std::vector<T> m_preLut_B_in;
 	std::vector<T> m_preLut_B_out;
+
+	LutLimits::LoadLimits m_limits;
 	
 	const std::string str_LutDimType {"3D"};
 	static constexpr char symbNewLine        = '\n';
@@ -206,6 +304,7 @@ class CCineSpaceLut3D
 	{
 		m_lutBody.clear();
 		m_lutName.clear();
+		m_title.clear();
 		m_preLut_R_in.clear();
 		m_preLut_R_out.clear();
 		m_preLut_G_in.clear();
@@ -220,57 +319,50 @@ class CCineSpaceLut3D
 
 	LutErrorCode::LutState readPreLutData
 	(
-		std::ifstream& lutFile, 
-		std::string& strBuffer,
+		LutText::CTextTokenizer& text,
+		const string_view& sizeLine,
 		uint32_t& preLutSize,
 		std::vector<T>& in,
-		std::vector<T>& out,
-		const char& lineSeparator
-	) noexcept
+		std::vector<T>& out
+	)
 	{
-		LutErrorCode::LutState err1 = LutErrorCode::LutState::ReadError;
-		LutErrorCode::LutState err2 = LutErrorCode::LutState::ReadError;
-		std::istringstream line_size (strBuffer);
-		line_size >> preLutSize;
+		string_view token, line;
+		string_view sizeArgs = sizeLine;
+		if (!LutText::next_token(sizeArgs, token) || !LutText::parse_integer(token, preLutSize))
+			return LutErrorCode::LutState::ReadError;
+		/* each value takes at least one digit and one separator: pre-LUT size bounded by length of values line */
+		auto const fits_line = [preLutSize](const string_view& values) { return static_cast<std::size_t>(preLutSize) <= (values.size() + 1u) / 2u; };
+		if (LutErrorCode::LutState::OK != ReadLine(text, line) || !fits_line(line))
+			return LutErrorCode::LutState::ReadError;
 		in.resize (preLutSize);
+		if (preLutSize != LutText::parse_numbers(line, in.data(), preLutSize))
+			return LutErrorCode::LutState::ReadError;
+		if (LutErrorCode::LutState::OK != ReadLine(text, line) || !fits_line(line))
+			return LutErrorCode::LutState::ReadError;
 		out.resize(preLutSize);
-		strBuffer.clear();
-		if (LutErrorCode::LutState::OK == (err1 = ReadLine(lutFile, strBuffer, lineSeparator)))
-		{
-			std::istringstream inStr(strBuffer);
-			for (uint32_t i = 0u; i < preLutSize; i++)
-				inStr >> in[i];
-		}
-		strBuffer.clear();
-		if (LutErrorCode::LutState::OK == (err2 = ReadLine(lutFile, strBuffer, lineSeparator)))
-		{
-			std::istringstream outStr (strBuffer);
-			for (uint32_t i = 0u; i < preLutSize; i++)
-				outStr >> out[i];
-		}
-		return (LutErrorCode::LutState::OK == err1 && LutErrorCode::LutState::OK == err2 ? LutErrorCode::LutState::OK : LutErrorCode::LutState::ReadError);
+		if (preLutSize != LutText::parse_numbers(line, out.data(), preLutSize))
+			return LutErrorCode::LutState::ReadError;
+		return LutErrorCode::LutState::OK;
 	}
 
-	LutErrorCode::LutState readPreLutData (std::ifstream& lutFile, std::string& strBuffer, const char& lineSeparator)
+	LutErrorCode::LutState readPreLutData (LutText::CTextTokenizer& text, const string_view& rSizeLine)
 	{
-		const auto rReadErr = readPreLutData (lutFile, strBuffer, m_preLutR, m_preLut_R_in, m_preLut_R_out, lineSeparator);
-		strBuffer.clear();
-		const auto rl1 = ReadLine (lutFile, strBuffer, lineSeparator);
-		const auto gReadErr = readPreLutData (lutFile, strBuffer, m_preLutG, m_preLut_G_in, m_preLut_G_out, lineSeparator);
-		strBuffer.clear();
-		const auto rl2 = ReadLine (lutFile, strBuffer, lineSeparator);
-		const auto bReadErr = readPreLutData (lutFile, strBuffer, m_preLutB, m_preLut_B_in, m_preLut_B_out, lineSeparator);
-
-		return (LutErrorCode::LutState::OK == rReadErr && LutErrorCode::LutState::OK == gReadErr && LutErrorCode::LutState::OK == bReadErr &&
-			LutErrorCode::LutState::OK == rl1 && LutErrorCode::LutState::OK == rl2 ? LutErrorCode::LutState::OK : LutErrorCode::LutState::ReadError);
+		string_view line;
+		if (LutErrorCode::LutState::OK != readPreLutData (text, rSizeLine, m_preLutR, m_preLut_R_in, m_preLut_R_out) ||
+			LutErrorCode::LutState::OK != ReadLine (text, line) ||
+			LutErrorCode::LutState::OK != readPreLutData (text, line, m_preLutG, m_preLut_G_in, m_preLut_G_out) ||
+			LutErrorCode::LutState::OK != ReadLine (text, line) ||
+			LutErrorCode::LutState::OK != readPreLutData (text, line, m_preLutB, m_preLut_B_in, m_preLut_B_out))
+			return LutErrorCode::LutState::ReadError;
+		return LutErrorCode::LutState::OK;
 	}
 
 
-	bool is_pre_lut (const std::string& strBuffer)
+	bool is_pre_lut (const string_view& strBuffer)
 	{
 		bool one_digit = false;
 		auto const strBufSize = strBuffer.size();
-		for (auto i = 0ull; i < strBufSize; i++)
+		for (std::size_t i = 0u; i < strBufSize; i++)
 		{
 			if ('+' < strBuffer[i] && ':' > strBuffer[i])
 				one_digit = true;
@@ -283,75 +375,25 @@ class CCineSpaceLut3D
 		return one_digit;
 	}
 
-	LutErrorCode::LutState ReadLine (std::ifstream& lutFile, std::string& strBuffer, const char& lineSeparator)
+	/* next line with content: empty lines skipped */
+	LutErrorCode::LutState ReadLine (LutText::CTextTokenizer& text, string_view& line)
 	{
-		while (0u == strBuffer.size() || symbSpace == strBuffer[0])
+		while (text.next_line(line))
 		{
-			if (lutFile.eof())
-				return LutErrorCode::LutState::PrematureEndOfFile;
-
-			std::getline(lutFile, strBuffer, lineSeparator);
-			if (lutFile.fail())
-				return LutErrorCode::LutState::ReadError;
+			line = LutText::trim(line);
+			if (0u != line.size())
+				return LutErrorCode::LutState::OK;
 		}
-		return LutErrorCode::LutState::OK;
+		return LutErrorCode::LutState::PrematureEndOfFile;
 	}
 
-	char getLineSeparator (std::ifstream& lutFile)
-	{
-		char lineSeparator { '\0' };
-		for (int32_t i = 0; i < 256; i++)
-		{
-			auto c = lutFile.get();
-			if (c == static_cast<decltype(c)>(symbNewLine))
-			{
-				lineSeparator = symbNewLine;
-				break;
-			}
-
-			if (c == static_cast<decltype(c)>(symbCarriageReturn))
-			{
-				if (symbCarriageReturn == lutFile.get())
-					break;
-
-				lineSeparator = symbCarriageReturn;
-				std::cout << "This file uses non - complient line separator \\r(0x0D)" << std::endl;
-				break;
-			}
-		}
-
-		return lineSeparator;
-	} /* char getLineSeparator (std::ifstream& lutFile) */
-
-
-    const std::array<T, 3> ParseTableRow (const std::string& strBuffer)
-    {
-        std::array<T, 3> lutRawData;
-        std::istringstream data_line(strBuffer);
-
-        for (int32_t i = 0; i < 3; i++)
-        {
-            data_line >> lutRawData[i];
-            if (data_line.fail())
-            {
-                m_error = LutErrorCode::LutState::CouldNotParseTableData;
-                break;
-            }
-        }
-
-        return lutRawData;
-    }
-
 	LutErrorCode::LutState set_lut_size (void)
 	{
-		if (m_lutComponentSize[0] >= 2 && m_lutComponentSize[0] <= 256 && m_lutComponentSize[1] >= 2 && m_lutComponentSize[1] <= 256  && m_lutComponentSize[2] >= 2 && m_lutComponentSize[2] <= 256)
+		const LutElement::lutSize maxSize = LutElement::lut3DMaxSize;
+		if (m_lutComponentSize[0] >= 2 && m_lutComponentSize[0] <= maxSize && m_lutComponentSize[1] >= 2 && m_lutComponentSize[1] <= maxSize && m_lutComponentSize[2] >= 2 && m_lutComponentSize[2] <= maxSize)
 		{
 			// let's set lutSize equal to minimal component size ??? */
 			m_lutSize = std::min(m_lutComponentSize[0], std::min(m_lutComponentSize[1], m_lutComponentSize[2]));
-
-            // reserve memory for vector for hold all LUT Body data
-            LutElement::lutSize vecSize = m_lutComponentSize[0] * m_lutComponentSize[1] * m_lutComponentSize[2] * static_cast<LutElement::lutSize>(3);
-            m_lutBody.reserve(vecSize);
             return LutErrorCode::LutState::OK;
 		}
 		return LutErrorCode::LutState::LutSizeOutOfRange;
@@ -4,18 +4,148 @@
 #include <string>
 #include "lutElement.h"
 #include "lutErrors.h"
+#include "string_view.h"
+#include <fstream>
+#include <iostream>
+#include <utility>
 
-template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr> 
+template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
 class CCubeLut1D
 {
 public:
-	
+	LutElement::lutFileName const getLutFileName (void) const {return m_lutName;}
+	LutErrorCode::LutState getLastError(void) const { return m_error; }
+	LutElement::lutSize getLutSize (void) const { return m_lutSize; }
+	LutElement::lutSize getLutComponentSize (const LutElement::LutComponent component) const {(void)component; return getLutSize();}
+
+	// create empty LUT (all entries set to zero) with defined size and domain, for fill LUT body programmatically
+	LutErrorCode::LutState CreateLut
+	(
+		const LutElement::lutSize lutSize,
+		const LutElement::lutTableRaw<T>& domainMin = { static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) },
+		const LutElement::lutTableRaw<T>& domainMax = { static_cast<T>(1), static_cast<T>(1), static_cast<T>(1) }
+	)
+	{
+		_cleanup();
+		if (lutSize < lutMinSize || lutSize > lutMaxSize)
+			return LutErrorCode::LutState::LutSizeOutOfRange;
+		if (3 != domainMin.size() || 3 != domainMax.size())
+			return LutErrorCode::LutState::IncorrectDimension;
+		if (domainMin[0] > domainMax[0] || domainMin[1] > domainMax[1] || domainMin[2] > domainMax[2])
+			return LutErrorCode::LutState::DomainBoundReversed;
+
+		m_domainMin = domainMin;
+		m_domainMax = domainMax;
+		m_lutSize = lutSize;
+		m_lutBody.assign(m_lutSize * static_cast<LutElement::lutSize>(3), static_cast<T>(0));
+		m_error = LutErrorCode::LutState::OK;
+		return m_error;
+	}
+
+
+	LutErrorCode::LutState SaveFile (std::ofstream& outFile)
+	{
+		if (0 == m_lutSize)
+			return LutErrorCode::LutState::NotInitialized;
+
+		if (outFile.good())
+		{
+			outFile << symbCommentMarker << symbSpace << "This file created by LutLibrary" << std::endl;
+			outFile << std::endl;
+			if (m_title.size() > 0)
+			{
+				outFile << "TITLE" << symbSpace << symbQuote << m_title << symbQuote << std::endl;
+				outFile << std::endl;
+			}
+			if (3 == m_domainMin.size() && 3 == m_domainMax.size())
+			{
+				outFile << "DOMAIN_MIN" << symbSpace << m_domainMin[0] << symbSpace << m_domainMin[1] << symbSpace << m_domainMin[2] << std::endl;
+				outFile << "DOMAIN_MAX" << symbSpace << m_domainMax[0] << symbSpace << m_domainMax[1] << symbSpace << m_domainMax[2] << std::endl;
+				outFile << std::endl;
+			}
+			outFile << "LUT_1D_SIZE" << symbSpace << m_lutSize << std::endl;
+			outFile << std::endl;
+
+			const auto itEnd = m_lutBody.cend();
+			auto it = m_lutBody.cbegin();
+			while (it + 2 < itEnd && outFile.good())
+			{
+				outFile << *it << symbSpace << *(it + 1) << symbSpace << *(it + 2) << std::endl;
+				it += 3;
+			}
+			outFile << std::endl;
+			outFile.flush(); /* flush file stream */
+		}
+		return (outFile.good() ? LutErrorCode::LutState::OK : LutErrorCode::LutState::WriteError);
+	}
+
+	LutErrorCode::LutState SaveFile (const string_view& fileName)
+	{
+		std::ofstream outFile (fileName, std::ios::out | std::ios::trunc);
+		if (!outFile.good())
+			return LutErrorCode::LutState::FileNotOpened;
+
+		auto const err = SaveFile (outFile);
+		outFile.close();
+		return err;
+	}
+
+	LutErrorCode::LutState SaveFile (const char* fileName)
+	{
+		return (nullptr != fileName && '\0' != fileName[0]) ? SaveFile (string_view{ fileName }) : LutErrorCode::LutState::GenericError;
+	}
+
+	LutErrorCode::LutState SaveFile (const std::string& fileName)
+	{
+		std::ofstream outFile (fileName, std::ios::out | std::ios::trunc);
+		if (!outFile.good())
+			return LutErrorCode::LutState::FileNotOpened;
+
+		auto const err = SaveFile (outFile);
+		outFile.close();
+		return err;
+	}
+
+
+	const LutElement::lutTable3D<T>& get_data(void) const noexcept { return m_lutBody; }
+	      LutElement::lutTable3D<T>& get_data(void)       noexcept { return m_lutBody; }
+
+	const std::pair<LutElement::lutTableRaw<T>, LutElement::lutTableRaw<T>> getMinMaxDomain (void)
+	{
+		if (3 != m_domainMin.size())
+			m_domainMin = { static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) };
+		if (3 != m_domainMax.size())
+			m_domainMax = { static_cast<T>(1), static_cast<T>(1), static_cast<T>(1) };
+		return std::make_pair(m_domainMin, m_domainMax);
+	}
+
 private:
-	size_t                     m_lutSize;
+	LutElement::lutSize        m_lutSize = 0u;
 	LutElement::lutFileName    m_lutName;
+	LutElement::lutTitle       m_title;
 	LutElement::lutTableRaw<T> m_domainMin;
 	LutElement::lutTableRaw<T> m_domainMax;
-	LutElement::lutTable3D<T>  m_lutBody;
+	LutElement::lutTable3D<T>  m_lutBody; /* flat layout: R, G, B triplet per entry */
+	LutErrorCode::LutState     m_error = LutErrorCode::LutState::NotInitialized;
+
+	static constexpr LutElement::lutSize lutMinSize = 2u;
+	static constexpr LutElement::lutSize lutMaxSize = 65536u;
+
+	static constexpr char symbCommentMarker  = '#';
+	static constexpr char symbQuote          = '"';
+	static constexpr char symbSpace          = ' ';
+
+	void _cleanup (void)
+	{
+		m_domainMin.clear();
+		m_domainMax.clear();
+		m_lutBody.clear();
+		m_lutName.clear();
+		m_title.clear();
+		m_lutSize = 0u;
+		m_error = LutErrorCode::LutState::NotInitialized;
+		return;
+	}
 
 };
 
@@ -4,12 +4,23 @@
 #include "lutElement.h"
 #include "lutErrors.h"
 #include "string_view.h"
+#include "text_tokenizer.h"
+#include "mapped_file.h"
+#include "parallel_text.h"
+#include "huge_pages.h"
+#include "load_budget.h"
+#include "lutAsync.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <utility>
 #include <cctype>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <map>
+#include <mutex>
 
 template<typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr> 
 class CCubeLut3D
@@ -18,102 +29,114 @@ public:
 	LutElement::lutFileName const getLutFileName (void) const {return m_lutName;}
 	LutErrorCode::LutState getLastError(void) const { return m_error; }
 	LutElement::lutSize getLutSize (void) const { return m_lutSize; }
+	LutElement::lutTitle const getTitle (void) const { return m_title; }
 	LutElement::lutSize getLutComponentSize (const LutElement::LutComponent component) const {(void)component; return getLutSize();}
+	static constexpr LutElement::AxisOrder getNativeAxisOrder (void) noexcept { return LutElement::AxisOrder::RedFastest; }
+
+	/* resource limits applied to every following load (untrusted files); all limits disabled by default */
+	void setLoadLimits (const LutLimits::LoadLimits& limits) noexcept { m_limits = limits; }
+	const LutLimits::LoadLimits& getLoadLimits (void) const noexcept { return m_limits; }
 
     LutErrorCode::LutState LoadFile(std::ifstream& lutFile)
     {
-        std::string stringBuffer, keyword;
-
-        /* clear file stream status */
+        /* clear file stream status and read complete file content */
         lutFile.clear();
+        lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
+        const std::string content { std::istreambuf_iterator<char>(lutFile), std::istreambuf_iterator<char>() };
+        return LoadFromMemory (content.data(), content.size());
+    }
+
+    /* parse CUBE 3D LUT keywords only (LUT body not read): on success 'bodyOffset' receives offset of the first body row in buffer */
+    LutErrorCode::LutState LoadHeader (const char* data, const std::size_t size, std::size_t& bodyOffset)
+    {
         /* cleanup internal objects before parsing */
         _cleanup();
-
-        /* check line separator used in 3D CUBE file */
-        const char lineSeparator = getLineSeparator(lutFile);
-        if ('\0' == lineSeparator)
+        bodyOffset = size;
+        if (nullptr == data || 0u == size)
             return LutErrorCode::LutState::CouldNotParseTableData;
 
-        /* unconditional seek on start of file for start parsing */
-        lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
+        LutText::CTextTokenizer text (data, size);
+        string_view line, keyword;
 
         LutErrorCode::LutState loadStatus = LutErrorCode::LutState::OK;
         bool bData = false;
 
         /* IN FIRST READ KEYWORDS */
-        do {
-            stringBuffer.clear(); /* cleanup string before read line from file */
-            const auto linePos = (lutFile.good() ? lutFile.tellg() : static_cast<std::streampos>(-1));
-            if (LutErrorCode::LutState::OK == (loadStatus = ReadLine(lutFile, stringBuffer, lineSeparator)))
-            {
-                keyword.clear();
-                std::istringstream line(stringBuffer);
-                line >> keyword;
-
-                if (std::isdigit(static_cast<unsigned char>(keyword[0])) || keyword[0] == '-' || keyword[0] == '.')
-                {
-                    /* LUT data itself starting */
-                    lutFile.seekg(linePos, std::ios_base::beg);
-                    bData = true;
-                }
-                else if ("TITLE" == keyword)
-                    loadStatus = read_lut_title(line);
-                else if ("LUT_3D_SIZE" == keyword)
-                    loadStatus = set_lut_size(line);
-                else if ("LUT_1D_SIZE" == keyword)
-                    return LutErrorCode::LutState::IncorrectDimension; /* because 3D and 1D CUBE LUT looks very similar we need put protection here from incorrect read */
-                else if ("DOMAIN_MIN" == keyword)
-                    loadStatus = set_domain_min_value(line);
-                else if ("DOMAIN_MAX" == keyword)
-                    loadStatus = set_domain_max_value(line);
-            } /* if (LutErrorCode::LutState::OK == (loadStatus = ReadLine(lutFile, stringBuffer, lineSeparator))) */
-        } while (loadStatus == LutErrorCode::LutState::OK && false == bData);
-
-        // VALIDATE KEYWORDS AND READ LUT BODY
-        if (LutErrorCode::LutState::OK == keywords_validation())
+        while (false == bData && LutErrorCode::LutState::OK == (loadStatus = ReadLine(text, line)))
         {
-            const LutElement::lutSize lutLinesNumb = m_lutSize * m_lutSize * m_lutSize;
-            for (LutElement::lutSize idx = 0; idx < lutLinesNumb; idx++)
-            {
-                // READ LUT DATA
-                stringBuffer.clear();
-                if (LutErrorCode::LutState::OK == (loadStatus = ReadLine(lutFile, stringBuffer, lineSeparator)))
-                {
-                    // skip #xxBLOB section
-                    if (symbCommentMarker == stringBuffer[0])
-                    {
-                        continue;
-                    }
-
-                    const std::array<T, 3> lutLine = ParseTableRow(stringBuffer);
-                    m_lutBody.insert(m_lutBody.end(), lutLine.cbegin(), lutLine.cend());
-                }
-            }
+            string_view args = line;
+            LutText::next_token(args, keyword);
+
+            if (LutText::is_number_start(keyword[0]))
+                bData = true; /* LUT data itself starting: current line is the first row of LUT body */
+            else if ("TITLE" == keyword)
+                loadStatus = read_lut_title(args);
+            else if ("LUT_3D_SIZE" == keyword)
+                loadStatus = set_lut_size(args);
+            else if ("LUT_1D_SIZE" == keyword)
+                return LutErrorCode::LutState::IncorrectDimension; /* because 3D and 1D CUBE LUT looks very similar we need put protection here from incorrect read */
+            else if ("DOMAIN_MIN" == keyword)
+                loadStatus = set_domain_min_value(args);
+            else if ("DOMAIN_MAX" == keyword)
+                loadStatus = set_domain_max_value(args);
+            if (LutErrorCode::LutState::OK != loadStatus)
+                return loadStatus;
+        }
+
+        if (true == bData)
+            bodyOffset = static_cast<std::size_t>(line.data() - data);
+        return (LutErrorCode::LutState::OK == keywords_validation() ? LutErrorCode::LutState::OK : LutErrorCode::LutState::GenericError);
+    }
+
+    /* parse CUBE 3D LUT from text buffer (buffer not required after return) */
+    LutErrorCode::LutState LoadFromMemory (const char* data, const std::size_t size)
+    {
+        const LutLimits::CLoadBudget budget (m_limits);
+        return LoadFromMemory (data, size, budget);
+    }
 
-            loadStatus = lut_size_validation();
+    /* parse CUBE 3D LUT from text buffer with budget of caller: limits, deadline, cancellation and progress */
+    LutErrorCode::LutState LoadFromMemory (const char* data, const std::size_t size, const LutLimits::CLoadBudget& budget)
+    {
+        if (false == budget.input_allowed (size))
+        {
+            _cleanup();
+            return (m_error = LutErrorCode::LutState::ResourceLimitExceeded);
+        }
+
+        std::size_t bodyOffset = 0u;
+        LutErrorCode::LutState loadStatus = LoadHeader (data, size, bodyOffset);
+
+        // VALIDATED KEYWORDS: READ LUT BODY
+        if (LutErrorCode::LutState::OK == loadStatus)
+        {
+            // READ LUT DATA: body starts from first row found after keywords, rows parsed in parallel
+            const LutElement::lutSize lutLinesNumb = m_lutSize * m_lutSize * m_lutSize;
+            if (lutLinesNumb > budget.max_lattice_points (3u * sizeof(T)))
+                return (m_error = LutErrorCode::LutState::ResourceLimitExceeded);
+
+            budget.start_progress (size - bodyOffset);
+            const auto rows = LutText::parse_rows (data + bodyOffset, size - bodyOffset, LutText::CTextTokenizer (data, size).separator(), lutLinesNumb, 3u, m_lutBody,
+                                                   [](const string_view& row) { return symbCommentMarker != row[0]; }, 0u, &budget);
+            if (true == rows.stopped)
+                loadStatus = LutAsync::stop_reason (budget);
+            else if (false == rows.ok())
+                loadStatus = LutErrorCode::LutState::CouldNotParseTableData;
+            else if (rows.parsed < lutLinesNumb)
+                loadStatus = LutErrorCode::LutState::PrematureEndOfFile;
+            else
+                loadStatus = LutErrorCode::LutState::OK;
+
+            if (LutErrorCode::LutState::OK == loadStatus)
+                loadStatus = lut_size_validation();
             m_error = loadStatus;
         }
-        else
-            loadStatus = LutErrorCode::LutState::GenericError;
         return loadStatus;
     }
 
 	LutErrorCode::LutState LoadFile (const string_view& lutFileName)
 	{
-		LutErrorCode::LutState err = LutErrorCode::LutState::OK;
-		if (!lutFileName.empty() && lutFileName != m_lutName)
-		{
-			std::ifstream cubeFile3D { lutFileName, std::ios::in | std::ios::binary };
-			if (!cubeFile3D.good())
-				return LutErrorCode::LutState::FileNotOpened;
-			
-			err = LoadFile (cubeFile3D);
-			cubeFile3D.close();
-
-			if (LutErrorCode::LutState::OK == err)
-				m_lutName = lutFileName;
-		}
-		return err;
+		return LoadFile (std::string (lutFileName.begin(), lutFileName.end()));
 	}
 
 	LutErrorCode::LutState LoadFile (const char* lutFileName)
@@ -123,16 +146,27 @@ public:
 
 
 	LutErrorCode::LutState LoadFile (const std::string& lutFileName)
+	{
+		const LutLimits::CLoadBudget budget (m_limits);
+		return LoadFile (lutFileName, budget);
+	}
+
+	/* load file on library I/O pool (see lutAsync.h): progress reported as bytes of LUT body parsed */
+	LutAsync::CLoadHandle LoadFileAsync (const std::string& lutFileName, LutLimits::ProgressCallback progress = nullptr)
+	{
+		return LutAsync::launch (m_limits, [this, lutFileName](const LutLimits::CLoadBudget& budget) { return LoadFile (lutFileName, budget); }, std::move (progress));
+	}
+
+	LutErrorCode::LutState LoadFile (const std::string& lutFileName, const LutLimits::CLoadBudget& budget)
 	{ 
 		LutErrorCode::LutState err = LutErrorCode::LutState::OK;
 		if (!lutFileName.empty() && lutFileName != m_lutName)
 		{
-			std::ifstream cubeFile3D { lutFileName, std::ios::in | std::ios::binary };
+			const LutText::CMappedFile cubeFile3D { lutFileName };
 			if (!cubeFile3D.good())
 				return LutErrorCode::LutState::FileNotOpened;
 			
-			err = LoadFile (cubeFile3D);
-			cubeFile3D.close();
+			err = LoadFromMemory (cubeFile3D.data(), cubeFile3D.size(), budget);
 
 			if (LutErrorCode::LutState::OK == err)
 				m_lutName = lutFileName;
@@ -210,7 +244,128 @@ public:
 	}
 
 
+   // non-const access drops cached neutral axis and preview LUTs: LUT body must be modified only through reference
+   // taken from this call after last cache request (reference kept from earlier call leaves caches stale), and not
+   // concurrently with any other user of the object
    const LutElement::lutTable3D<T>& get_data(void) const noexcept { return m_lutBody; }
+         LutElement::lutTable3D<T>& get_data(void)       noexcept
+   {
+       std::lock_guard<std::mutex> lock (m_cacheLock.mutex);
+       m_neutralAxisValid = false;
+       m_previewLuts.clear();
+       return m_lutBody;
+   }
+
+
+   // diagonal of the cube (nodes with r == g == b) as dense 1D curve: lutSize triplets, built on first request
+   // and rebuilt after LUT body accessed for modification; safe for concurrent callers
+   const LutElement::lutTable3D<T>& getNeutralAxis (void)
+   {
+       std::lock_guard<std::mutex> lock (m_cacheLock.mutex);
+       if (false == m_neutralAxisValid)
+       {
+           m_neutralAxis.clear();
+           if (LutErrorCode::LutState::OK == m_error && m_lutBody.size() == m_lutSize * m_lutSize * m_lutSize * 3u)
+           {
+               const std::size_t diagStride = (m_lutSize * m_lutSize + m_lutSize + 1u) * 3u;
+               m_neutralAxis.resize(m_lutSize * 3u);
+               for (std::size_t i = 0; i < m_lutSize; i++)
+               {
+                   m_neutralAxis[i * 3 + 0] = m_lutBody[i * diagStride + 0];
+                   m_neutralAxis[i * 3 + 1] = m_lutBody[i * diagStride + 1];
+                   m_neutralAxis[i * 3 + 2] = m_lutBody[i * diagStride + 2];
+               }
+               m_neutralAxisValid = true;
+           }
+       }
+       return m_neutralAxis;
+   }
+
+
+   // reduced copy of LUT body (previewSize^3 nodes) resampled with trilinear interpolation, for preview/draft
+   // processing; built once per requested size and rebuilt after LUT body accessed for modification. Safe for
+   // concurrent callers: each size kept in own table, so returned reference stays valid while other sizes built.
+   // If LUT not bigger than requested size - original LUT body returned.
+   const LutElement::lutTable3D<T>& getPreviewLut (const LutElement::lutSize previewSize)
+   {
+       if (LutErrorCode::LutState::OK != m_error || previewSize < lutMinSize || previewSize >= m_lutSize)
+           return m_lutBody;
+
+       std::lock_guard<std::mutex> lock (m_cacheLock.mutex);
+       LutElement::lutTable3D<T>& previewLut = m_previewLuts[previewSize];
+       if (true == previewLut.empty())
+       {
+           const std::size_t N = m_lutSize;
+           const T scale = static_cast<T>(N - 1u) / static_cast<T>(previewSize - 1u);
+           auto node = [&](std::size_t i, T& frac) -> std::size_t
+           {
+               const T f = static_cast<T>(i) * scale;
+               const std::size_t i0 = std::min(static_cast<std::size_t>(f), N - 2u);
+               frac = f - static_cast<T>(i0);
+               return i0;
+           };
+
+           previewLut.resize(previewSize * previewSize * previewSize * 3u);
+           T* out = previewLut.data();
+           for (std::size_t b = 0; b < previewSize; b++)
+           {
+               T tb; const std::size_t b0 = node (b, tb);
+               for (std::size_t g = 0; g < previewSize; g++)
+               {
+                   T tg; const std::size_t g0 = node (g, tg);
+                   for (std::size_t r = 0; r < previewSize; r++, out += 3)
+                   {
+                       T tr; const std::size_t r0 = node (r, tr);
+                       const T* p = m_lutBody.data() + ((b0 * N + g0) * N + r0) * 3u;
+                       const std::size_t sG = N * 3u, sB = N * N * 3u;
+                       for (std::size_t c = 0; c < 3u; c++)
+                       {
+                           const T c00 = p[c]           + (p[c + 3u]           - p[c])           * tr;
+                           const T c10 = p[c + sG]      + (p[c + sG + 3u]      - p[c + sG])      * tr;
+                           const T c01 = p[c + sB]      + (p[c + sB + 3u]      - p[c + sB])      * tr;
+                           const T c11 = p[c + sB + sG] + (p[c + sB + sG + 3u] - p[c + sB + sG]) * tr;
+                           const T c0  = c00 + (c10 - c00) * tg;
+                           const T c1  = c01 + (c11 - c01) * tg;
+                           out[c] = c0 + (c1 - c0) * tb;
+                       }
+                   }
+               }
+           }
+       }
+       return previewLut;
+   }
+
+
+   // create empty LUT (all nodes set to zero) with defined size and domain, for fill LUT body programmatically
+   LutErrorCode::LutState CreateLut
+   (
+       const LutElement::lutSize lutSize,
+       const LutElement::lutTableRaw<T>& domainMin = { static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) },
+       const LutElement::lutTableRaw<T>& domainMax = { static_cast<T>(1), static_cast<T>(1), static_cast<T>(1) }
+   )
+   {
+       _cleanup();
+       if (lutSize < lutMinSize || lutSize > lutMaxSize)
+           return LutErrorCode::LutState::LutSizeOutOfRange;
+       if (3 != domainMin.size() || 3 != domainMax.size())
+           return LutErrorCode::LutState::IncorrectDimension;
+
+       m_lutSize   = lutSize;
+       m_domainMin = domainMin;
+       m_domainMax = domainMax;
+       const LutErrorCode::LutState err = keywords_validation();
+       if (LutErrorCode::LutState::OK != err)
+       {
+           _cleanup();
+           return err;
+       }
+
+       const LutElement::lutSize elements = m_lutSize * m_lutSize * m_lutSize * static_cast<LutElement::lutSize>(3);
+       LutMemory::reserve_huge(m_lutBody, elements);
+       m_lutBody.assign(elements, static_cast<T>(0));
+       m_error = LutErrorCode::LutState::OK;
+       return m_error;
+   }
  
         
    const std::pair<LutElement::lutTableRaw<T>, LutElement::lutTableRaw<T>> getMinMaxDomain (void)
@@ -230,13 +385,30 @@ public:
    }
 
 private:
+	// lock of lazily built caches; not shared between copies of object - each copy gets own mutex
+	struct CacheLock
+	{
+		std::mutex mutex;
+		CacheLock (void) = default;
+		CacheLock (const CacheLock&) noexcept {}
+		CacheLock& operator= (const CacheLock&) noexcept { return *this; }
+	};
+
 	LutElement::lutTableRaw<T>  m_domainMin;
 	LutElement::lutTableRaw<T>  m_domainMax;
     LutElement::lutTable3D<T>   m_lutBody;
+    LutElement::lutTable3D<T>   m_neutralAxis;
+    std::map<LutElement::lutSize, LutElement::lutTable3D<T>> m_previewLuts;
     LutElement::lutFileName     m_lutName;
 	LutElement::lutTitle        m_title;
 	LutElement::lutSize         m_lutSize;
 	LutErrorCode::LutState      m_error = LutErrorCode::LutState::NotInitialized;
+	bool                        m_neutralAxisValid = false;
+	LutLimits::LoadLimits       m_limits;
+	CacheLock                   m_cacheLock;
+
+	static constexpr LutElement::lutSize lutMinSize = 2u;
+	static constexpr LutElement::lutSize lutMaxSize = LutElement::lut3DMaxSize;
 
 	static constexpr char symbNewLine        = '\n';
 	static constexpr char symbCarriageReturn = '\r';
@@ -249,6 +421,9 @@ private:
 		m_domainMin.clear();
 		m_domainMax.clear();
 		m_lutBody.clear();
+		m_neutralAxis.clear();
+		m_neutralAxisValid = false;
+		m_previewLuts.clear();
 		m_lutName.clear();
 		m_title.clear();
 		m_lutSize = 0u;
@@ -278,116 +453,60 @@ private:
 	}
 
 
-	LutErrorCode::LutState read_lut_title (std::istringstream& line)
+	LutErrorCode::LutState read_lut_title (const string_view& args)
 	{
-		LutErrorCode::LutState err = LutErrorCode::LutState::OK;
-		char startOfTitle;
-		line >> startOfTitle;
-		if (symbQuote != startOfTitle)
-		{
-			err = LutErrorCode::LutState::TitleMissingQuote;
-		}
-		else
-		{
-			/* read till second quota character */
-			std::getline(line, m_title, symbQuote);
-		}
-
-		return err;
+		/* title enclosed in quotes: read till second quote character */
+		const string_view title = LutText::trim(args);
+		if (0u == title.size() || symbQuote != title[0])
+			return LutErrorCode::LutState::TitleMissingQuote;
+
+		std::size_t end = 1u;
+		while (end < title.size() && symbQuote != title[end])
+			end++;
+		m_title.assign(title.data() + 1, end - 1u);
+		return LutErrorCode::LutState::OK;
 	}
 
 
-	LutErrorCode::LutState set_domain_min_value (std::istringstream& line)
+	LutErrorCode::LutState set_domain_min_value (const string_view& args)
 	{
 		m_domainMin.resize(3);
-		line >> m_domainMin[0] >> m_domainMin[1] >> m_domainMin[2];
-		return LutErrorCode::LutState::OK;
+		return (3u == LutText::parse_numbers(args, m_domainMin.data(), 3u) ? LutErrorCode::LutState::OK : LutErrorCode::LutState::CouldNotParseTableData);
 	}
 
 
-	LutErrorCode::LutState set_domain_max_value (std::istringstream& line)
+	LutErrorCode::LutState set_domain_max_value (const string_view& args)
 	{
 		m_domainMax.resize(3);
-		line >> m_domainMax[0] >> m_domainMax[1] >> m_domainMax[2];
-		return LutErrorCode::LutState::OK;
+		return (3u == LutText::parse_numbers(args, m_domainMax.data(), 3u) ? LutErrorCode::LutState::OK : LutErrorCode::LutState::CouldNotParseTableData);
 	}
 
 
-	LutErrorCode::LutState set_lut_size (std::istringstream& line)
+	LutErrorCode::LutState set_lut_size (string_view args)
 	{
 		int32_t lutSize = -1;
-		line >> lutSize;
-		if (lutSize >= 2 && lutSize <= 256)
+		string_view token;
+		if (LutText::next_token(args, token) && LutText::parse_integer(token, lutSize) &&
+			lutSize >= static_cast<int32_t>(lutMinSize) && lutSize <= static_cast<int32_t>(lutMaxSize))
 		{
 			m_lutSize = static_cast<decltype(m_lutSize)>(lutSize);
-            const LutElement::lutSize vecMemSize = m_lutSize * m_lutSize * m_lutSize * static_cast<LutElement::lutSize>(3);
-            m_lutBody.reserve(vecMemSize);
 			return LutErrorCode::LutState::OK;
 		}
 		return LutErrorCode::LutState::LutSizeOutOfRange;
 	}
 
 
-	char getLineSeparator (std::ifstream& lutFile)
+	/* next line with content: empty lines and comments skipped */
+	LutErrorCode::LutState ReadLine (LutText::CTextTokenizer& text, string_view& line)
 	{
-		char lineSeparator { '\0' };
-		for (int32_t i = 0; i < 256; i++)
+		while (text.next_line(line))
 		{
-			auto c = lutFile.get();
-			if (c == symbNewLine)
-			{
-				lineSeparator = symbNewLine;
-				break;
-			}
-
-			if (c == symbCarriageReturn)
-			{
-				if (symbCarriageReturn == lutFile.get())
-					break;
-
-				lineSeparator = symbCarriageReturn;
-				std::cout << "This file uses non - complient line separator \\r(0x0D)" << std::endl;
-				break;
-			}
-		}
-
-		return lineSeparator;
-	} /* char getLineSeparator (std::ifstream& lutFile) */
-
-
-	LutErrorCode::LutState ReadLine (std::ifstream& lutFile, std::string& strBuffer, const char& lineSeparator)
-	{
-		while (0u == strBuffer.size() || symbCommentMarker == strBuffer[0])
-		{
-			if (lutFile.eof())
-				return LutErrorCode::LutState::PrematureEndOfFile;
-
-			std::getline(lutFile, strBuffer, lineSeparator);
-			if (lutFile.fail())
-				return LutErrorCode::LutState::ReadError;
+			line = LutText::trim(line);
+			if (0u != line.size() && symbCommentMarker != line[0])
+				return LutErrorCode::LutState::OK;
 		}
-		return LutErrorCode::LutState::OK;
-	} /* LutErrorCode::LutState ReadLine(std::ifstream& lutFile, std::string& strBuffer, const char& lineSeparator) */
-
-
-    std::array<T, 3> ParseTableRow(const std::string& strBuffer)
-    {
-        constexpr size_t elementsInLine = 3ull;
-        std::array<T, elementsInLine> lutRawData;
-        std::istringstream data_line(strBuffer);
-
-        for (size_t i = 0; i < elementsInLine; i++)
-        {
-            data_line >> lutRawData[i];
-            if (data_line.fail())
-            {
-                m_error = LutErrorCode::LutState::CouldNotParseTableData;
-                break;
-            }
-        }
-
-        return lutRawData;
-    }
+		return LutErrorCode::LutState::PrematureEndOfFile;
+	}
 
 }; /* class CCubeLut3D */
 
@@ -4,6 +4,7 @@
 #include <vector>
 #include <array>
 #include <string>
+#include <cstddef>
 
 namespace LutElement
 {
@@ -27,6 +28,9 @@ namespace LutElement
 	using lutFileName = std::string;
 	using lutTitle    = std::string;
 	using lutSize     = size_t;
+
+	// largest supported 3D LUT lattice (nodes per axis); all index math done in size_t
+	constexpr lutSize lut3DMaxSize = 1024u;
 	
 	enum class LutComponent
 	{
@@ -34,6 +38,26 @@ namespace LutElement
 		Green,
 		Blue
 	};
+
+	// order of lattice traversal in LUT body (which input axis changes fastest)
+	enum class AxisOrder
+	{
+		RedFastest = 0,		// Cube, CSP, Hald
+		BlueFastest			// 3DL, Nuke VF
+	};
+
+	// layout of LUT body expected by interpolators
+	constexpr AxisOrder canonicalAxisOrder = AxisOrder::RedFastest;
+
+	// LUT file formats handled by loaders
+	enum class LutFormat
+	{
+		Cube = 0,
+		Lut3DL,
+		CineSpace,
+		Hald,
+		Unknown
+	};
 }
 
 #endif /* __LUT_LIBRARY_LUT_ELEMENT__ */
@@ -23,6 +23,8 @@ namespace LutErrorCode
 		CouldNotParseTableData,
 		FileNotOpened = 50,
 		IncorrectDimension,
+		ResourceLimitExceeded = 60,
+		Cancelled,
 		GenericError = 100
 	};
 }
@@ -6,6 +6,8 @@
 #include "endian_utils.h"
 #include "crc_utils.h"
 #include "string_view.h"
+#include "load_budget.h"
+#include "lutAsync.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -15,6 +17,7 @@
 #include <array>
 #include <cmath>
 #include <memory>
+#include <limits>
 #include "CHuffmanStream.h"
 #include "CReversibleFilter.h"
 
@@ -47,12 +50,24 @@ public:
 	LutErrorCode::LutState getLastError(void) { return m_error; }
 	LutElement::lutSize getLutSize (void) { return m_lutSize; }
 	LutElement::lutSize getLutComponentSize (const LutElement::LutComponent component) {(void)component; return getLutSize();}
+	static constexpr LutElement::AxisOrder getNativeAxisOrder (void) noexcept { return LutElement::AxisOrder::RedFastest; }
 
 	void set_property_3D (void) noexcept { m_3d_lut = true; }
 	void set_property_1D (void) noexcept { m_3d_lut = false; }
 	bool is_3D_property  (void) const noexcept { return m_3d_lut; }
 
+	/* resource limits applied to every following load (untrusted files); all limits disabled by default */
+	void setLoadLimits (const LutLimits::LoadLimits& limits) noexcept { m_limits = limits; }
+	const LutLimits::LoadLimits& getLoadLimits (void) const noexcept { return m_limits; }
+
 	LutErrorCode::LutState LoadFile (std::ifstream& lutFile)
+	{
+		const LutLimits::CLoadBudget budget (m_limits);
+		return LoadFile (lutFile, budget);
+	}
+
+	/* load with budget of caller: limits, deadline, cancellation and progress of image data inflate */
+	LutErrorCode::LutState LoadFile (std::ifstream& lutFile, const LutLimits::CLoadBudget& budget)
 	{
         // clear Lut Body vector
         m_lutBody3D.clear();
@@ -60,6 +75,14 @@ public:
 		lutFile.clear();
 		// cleanup internal objects before parsing/
 		_cleanup();
+		mHaldChunkOrig.clear();
+
+		/* size of file bounds size of every chunk */
+		lutFile.seekg(static_cast<std::streamoff>(0), std::ios_base::end);
+		const std::streamoff fileEnd = lutFile.tellg();
+		const std::size_t fileSize = (fileEnd > 0 ? static_cast<std::size_t>(fileEnd) : 0u);
+		if (false == budget.input_allowed (fileSize))
+			return (m_error = LutErrorCode::LutState::ResourceLimitExceeded);
 
 		lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
 
@@ -72,7 +95,12 @@ public:
 			do
 			{
                 // if we have number of IDAT sections - let's rename it to IDAT0, IDAT1, etc... 
-				std::unordered_map<std::string, std::vector<uint8_t>> chunkMap = readPngChunk(lutFile, sections_IDAT);
+				if (true == budget.stopped())
+				{
+					mHaldChunkOrig.clear();
+					return (m_error = LutAsync::stop_reason (budget));
+				}
+				std::unordered_map<std::string, std::vector<uint8_t>> chunkMap = readPngChunk(lutFile, sections_IDAT, fileSize);
 				mHaldChunkOrig.insert(chunkMap.begin(), chunkMap.end());
 
                 // add logic for handle multiple IDAT sections in one PNG
@@ -97,7 +125,16 @@ public:
             {
                 if (true == parseIHDR(mHaldChunkOrig[{"IHDR"}]))
                 {
-                    if (true == decodeIDAT(mHaldChunkOrig[{"IDAT"}]))
+                    /* image size from IHDR checked before any decoding */
+                    const std::size_t latticePoints = static_cast<std::size_t>(m_lutSize) * m_lutSize * m_lutSize;
+                    if (0u == m_lutSize)
+                        m_error = LutErrorCode::LutState::LutSizeInvalid;
+                    else if (m_lutSize > LutElement::lut3DMaxSize)
+                        m_error = LutErrorCode::LutState::LutSizeOutOfRange;
+                    else if (false == budget.lattice_allowed (latticePoints) || false == budget.decoded_allowed (inflatedSize()) ||
+                             false == budget.decoded_allowed (latticePoints * 3u * sizeof(T)))
+                        m_error = LutErrorCode::LutState::ResourceLimitExceeded;
+                    else if (true == decodeIDAT(mHaldChunkOrig[{"IDAT"}], budget))
                         m_error = LutErrorCode::LutState::OK;
                 }
             }
@@ -107,6 +144,31 @@ public:
 		return m_error;
 	}
 	
+	/* read PNG signature and IHDR chunk only (image data not read and not decoded): LUT size and bit depth known on success */
+	LutErrorCode::LutState LoadHeader (std::istream& lutFile)
+	{
+		lutFile.clear();
+		_cleanup();
+		lutFile.seekg(static_cast<std::streampos>(0), std::ios_base::beg);
+
+		if (false == verifyPngFileSignature(readPngSignature(lutFile)))
+			return LutErrorCode::LutState::ReadError;
+
+		/* IHDR must be the first chunk of PNG stream */
+		const std::unordered_map<std::string, std::vector<uint8_t>> chunk = readPngChunk(lutFile);
+		auto const it = chunk.find({"IHDR"});
+		if (it == chunk.end() || false == parseIHDR(it->second))
+			return LutErrorCode::LutState::ReadError;
+		if (0u == m_lutSize)
+			return LutErrorCode::LutState::LutSizeInvalid;
+		return (m_lutSize > LutElement::lut3DMaxSize ? LutErrorCode::LutState::LutSizeOutOfRange : LutErrorCode::LutState::OK);
+	}
+
+	/* bit depth of PNG samples (8 or 16) */
+	uint32_t getBitDepth (void) const noexcept { return m_bitDepth; }
+
+	const LutElement::lutTable3D<T>& get_data (void) const noexcept { return m_lutBody3D; }
+
 	LutErrorCode::LutState LoadFile (const string_view& lutFileName)
 	{
 		LutErrorCode::LutState err = LutErrorCode::LutState::OK;
@@ -133,6 +195,18 @@ public:
 
 
 	LutErrorCode::LutState LoadFile (const std::string& lutFileName)
+	{
+		const LutLimits::CLoadBudget budget (m_limits);
+		return LoadFile (lutFileName, budget);
+	}
+
+	/* load file on library I/O pool (see lutAsync.h): progress reported as bytes of image data inflated */
+	LutAsync::CLoadHandle LoadFileAsync (const std::string& lutFileName, LutLimits::ProgressCallback progress = nullptr)
+	{
+		return LutAsync::launch (m_limits, [this, lutFileName](const LutLimits::CLoadBudget& budget) { return LoadFile (lutFileName, budget); }, std::move (progress));
+	}
+
+	LutErrorCode::LutState LoadFile (const std::string& lutFileName, const LutLimits::CLoadBudget& budget)
 	{ 
 		LutErrorCode::LutState err = LutErrorCode::LutState::OK;
 		if (!lutFileName.empty() && lutFileName != m_lutName)
@@ -142,7 +216,7 @@ public:
 				return LutErrorCode::LutState::FileNotOpened;
 			
 			m_lutName = lutFileName;
-			err = LoadFile (haldLut);
+			err = LoadFile (haldLut, budget);
 			haldLut.close();
 
 			if (LutErrorCode::LutState::OK == err)
@@ -170,6 +244,7 @@ private:
 	uint32_t m_CompressionMethod;
     uint32_t m_IdatNumber;
 	bool m_3d_lut = true;
+	LutLimits::LoadLimits m_limits;
 
 	void _cleanup (void)
 	{
@@ -187,7 +262,7 @@ private:
 
 	bool verifyPngFileSignature (const uint64_t& signature) noexcept {return (signature == 0x89504E470D0A1A0Au);}
 
-	uint64_t readPngSignature (std::ifstream& lutFile)
+	uint64_t readPngSignature (std::istream& lutFile)
 	{
 		uint64_t signature = 0u, signature_le = 0u;
 		lutFile.read (reinterpret_cast<char*>(&signature), sizeof(signature));
@@ -269,7 +344,16 @@ private:
         return true;
     }
 
-	std::unordered_map<std::string, std::vector<uint8_t>> readPngChunk (std::ifstream& lutFile, const uint32_t& idat_enum = 0u)
+	/* size of decoded (inflated) image data: every row prefixed by filter type byte */
+	std::size_t inflatedSize (void) const noexcept
+	{
+		const std::size_t rowBytes = (static_cast<std::size_t>(m_sizeX) * m_Channels * m_bitDepth + 7u) / 8u;
+		return static_cast<std::size_t>(m_sizeY) * (rowBytes + 1u);
+	}
+
+	/* chunk with declared data size above 'maxDataSize' (not more than file size) treated as invalid */
+	std::unordered_map<std::string, std::vector<uint8_t>> readPngChunk (std::istream& lutFile, const uint32_t& idat_enum = 0u,
+	                                                                     const std::size_t maxDataSize = static_cast<std::size_t>(std::numeric_limits<int32_t>::max()))
 	{
 		int32_t chunkSize = -1;
 		std::unordered_map<std::string, std::vector<uint8_t>> invalid_dict;
@@ -281,7 +365,9 @@ private:
 		{
 			/* get chunk size in little endian byte order */
 			const int32_t chunkSize_le = endian_convert (chunkSize);
-			const int32_t rSize = sizeof(uint32_t) + chunkSize_le; /* chunk name + chunk size */
+			if (chunkSize_le < 0 || static_cast<std::size_t>(chunkSize_le) > maxDataSize)
+				return invalid_dict;
+			const std::size_t rSize = sizeof(uint32_t) + static_cast<std::size_t>(chunkSize_le); /* chunk name + chunk size */
 
 			std::vector<uint8_t> data (rSize);
 			uint32_t crc32 = 0u;
@@ -340,7 +426,7 @@ private:
 	}
 #endif
 
-	bool decodeIDAT (const std::vector<uint8_t>& ihdrData)
+	bool decodeIDAT (const std::vector<uint8_t>& ihdrData, const LutLimits::CLoadBudget& budget)
 	{
 		bool bRet = false;
 		/* size of IDAT section in bytes, include section signature */
@@ -353,9 +439,27 @@ private:
 
             HuffmanUtils::CStreamPointer sp(HuffmanUtils::byte2sp(4u)); // forward stream pointer on 4 bytes for avoid IDAT header name
             HuffmanUtils::CHuffmanStream deflateStream (std::move(ihdrData), sp);
-            std::vector<uint8_t> decodedData = deflateStream.Decode();
-
-            const bool integrityStatus = deflateStream.StreamIntegrityStatus();
+            // valid stream never decoded to more than image size declared in IHDR; progress reported, deadline and
+            // cancellation checked after each block
+            deflateStream.SetOutputLimit (inflatedSize());
+            budget.start_progress (inflatedSize());
+            deflateStream.SetBlockCallback ([&budget](const size_t decoded) { budget.report (decoded); return false == budget.stopped(); });
+
+            std::vector<uint8_t> decodedData;
+            try
+            {
+                decodedData = deflateStream.Decode();
+            }
+            catch (const HuffmanUtils::COutputLimitError&)
+            {
+                m_error = LutErrorCode::LutState::ResourceLimitExceeded;
+                mHaldChunkOrig.clear();
+                return false;
+            }
+            /* reverse filter walks rows declared in IHDR: decoded data must hold all of them */
+            const bool integrityStatus = deflateStream.StreamIntegrityStatus() && decodedData.size() == inflatedSize();
+            if (false == integrityStatus && true == budget.stopped())
+                m_error = LutAsync::stop_reason (budget);
             if (true == integrityStatus)
             {
                 // remove/cleanup all PNG chunks for decrease memory usage
@@ -424,6 +528,13 @@ private:
 		return bRet;
 	}
 
+	/* Hald image of level L is L^3 x L^3 pixels and holds L^2 nodes per axis: 0 for other image width */
+	static LutElement::lutSize hald_lut_size (const uint32_t width) noexcept
+	{
+		const uint64_t level = static_cast<uint64_t>(std::llround (std::cbrt (static_cast<double>(width))));
+		return (level * level * level == static_cast<uint64_t>(width) ? static_cast<LutElement::lutSize>(level * level) : 0u);
+	}
+
 	bool parseIHDR (const std::vector<uint8_t>& ihdrData)
 	{
 		uint32_t width = 0u, height = 0u; 
@@ -451,7 +562,7 @@ private:
                 // monochrome LUT not supported yet!!!
 			    m_CompressionMethod = compressionMethod;
 			    m_bitDepth = static_cast<uint32_t>(bitDepth);
-			    m_lutSize = static_cast<LutElement::lutSize>(std::cbrt(static_cast<float>(width * height)));
+			    m_lutSize = hald_lut_size (width);
                 m_sizeX = width;
                 m_sizeY = height;
                 m_Channels = 3u;
@@ -0,0 +1,75 @@
+#ifndef __LUT_LIBRARY_LUT_LAYOUT__
+#define __LUT_LIBRARY_LUT_LAYOUT__
+
+#include "lutElement.h"
+#include "parallel_for.h"
+#include "huge_pages.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/*
+   Canonical memory layout of 3D LUT body used by all interpolators: interleaved RGB triplets, red index
+   changes fastest, then green, then blue: offset = ((b * N + g) * N + r) * 3.
+
+   Some formats store lattice in the opposite order (blue fastest: 3DL, Nuke VF). Loaders declare their
+   native order and convert body once on load, so interpolators never deal with per-format indexing.
+   Red <-> blue axes swap is transpose of N x N matrix of triplets for every green slice; it is done on
+   square tiles so both source rows and destination rows of the tile stay in cache.
+*/
+namespace LutLayout
+{
+    // tile edge (in lattice nodes) of blocked transpose: 16 x 16 triplets of double ~ 6 KB per side
+    constexpr std::size_t transposeTile = 16u;
+
+    // swap red and blue lattice axes: converts blue fastest body to red fastest and vice versa
+    template <typename T>
+    void swap_red_blue_axes (const T* src, T* dst, const std::size_t lutSize, const std::size_t channels = 3u, const uint32_t threads = 0u)
+    {
+        const std::size_t N = lutSize;
+        const std::size_t rowStride   = N * channels;          // distance between neighbour nodes on middle (green) axis
+        const std::size_t sliceStride = N * N * channels;      // distance between neighbour nodes on slowest axis
+
+        // green slices are independent; small lattices processed by calling thread
+        LutParallel::parallel_for (0u, N, std::max(static_cast<std::size_t>(1u), (64u * 64u) / std::max(N, static_cast<std::size_t>(1u))),
+            [&](const std::size_t gBegin, const std::size_t gEnd, const uint32_t)
+            {
+                for (std::size_t g = gBegin; g < gEnd; g++)
+                    for (std::size_t i0 = 0u; i0 < N; i0 += transposeTile)
+                        for (std::size_t j0 = 0u; j0 < N; j0 += transposeTile)
+                        {
+                            const std::size_t i1 = std::min(i0 + transposeTile, N);
+                            const std::size_t j1 = std::min(j0 + transposeTile, N);
+                            for (std::size_t i = i0; i < i1; i++)
+                            {
+                                // source node (slow = i, fast = j) goes to destination node (slow = j, fast = i)
+                                const T* s = src + i * sliceStride + g * rowStride + j0 * channels;
+                                T* d = dst + j0 * sliceStride + g * rowStride + i * channels;
+                                for (std::size_t j = j0; j < j1; j++, s += channels, d += sliceStride)
+                                    for (std::size_t c = 0u; c < channels; c++)
+                                        d[c] = s[c];
+                            }
+                        }
+            },
+            threads);
+        return;
+    }
+
+    // convert LUT body from 'from' axis order to 'to' axis order in place (through temporary copy)
+    template <typename T>
+    void normalize_axis_order (LutElement::lutTable3D<T>& body, const std::size_t lutSize,
+                               const LutElement::AxisOrder from, const LutElement::AxisOrder to = LutElement::canonicalAxisOrder)
+    {
+        if (from == to || lutSize < 2u || body.size() != lutSize * lutSize * lutSize * 3u)
+            return;
+        LutElement::lutTable3D<T> converted;
+        LutMemory::reserve_huge (converted, body.size());
+        converted.resize (body.size());
+        swap_red_blue_axes (body.data(), converted.data(), lutSize);
+        body.swap (converted);
+        return;
+    }
+
+} // namespace LutLayout
+
+#endif /* __LUT_LIBRARY_LUT_LAYOUT__ */
@@ -0,0 +1,324 @@
+#ifndef __LUT_LIBRARY_LUT_PROBE__
+#define __LUT_LIBRARY_LUT_PROBE__
+
+#include "lutElement.h"
+#include "lutErrors.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include "lutHald.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+/*
+   Header-only probe of LUT files: format, size, title and domain are read without parsing LUT body
+   (Cube keywords, CSP markers/metadata/pre-LUT/size line, 3DL comments and grid line, PNG IHDR chunk of
+   Hald). Text files are memory mapped, so only pages holding header are read from disk; the only format
+   that needs to look through body is 3DL without grid line - LUT size then defined by number of rows.
+
+   CLazyLut keeps probed header and parses LUT body on first access to data.
+*/
+namespace LutProbe
+{
+    using LutFormat = LutElement::LutFormat;
+
+    template <typename T>
+    struct LutInfo
+    {
+        LutFormat             format = LutFormat::Unknown;
+        LutElement::lutSize   lutSize = 0u;                      // nodes per axis (smallest of components for CSP)
+        std::array<LutElement::lutSize, 3> componentSize {{ 0u, 0u, 0u }};
+        std::array<T, 3>      domainMin {{ static_cast<T>(0), static_cast<T>(0), static_cast<T>(0) }};
+        std::array<T, 3>      domainMax {{ static_cast<T>(1), static_cast<T>(1), static_cast<T>(1) }};
+        LutElement::lutTitle  title;
+        LutElement::AxisOrder order = LutElement::canonicalAxisOrder;   // lattice traversal order of body in file
+        uint32_t              inBits  = 0u;                      // 3DL: bit depth of grid code values
+        uint32_t              outBits = 0u;                      // 3DL: bit depth of integer body (0 if not declared); Hald: PNG bit depth
+        bool                  integerBody = false;               // 3DL body holds integer code values
+        std::size_t           bodyOffset = 0u;                   // text formats: offset of the first body row
+        std::size_t           fileSize = 0u;
+    };
+
+    // lattice traversal order of LUT body in file of given format
+    inline LutElement::AxisOrder native_axis_order (const LutFormat format) noexcept
+    {
+        switch (format)
+        {
+            case LutFormat::Lut3DL:    return CLut3DL<float>::getNativeAxisOrder();
+            case LutFormat::CineSpace: return CCineSpaceLut3D<float>::getNativeAxisOrder();
+            case LutFormat::Hald:      return CHaldLut<float>::getNativeAxisOrder();
+            default:                   return CCubeLut3D<float>::getNativeAxisOrder();
+        }
+    }
+
+    // format from file name extension (case insensitive): .cube, .3dl, .csp, .png
+    inline LutFormat format_from_name (const std::string& fileName)
+    {
+        const std::size_t dot = fileName.find_last_of ('.');
+        if (std::string::npos == dot)
+            return LutFormat::Unknown;
+        std::string ext = fileName.substr (dot + 1u);
+        std::transform (ext.begin(), ext.end(), ext.begin(), [](const char c) { return static_cast<char>(std::tolower (static_cast<unsigned char>(c))); });
+        if ("cube" == ext) return LutFormat::Cube;
+        if ("3dl"  == ext) return LutFormat::Lut3DL;
+        if ("csp"  == ext) return LutFormat::CineSpace;
+        if ("png"  == ext) return LutFormat::Hald;
+        return LutFormat::Unknown;
+    }
+
+
+    // Hald: PNG signature and IHDR chunk
+    template <typename T>
+    LutErrorCode::LutState probe_stream (std::istream& stream, LutInfo<T>& info)
+    {
+        CHaldLut<T> lut;
+        const LutErrorCode::LutState err = lut.LoadHeader (stream);
+        info.lutSize = lut.getLutSize();
+        info.componentSize.fill (info.lutSize);
+        info.outBits = lut.getBitDepth();
+        return err;
+    }
+
+    // read LUT header from buffer holding complete file content
+    template <typename T>
+    LutErrorCode::LutState probe_memory (const char* data, const std::size_t size, const LutFormat format, LutInfo<T>& info)
+    {
+        info = LutInfo<T>{};
+        info.format = format;
+        info.order = native_axis_order (format);
+        info.fileSize = size;
+
+        LutErrorCode::LutState err = LutErrorCode::LutState::OK;
+        switch (format)
+        {
+            case LutFormat::Cube:
+            {
+                CCubeLut3D<T> lut;
+                err = lut.LoadHeader (data, size, info.bodyOffset);
+                info.lutSize = lut.getLutSize();
+                info.componentSize.fill (info.lutSize);
+                info.title = lut.getTitle();
+                const auto domain = lut.getMinMaxDomain();
+                std::copy (domain.first.begin(),  domain.first.end(),  info.domainMin.begin());
+                std::copy (domain.second.begin(), domain.second.end(), info.domainMax.begin());
+            }
+            break;
+
+            case LutFormat::Lut3DL:
+            {
+                CLut3DL<T> lut;
+                err = lut.LoadHeader (data, size, info.bodyOffset);
+                info.lutSize = lut.getLutSize();
+                info.componentSize.fill (info.lutSize);
+                info.integerBody = lut.isIntegerBody();
+                info.inBits  = lut.getInputBitDepth();
+                info.outBits = lut.getOutputBitDepth();
+            }
+            break;
+
+            case LutFormat::CineSpace:
+            {
+                CCineSpaceLut3D<T> lut;
+                err = lut.LoadHeader (data, size, info.bodyOffset);
+                info.lutSize = lut.getLutSize();
+                info.componentSize[0] = lut.getLutComponentSize (LutElement::LutComponent::Red);
+                info.componentSize[1] = lut.getLutComponentSize (LutElement::LutComponent::Green);
+                info.componentSize[2] = lut.getLutComponentSize (LutElement::LutComponent::Blue);
+                info.title = lut.getTitle();
+                const auto domain = lut.getPreLutDomain();
+                std::copy (domain.first.begin(),  domain.first.end(),  info.domainMin.begin());
+                std::copy (domain.second.begin(), domain.second.end(), info.domainMax.begin());
+            }
+            break;
+
+            case LutFormat::Hald:
+            {
+                // IHDR is located in the first 33 bytes of PNG
+                std::istringstream stream (std::string (nullptr != data ? data : "", nullptr != data ? std::min(size, static_cast<std::size_t>(64u)) : 0u));
+                err = probe_stream (stream, info);
+            }
+            break;
+
+            default:
+                err = LutErrorCode::LutState::NonImplemented;
+            break;
+        }
+
+        if (LutErrorCode::LutState::OK == err && 0u == info.lutSize)
+            err = LutErrorCode::LutState::LutSizeUnknown;
+        return err;
+    }
+
+    // read LUT header from file; format detected by file name extension if not defined
+    template <typename T = float>
+    LutErrorCode::LutState probe_file (const std::string& fileName, LutInfo<T>& info, LutFormat format = LutFormat::Unknown)
+    {
+        if (LutFormat::Unknown == format)
+            format = format_from_name (fileName);
+        if (LutFormat::Unknown == format)
+        {
+            info = LutInfo<T>{};
+            return LutErrorCode::LutState::NonImplemented;
+        }
+
+        if (LutFormat::Hald == format)
+        {
+            info = LutInfo<T>{};
+            info.format = format;
+            info.order = native_axis_order (format);
+            std::ifstream file (fileName, std::ios::binary | std::ios::ate);
+            if (!file.good())
+                return LutErrorCode::LutState::FileNotOpened;
+            info.fileSize = static_cast<std::size_t>(file.tellg());
+            const LutErrorCode::LutState err = probe_stream (file, info);
+            return (LutErrorCode::LutState::OK == err && 0u == info.lutSize ? LutErrorCode::LutState::LutSizeUnknown : err);
+        }
+
+        const LutText::CMappedFile file { fileName };
+        if (!file.good())
+        {
+            info = LutInfo<T>{};
+            return LutErrorCode::LutState::FileNotOpened;
+        }
+        return probe_memory (file.data(), file.size(), format, info);
+    }
+
+
+    // LUT file handle: header probed on open, LUT body parsed on first access. All methods may be called
+    // concurrently; data returned by get_data() stays valid till next Unload() or Open() of the handle,
+    // so caller must not unload/reopen handle while other threads still use its data.
+    template <typename T>
+    class CLazyLut
+    {
+    public:
+        CLazyLut (void) = default;
+        CLazyLut (const CLazyLut&) = delete;
+        CLazyLut& operator = (const CLazyLut&) = delete;
+
+        LutErrorCode::LutState Open (const std::string& fileName, const LutFormat format = LutFormat::Unknown)
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            release();
+            m_fileName = fileName;
+            m_error = m_headerError = probe_file (fileName, m_info, format);
+            return m_error;
+        }
+
+        const LutInfo<T>& getInfo (void) const noexcept { return m_info; }
+        const std::string& getLutFileName (void) const noexcept { return m_fileName; }
+        LutErrorCode::LutState getLastError (void) const noexcept { return m_error.load (std::memory_order_acquire); }
+        bool isLoaded (void) const noexcept { return m_bLoaded.load (std::memory_order_acquire); }
+
+        // resource limits passed to loader of LUT body
+        void setLoadLimits (const LutLimits::LoadLimits& limits)
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            m_limits = limits;
+            return;
+        }
+
+        // parse LUT body if not parsed yet
+        LutErrorCode::LutState Load (void)
+        {
+            if (true == isLoaded())
+                return m_error;
+            std::lock_guard<std::mutex> lock (m_mutex);
+            return load();
+        }
+
+        // LUT body as returned by loader of file format (canonical axis order); empty if body could not be parsed
+        const LutElement::lutTable3D<T>& get_data (void)
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            if (LutErrorCode::LutState::OK == load())
+            {
+                if (nullptr != m_cube) return m_cube->get_data();
+                if (nullptr != m_3dl)  return m_3dl->get_data();
+                if (nullptr != m_csp)  return m_csp->get_data();
+                if (nullptr != m_hald) return m_hald->get_data();
+            }
+            return m_empty;
+        }
+
+        // drop parsed LUT body (invalidates data returned by get_data), header stays valid and body parsed
+        // again on next access
+        void Unload (void)
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            release();
+            m_error = m_headerError;
+            return;
+        }
+
+    private:
+        std::string m_fileName;
+        LutInfo<T> m_info;
+        std::atomic<LutErrorCode::LutState> m_error { LutErrorCode::LutState::NotInitialized };
+        LutErrorCode::LutState m_headerError = LutErrorCode::LutState::NotInitialized;
+        std::atomic<bool> m_bLoaded { false };
+        std::mutex m_mutex;
+        LutLimits::LoadLimits m_limits;
+        std::unique_ptr<CCubeLut3D<T>>      m_cube;
+        std::unique_ptr<CLut3DL<T>>         m_3dl;
+        std::unique_ptr<CCineSpaceLut3D<T>> m_csp;
+        std::unique_ptr<CHaldLut<T>>        m_hald;
+        const LutElement::lutTable3D<T>     m_empty {};
+
+        // parse LUT body if not parsed yet: called with mutex locked
+        LutErrorCode::LutState load (void)
+        {
+            if (true == m_bLoaded.load (std::memory_order_relaxed) || LutErrorCode::LutState::OK != m_error)
+                return m_error;
+
+            switch (m_info.format)
+            {
+                case LutFormat::Cube:
+                    m_cube.reset (new CCubeLut3D<T>);
+                    m_cube->setLoadLimits (m_limits);
+                    m_error = m_cube->LoadFile (m_fileName);
+                break;
+                case LutFormat::Lut3DL:
+                    m_3dl.reset (new CLut3DL<T>);
+                    m_3dl->setLoadLimits (m_limits);
+                    m_error = m_3dl->LoadFile (m_fileName);
+                break;
+                case LutFormat::CineSpace:
+                    m_csp.reset (new CCineSpaceLut3D<T>);
+                    m_csp->setLoadLimits (m_limits);
+                    m_error = m_csp->LoadFile (m_fileName);
+                break;
+                case LutFormat::Hald:
+                    m_hald.reset (new CHaldLut<T>);
+                    m_hald->setLoadLimits (m_limits);
+                    m_error = m_hald->LoadFile (m_fileName);
+                break;
+                default:
+                    m_error = LutErrorCode::LutState::NonImplemented;
+                break;
+            }
+            m_bLoaded.store (true, std::memory_order_release);
+            return m_error;
+        }
+
+        void release (void)
+        {
+            m_cube.reset();
+            m_3dl.reset();
+            m_csp.reset();
+            m_hald.reset();
+            m_bLoaded.store (false, std::memory_order_release);
+            return;
+        }
+    };
+
+} // namespace LutProbe
+
+#endif /* __LUT_LIBRARY_LUT_PROBE__ */
@@ -0,0 +1,568 @@
+#ifndef __LUT_LIBRARY_LUT_STREAM__
+#define __LUT_LIBRARY_LUT_STREAM__
+
+#include "lutElement.h"
+#include "lutErrors.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include "lutProbe.h"
+#include "text_tokenizer.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+   Streaming conversion of text 3D LUTs (Cube, 3DL, CSP) without materializing LUT body.
+
+   Row reader parses source header with loader's LoadHeader() and then returns body rows one chunk at time
+   (normalized: integer 3DL code values scaled to [0...1]). Row writer formats rows of target format. Reader
+   runs on producer thread and passes rows to writer through bounded ring buffer, so memory footprint is
+   fixed by chunk and ring sizes and does not depend on LUT size; already parsed part of memory mapped
+   source is dropped from working set as reading progresses.
+
+   If target format iterates lattice in other axis order (Cube/CSP red fastest, 3DL blue fastest), the
+   first target rows are spread over complete source body. Target order then produced by blocks: each
+   pass over source collects nodes of K consecutive values of target slowest axis (K * N * N rows) into
+   block buffer and emits block in target order. K chosen from block budget (at least one N x N slab),
+   so memory stays bounded at cost of N / K parsing passes over source.
+
+   Input domain passed from source to target header: Cube DOMAIN_MIN/MAX, CSP pre-LUT (only pre-LUT linear
+   over its input range is equal to domain - other CSP sources rejected with NonImplemented). 3DL has no
+   domain, so source with non-default domain can not be written as 3DL.
+*/
+namespace LutStream
+{
+    using LutFormat = LutElement::LutFormat;
+
+    constexpr std::size_t streamChunkRows    = 4096u;                   // rows moved between reader, ring and writer at once
+    constexpr std::size_t streamRingRows     = 4u * streamChunkRows;    // ring buffer capacity
+    constexpr std::size_t streamBlockBytes   = 16u * 1024u * 1024u;     // reorder block budget
+    constexpr std::size_t streamReleaseBytes = 8u * 1024u * 1024u;      // mapped source dropped from working set by this step
+    constexpr std::size_t streamWriteBytes   = 256u * 1024u;            // formatted output flushed by this step
+
+    struct StreamOptions
+    {
+        std::size_t ringRows   = streamRingRows;
+        std::size_t blockBytes = streamBlockBytes;
+        uint32_t    inBits     = 10u;   // 3DL target: bit depth of grid line code values
+        uint32_t    outBits    = 12u;   // 3DL target: bit depth of body code values
+        int32_t     decimals   = 6;     // Cube and CSP targets: digits after decimal point
+    };
+
+    // source header as reported by probe: size, domain, title and axis order of body in file
+    template <typename T>
+    using StreamHeader = LutProbe::LutInfo<T>;
+
+    using LutProbe::native_axis_order;
+
+
+    // Bounded single producer / single consumer queue of LUT rows (3 values per row).
+    template <typename T>
+    class CRowRing
+    {
+    public:
+        explicit CRowRing (const std::size_t capacityRows) : m_buffer (std::max(capacityRows, static_cast<std::size_t>(1u)) * 3u) {}
+
+        CRowRing (const CRowRing&) = delete;
+        CRowRing& operator = (const CRowRing&) = delete;
+
+        std::size_t capacity (void) const noexcept { return m_buffer.size() / 3u; }
+
+        // copy rows into ring, blocks while ring is full; false if consumer cancelled ring
+        bool Push (const T* rows, std::size_t count)
+        {
+            const std::size_t cap = capacity();
+            while (0u != count)
+            {
+                std::unique_lock<std::mutex> lock (m_mutex);
+                m_notFull.wait (lock, [&] { return m_bCancelled || m_count < cap; });
+                if (true == m_bCancelled)
+                    return false;
+                const std::size_t tail = (m_head + m_count) % cap;
+                const std::size_t n = std::min(count, std::min(cap - m_count, cap - tail));
+                std::copy (rows, rows + n * 3u, m_buffer.begin() + tail * 3u);
+                m_count += n;
+                rows  += n * 3u;
+                count -= n;
+                lock.unlock();
+                m_notEmpty.notify_one();
+            }
+            return true;
+        }
+
+        // move up to 'maxRows' rows out of ring, blocks while ring is empty; 0 when producer closed ring and all rows consumed
+        std::size_t Pop (T* rows, const std::size_t maxRows)
+        {
+            const std::size_t cap = capacity();
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_notEmpty.wait (lock, [&] { return m_bCancelled || m_bClosed || 0u != m_count; });
+            if (true == m_bCancelled)
+                return 0u;
+            const std::size_t n = std::min(maxRows, std::min(m_count, cap - m_head));
+            std::copy (m_buffer.begin() + m_head * 3u, m_buffer.begin() + (m_head + n) * 3u, rows);
+            m_head = (m_head + n) % cap;
+            m_count -= n;
+            lock.unlock();
+            m_notFull.notify_one();
+            return n;
+        }
+
+        // producer: no more rows
+        void Close (void)
+        {
+            { std::lock_guard<std::mutex> lock (m_mutex); m_bClosed = true; }
+            m_notEmpty.notify_all();
+            return;
+        }
+
+        // consumer: stop producer, rows not consumed yet dropped
+        void Cancel (void)
+        {
+            { std::lock_guard<std::mutex> lock (m_mutex); m_bCancelled = true; }
+            m_notFull.notify_all();
+            m_notEmpty.notify_all();
+            return;
+        }
+
+    private:
+        std::vector<T> m_buffer;
+        std::size_t m_head  = 0u;
+        std::size_t m_count = 0u;
+        bool m_bClosed    = false;
+        bool m_bCancelled = false;
+        std::mutex m_mutex;
+        std::condition_variable m_notFull;
+        std::condition_variable m_notEmpty;
+    };
+
+
+    // Sequential reader of LUT body rows in file order.
+    template <typename T>
+    class CLutRowReader
+    {
+    public:
+        LutErrorCode::LutState Open (const std::string& fileName, const LutFormat format)
+        {
+            if (false == m_file.open (fileName))
+                return (m_error = LutErrorCode::LutState::FileNotOpened);
+            return open (m_file.data(), m_file.size(), format);
+        }
+
+        // source buffer not copied and must outlive reader
+        LutErrorCode::LutState OpenMemory (const char* data, const std::size_t size, const LutFormat format)
+        {
+            m_file.close();
+            return open (data, size, format);
+        }
+
+        const StreamHeader<T>& getHeader (void) const noexcept { return m_header; }
+        LutErrorCode::LutState getLastError (void) const noexcept { return m_error; }
+        std::size_t getRowsNumber (void) const noexcept { return m_rows; }
+        std::size_t getRowsRead (void) const noexcept { return m_read; }
+
+        // restart reading from the first body row
+        void Rewind (void)
+        {
+            m_text = LutText::CTextTokenizer (m_body, m_bodySize, m_separator);
+            m_read = m_released = 0u;
+            if (LutErrorCode::LutState::OK == m_openError)
+                m_error = LutErrorCode::LutState::OK;
+            return;
+        }
+
+        // read up to 'maxRows' next rows; returns number of rows read, 0 at the end of body or on error (see getLastError)
+        std::size_t Read (T* rows, const std::size_t maxRows)
+        {
+            if (LutErrorCode::LutState::OK != m_error)
+                return 0u;
+
+            std::size_t n = 0u;
+            string_view line;
+            while (n < maxRows && m_read < m_rows)
+            {
+                if (false == m_text.next_line (line))
+                {
+                    m_error = LutErrorCode::LutState::PrematureEndOfFile;
+                    break;
+                }
+                line = LutText::trim (line);
+                if (0u == line.size() || false == is_row (line))
+                    continue;
+                if (false == parse_row (line, rows + n * 3u))
+                {
+                    m_error = LutErrorCode::LutState::CouldNotParseTableData;
+                    break;
+                }
+                n++;
+                m_read++;
+            }
+
+            const std::size_t consumed = static_cast<std::size_t>(m_body - m_file.data()) + m_text.position();
+            if (nullptr != m_file.data() && consumed - m_released >= streamReleaseBytes)
+            {
+                m_file.release (consumed);
+                m_released = consumed;
+            }
+            return n;
+        }
+
+    private:
+        LutText::CMappedFile    m_file;
+        LutText::CTextTokenizer m_text { nullptr, 0u };
+        StreamHeader<T>         m_header;
+        LutFormat               m_format = LutFormat::Cube;
+        LutErrorCode::LutState  m_error     = LutErrorCode::LutState::NotInitialized;
+        LutErrorCode::LutState  m_openError = LutErrorCode::LutState::NotInitialized;
+        const char*             m_body = nullptr;
+        std::size_t             m_bodySize = 0u;
+        std::size_t             m_rows = 0u;
+        std::size_t             m_read = 0u;
+        std::size_t             m_released = 0u;
+        T                       m_scale = static_cast<T>(1);
+        bool                    m_bInteger = false;
+        char                    m_separator = '\n';
+
+        LutErrorCode::LutState open (const char* data, const std::size_t size, const LutFormat format)
+        {
+            m_format = format;
+            m_scale = static_cast<T>(1);
+            m_body = nullptr;
+            m_bodySize = m_rows = 0u;
+
+            LutErrorCode::LutState err = (LutFormat::Hald == format ? LutErrorCode::LutState::NonImplemented : LutProbe::probe_memory (data, size, format, m_header));
+            m_bInteger = m_header.integerBody;
+            if (LutErrorCode::LutState::OK == err &&
+                (m_header.componentSize[0] != m_header.lutSize || m_header.componentSize[1] != m_header.lutSize || m_header.componentSize[2] != m_header.lutSize))
+                err = LutErrorCode::LutState::LutSizeInvalid;
+            if (LutErrorCode::LutState::OK == err && LutFormat::CineSpace == format)
+            {
+                // header domain holds pre-LUT input range: valid only if pre-LUT is linear mapping of it
+                CCineSpaceLut3D<T> csp;
+                std::size_t bodyOffset = 0u;
+                if (LutErrorCode::LutState::OK != csp.LoadHeader (data, size, bodyOffset) || false == csp.isLinearPreLut())
+                    err = LutErrorCode::LutState::NonImplemented;
+            }
+
+            if (LutErrorCode::LutState::OK == err)
+            {
+                m_separator = LutText::CTextTokenizer (data, size).separator();
+                m_body = data + m_header.bodyOffset;
+                m_bodySize = size - m_header.bodyOffset;
+                m_rows = m_header.lutSize * m_header.lutSize * m_header.lutSize;
+                if (true == m_bInteger)
+                {
+                    // output bit depth not declared in comments: defined by maximal code value of body
+                    const uint32_t bits = (0u != m_header.outBits ? m_header.outBits :
+                                           CLut3DL<T>::bits_for_value (static_cast<double>(max_code_value (m_body, m_bodySize))));
+                    m_scale = static_cast<T>(1) / static_cast<T>((1u << bits) - 1u);
+                }
+            }
+            m_openError = err;
+            Rewind();
+            m_error = err;
+            return err;
+        }
+
+        bool is_row (const string_view& line) const noexcept
+        {
+            switch (m_format)
+            {
+                case LutFormat::Cube:   return ('#' != line[0]);
+                case LutFormat::Lut3DL: return LutText::is_number_start (line[0]);
+                default:                return true;
+            }
+        }
+
+        bool parse_row (const string_view& line, T* row) const noexcept
+        {
+            if (false == m_bInteger)
+                return (3u == LutText::parse_numbers (line, row, 3u));
+            uint16_t code[3];
+            if (3u != LutText::parse_numbers (line, code, 3u))
+                return false;
+            for (std::size_t c = 0u; c < 3u; c++)
+                row[c] = static_cast<T>(code[c]) * m_scale;
+            return true;
+        }
+
+        // maximal code value of integer 3DL body (one sequential pass, nothing stored)
+        static uint16_t max_code_value (const char* body, const std::size_t size)
+        {
+            LutText::CTextTokenizer text (body, size);
+            string_view line, token;
+            uint16_t maxValue = 0u, value = 0u;
+            while (text.next_line (line))
+            {
+                line = LutText::trim (line);
+                if (0u == line.size() || false == LutText::is_number_start (line[0]))
+                    continue;
+                while (LutText::next_token (line, token))
+                    if (true == LutText::parse_number (token, value))
+                        maxValue = std::max(maxValue, value);
+            }
+            return maxValue;
+        }
+    };
+
+
+    // Sequential writer of LUT rows given in target format axis order.
+    template <typename T>
+    class CLutRowWriter
+    {
+    public:
+        LutErrorCode::LutState Open (const std::string& fileName, const LutFormat format, const StreamHeader<T>& header, const StreamOptions& options = {})
+        {
+            m_file.open (fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!m_file.good())
+                return LutErrorCode::LutState::FileNotOpened;
+            return Open (m_file, format, header, options);
+        }
+
+        // stream not owned and must outlive writer
+        LutErrorCode::LutState Open (std::ostream& out, const LutFormat format, const StreamHeader<T>& header, const StreamOptions& options = {})
+        {
+            m_out = &out;
+            m_format = format;
+            m_lutSize = header.lutSize;
+            m_rows = 0u;
+            m_decimals = std::max(0, std::min(options.decimals, 17));
+            m_codeMax = static_cast<T>((1u << std::max(1u, std::min(options.outBits, 16u))) - 1u);
+            m_buffer.clear();
+            m_buffer.reserve (streamWriteBytes + 256u);
+            if (m_lutSize < 2u || m_lutSize > LutElement::lut3DMaxSize)
+                return LutErrorCode::LutState::LutSizeOutOfRange;
+
+            const std::string size = std::to_string (m_lutSize);
+            const bool bDefaultDomain = (header.domainMin == StreamHeader<T>{}.domainMin && header.domainMax == StreamHeader<T>{}.domainMax);
+            switch (format)
+            {
+                case LutFormat::Cube:
+                    if (0u != header.title.size())
+                        m_buffer += "TITLE \"" + header.title + "\"\n";
+                    if (false == bDefaultDomain)
+                    {
+                        m_buffer += "DOMAIN_MIN";
+                        for (const T& v : header.domainMin) { m_buffer += ' '; append_value (v); }
+                        m_buffer += "\nDOMAIN_MAX";
+                        for (const T& v : header.domainMax) { m_buffer += ' '; append_value (v); }
+                        m_buffer += '\n';
+                    }
+                    m_buffer += "LUT_3D_SIZE " + size + "\n";
+                break;
+
+                case LutFormat::Lut3DL:
+                {
+                    if (false == bDefaultDomain)
+                        return LutErrorCode::LutState::NonImplemented;
+                    // grid line: input code values of lattice nodes
+                    const double gridMax = static_cast<double>((1u << std::max(1u, std::min(options.inBits, 16u))) - 1u);
+                    for (std::size_t i = 0u; i < m_lutSize; i++)
+                    {
+                        m_buffer += std::to_string (static_cast<uint32_t>(std::lround (gridMax * static_cast<double>(i) / static_cast<double>(m_lutSize - 1u))));
+                        m_buffer += (i + 1u < m_lutSize ? ' ' : '\n');
+                    }
+                }
+                break;
+
+                case LutFormat::CineSpace:
+                    // identity pre-LUT maps input domain of every channel to [0...1]
+                    m_buffer += "CSPLUTV100\n3D\n\n";
+                    if (0u != header.title.size())
+                        m_buffer += "BEGIN METADATA\n" + header.title + "\nEND METADATA\n\n";
+                    for (std::size_t c = 0u; c < 3u; c++)
+                    {
+                        m_buffer += "2\n";
+                        append_value (header.domainMin[c]); m_buffer += ' '; append_value (header.domainMax[c]);
+                        m_buffer += "\n0 1\n";
+                    }
+                    m_buffer += "\n" + size + " " + size + " " + size + "\n";
+                break;
+
+                default:
+                    return LutErrorCode::LutState::NonImplemented;
+            }
+            return flush (false);
+        }
+
+        LutElement::AxisOrder getAxisOrder (void) const noexcept { return native_axis_order (m_format); }
+
+        LutErrorCode::LutState Write (const T* rows, const std::size_t count)
+        {
+            if (nullptr == m_out || m_rows + count > m_lutSize * m_lutSize * m_lutSize)
+                return LutErrorCode::LutState::WriteError;
+
+            for (std::size_t i = 0u; i < count; i++, rows += 3u)
+            {
+                for (std::size_t c = 0u; c < 3u; c++)
+                {
+                    if (0u != c)
+                        m_buffer += ' ';
+                    if (LutFormat::Lut3DL == m_format)
+                        append_code (rows[c]);
+                    else
+                        append_value (rows[c]);
+                }
+                m_buffer += '\n';
+                if (m_buffer.size() >= streamWriteBytes && LutErrorCode::LutState::OK != flush (false))
+                    return LutErrorCode::LutState::WriteError;
+            }
+            m_rows += count;
+            return LutErrorCode::LutState::OK;
+        }
+
+        // flush formatted rows; fails if not all LUT rows written
+        LutErrorCode::LutState Close (void)
+        {
+            if (nullptr == m_out)
+                return LutErrorCode::LutState::NotInitialized;
+            LutErrorCode::LutState err = flush (true);
+            if (LutErrorCode::LutState::OK == err && m_rows != m_lutSize * m_lutSize * m_lutSize)
+                err = LutErrorCode::LutState::PrematureEndOfFile;
+            if (m_file.is_open())
+                m_file.close();
+            m_out = nullptr;
+            return err;
+        }
+
+    private:
+        std::ofstream       m_file;
+        std::ostream*       m_out = nullptr;
+        std::string         m_buffer;
+        LutFormat           m_format = LutFormat::Cube;
+        LutElement::lutSize m_lutSize = 0u;
+        std::size_t         m_rows = 0u;
+        int32_t             m_decimals = 6;
+        T                   m_codeMax = static_cast<T>(4095);
+
+        void append_value (const T value)
+        {
+            char str[64];
+            const int len = std::snprintf (str, sizeof(str), "%.*f", static_cast<int>(m_decimals), static_cast<double>(value));
+            if (len > 0)
+                m_buffer.append (str, std::min(static_cast<std::size_t>(len), sizeof(str) - 1u));
+            return;
+        }
+
+        // normalized value to integer code value of 3DL body
+        void append_code (const T value)
+        {
+            const T clamped = std::min(std::max(value, static_cast<T>(0)), static_cast<T>(1));
+            m_buffer += std::to_string (static_cast<uint32_t>(std::lround (static_cast<double>(clamped * m_codeMax))));
+            return;
+        }
+
+        LutErrorCode::LutState flush (const bool bFinal)
+        {
+            m_out->write (m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_buffer.clear();
+            if (true == bFinal)
+                m_out->flush();
+            return (m_out->good() ? LutErrorCode::LutState::OK : LutErrorCode::LutState::WriteError);
+        }
+    };
+
+
+    // Pass all rows of opened reader to opened writer: reader runs on producer thread, rows converted to writer
+    // axis order by blocks if orders differ. Writer closed on success.
+    template <typename T>
+    LutErrorCode::LutState stream_rows (CLutRowReader<T>& reader, CLutRowWriter<T>& writer, const StreamOptions& options = {})
+    {
+        if (LutErrorCode::LutState::OK != reader.getLastError())
+            return reader.getLastError();
+
+        CRowRing<T> ring (std::max(options.ringRows, streamChunkRows));
+
+        auto produce = [&]()
+        {
+            std::vector<T> chunk (streamChunkRows * 3u);
+            std::size_t n = 0u;
+            if (reader.getHeader().order == writer.getAxisOrder())
+            {
+                while (0u != (n = reader.Read (chunk.data(), streamChunkRows)))
+                    if (false == ring.Push (chunk.data(), n))
+                        break;
+            }
+            else
+            {
+                // source row (slow = s2, middle = s1, fast = s0) goes to target row (slow = s0, middle = s1, fast = s2)
+                const std::size_t N = reader.getHeader().lutSize;
+                const std::size_t slabRows = N * N;
+                const std::size_t K = std::min(N, std::max(static_cast<std::size_t>(1u), options.blockBytes / (slabRows * 3u * sizeof(T))));
+                std::vector<T> block (K * slabRows * 3u);
+                bool bActive = true;
+                for (std::size_t first = 0u; first < N && true == bActive; first += K)
+                {
+                    const std::size_t last = std::min(first + K, N);
+                    std::size_t idx = 0u;
+                    reader.Rewind();
+                    while (0u != (n = reader.Read (chunk.data(), streamChunkRows)))
+                    {
+                        for (std::size_t i = 0u; i < n; i++, idx++)
+                        {
+                            const std::size_t s0 = idx % N;
+                            if (s0 < first || s0 >= last)
+                                continue;
+                            const std::size_t dst = (((s0 - first) * N + (idx / N) % N) * N + idx / slabRows) * 3u;
+                            std::copy (chunk.data() + i * 3u, chunk.data() + i * 3u + 3u, block.data() + dst);
+                        }
+                    }
+                    bActive = (LutErrorCode::LutState::OK == reader.getLastError() && true == ring.Push (block.data(), (last - first) * slabRows));
+                }
+            }
+            ring.Close();
+        };
+
+        std::thread producer (produce);
+        std::vector<T> chunk (streamChunkRows * 3u);
+        LutErrorCode::LutState writeError = LutErrorCode::LutState::OK;
+        std::size_t n = 0u;
+        while (0u != (n = ring.Pop (chunk.data(), streamChunkRows)))
+        {
+            if (LutErrorCode::LutState::OK != (writeError = writer.Write (chunk.data(), n)))
+            {
+                ring.Cancel();
+                break;
+            }
+        }
+        producer.join();
+
+        if (LutErrorCode::LutState::OK != reader.getLastError())
+            return reader.getLastError();
+        return (LutErrorCode::LutState::OK != writeError ? writeError : writer.Close());
+    }
+
+
+    // convert LUT file from one text format to another with constant memory footprint
+    template <typename T = float>
+    LutErrorCode::LutState convert_lut
+    (
+        const std::string& srcFileName,
+        const LutFormat srcFormat,
+        const std::string& dstFileName,
+        const LutFormat dstFormat,
+        const StreamOptions& options = {}
+    )
+    {
+        CLutRowReader<T> reader;
+        LutErrorCode::LutState err = reader.Open (srcFileName, srcFormat);
+        if (LutErrorCode::LutState::OK != err)
+            return err;
+        CLutRowWriter<T> writer;
+        if (LutErrorCode::LutState::OK != (err = writer.Open (dstFileName, dstFormat, reader.getHeader(), options)))
+            return err;
+        return stream_rows (reader, writer, options);
+    }
+
+} // namespace LutStream
+
+#endif /* __LUT_LIBRARY_LUT_STREAM__ */
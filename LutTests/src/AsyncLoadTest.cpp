@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include "lutAsync.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include "lutHald.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <string>
+#include <thread>
+
+const std::string cubeLutsFolder = { CUBE_3D_LUT_FOLDER };
+const std::string cspLutsFolder  = { CSP_LUT_FOLDER };
+const std::string trdlLutsFolder = { TrDL_LUT_FOLDER };
+const std::string haldLutsFolder = { HALD_LUT_FOLDER };
+
+
+// 65^3 Cube file, big enough for several budget checks per parse chunk
+static std::string write_cube_65 (void)
+{
+	const std::string fileName { cubeLutsFolder + "/Async65.cube" };
+	std::ofstream file (fileName, std::ios::trunc);
+	constexpr uint32_t size = 65u;
+	file << "LUT_3D_SIZE " << size << "\n";
+	const double scale = 1.0 / static_cast<double>(size - 1u);
+	for (uint32_t b = 0u; b < size; b++)
+		for (uint32_t g = 0u; g < size; g++)
+			for (uint32_t r = 0u; r < size; r++)
+				file << r * scale << " " << g * scale << " " << b * scale << "\n";
+	return fileName;
+}
+
+// occupy all threads of I/O pool till returned promise set
+static std::promise<void> block_io_pool (void)
+{
+	std::promise<void> release;
+	std::shared_future<void> gate = release.get_future().share();
+	auto blocked = std::make_shared<std::atomic<uint32_t>>(0u);
+	const uint32_t threads = LutParallel::io_pool().size();
+	for (uint32_t i = 0u; i < threads; i++)
+		LutParallel::io_pool().post ([gate, blocked]() { (*blocked)++; gate.wait(); });
+	while (blocked->load() < threads)
+		std::this_thread::yield();
+	return release;
+}
+
+
+TEST (AsyncLoad, Cube_SameAsSync)
+{
+	const std::string lutName { cubeLutsFolder + "/MagicHour.cube" };
+	CCubeLut3D<float> sync, async;
+	ASSERT_EQ(sync.LoadFile (lutName), LutErrorCode::LutState::OK);
+
+	std::size_t lastDone = 0u, lastTotal = 0u, calls = 0u;
+	LutAsync::CLoadHandle handle = async.LoadFileAsync (lutName, [&](const std::size_t done, const std::size_t total)
+	{
+		lastDone = done, lastTotal = total, calls++;
+	});
+	ASSERT_TRUE(handle.valid());
+	EXPECT_EQ(handle.wait(), LutErrorCode::LutState::OK);
+	EXPECT_EQ(handle.status(), LutErrorCode::LutState::OK);
+	EXPECT_TRUE(async.get_data() == sync.get_data());
+
+	// complete LUT body reported as parsed
+	EXPECT_GT(calls, 0u);
+	EXPECT_GT(lastTotal, 0u);
+	EXPECT_EQ(lastDone, lastTotal);
+	EXPECT_EQ(handle.progress(), std::make_pair (lastDone, lastTotal));
+}
+
+TEST (AsyncLoad, AllFormats)
+{
+	CLut3DL<float> lut3dl, sync3dl;
+	CCineSpaceLut3D<float> csp, syncCsp;
+	CHaldLut<float> hald, syncHald;
+
+	std::size_t inflated = 0u, inflateTotal = 0u;
+	auto h3dl = lut3dl.LoadFileAsync (trdlLutsFolder + "/Fuji_XTrans_III-Sepia.3dl");
+	auto hCsp = csp.LoadFileAsync (cspLutsFolder + "/linear_3D.csp");
+	auto hHald = hald.LoadFileAsync (haldLutsFolder + "/contrast.HCLUT.png", [&](const std::size_t done, const std::size_t total)
+	{
+		inflated = done, inflateTotal = total;
+	});
+
+	EXPECT_EQ(h3dl.wait(), LutErrorCode::LutState::OK);
+	EXPECT_EQ(hCsp.wait(), LutErrorCode::LutState::OK);
+	EXPECT_EQ(hHald.wait(), LutErrorCode::LutState::OK);
+
+	ASSERT_EQ(sync3dl.LoadFile (trdlLutsFolder + "/Fuji_XTrans_III-Sepia.3dl"), LutErrorCode::LutState::OK);
+	ASSERT_EQ(syncCsp.LoadFile (cspLutsFolder + "/linear_3D.csp"), LutErrorCode::LutState::OK);
+	ASSERT_EQ(syncHald.LoadFile (haldLutsFolder + "/contrast.HCLUT.png"), LutErrorCode::LutState::OK);
+	EXPECT_TRUE(lut3dl.get_data() == sync3dl.get_data());
+	EXPECT_TRUE(csp.get_data() == syncCsp.get_data());
+	EXPECT_TRUE(hald.get_data() == syncHald.get_data());
+
+	// 512 x 512 RGB 8 bits image: rows of filter byte and 512 pixels inflated
+	EXPECT_EQ(inflateTotal, 512u * (1u + 512u * 3u));
+	EXPECT_EQ(inflated, inflateTotal);
+}
+
+TEST (AsyncLoad, PendedAndCancelledBeforeStart)
+{
+	const std::string lutName { cubeLutsFolder + "/Small25.cube" };
+	std::promise<void> release = block_io_pool();
+
+	CCubeLut3D<float> cancelled, loaded;
+	LutAsync::CLoadHandle h1 = cancelled.LoadFileAsync (lutName);
+	LutAsync::CLoadHandle h2 = loaded.LoadFileAsync (lutName);
+	EXPECT_EQ(h1.status(), LutErrorCode::LutState::AsyncIoPended);
+	EXPECT_EQ(h2.wait_for (std::chrono::milliseconds (10)), LutErrorCode::LutState::AsyncIoPended);
+
+	h1.cancel();
+	release.set_value();
+	EXPECT_EQ(h1.wait(), LutErrorCode::LutState::Cancelled);
+	EXPECT_EQ(h2.wait(), LutErrorCode::LutState::OK);
+	EXPECT_TRUE(cancelled.get_data().empty());
+	EXPECT_EQ(loaded.getLutSize(), 25u);
+
+	LutAsync::CLoadHandle none;
+	EXPECT_FALSE(none.valid());
+	EXPECT_EQ(none.status(), LutErrorCode::LutState::NotInitialized);
+}
+
+TEST (AsyncLoad, Pool_Destroyed_Before_Start)
+{
+	std::promise<void> release;
+	std::shared_future<void> gate = release.get_future().share();
+	std::atomic<bool> started { false };
+	LutAsync::CLoadHandle handle;
+	bool loadCalled = false;
+	{
+		// single worker busy, load pending when pool destroyed; last dropped task releases worker
+		LutParallel::CIoPool pool (1u);
+		pool.post ([gate, &started]() { started = true; gate.wait(); });
+		while (false == started.load())
+			std::this_thread::yield();
+		handle = LutAsync::launch (LutLimits::LoadLimits{}, [&loadCalled](const LutLimits::CLoadBudget&)
+		{
+			loadCalled = true;
+			return LutErrorCode::LutState::OK;
+		}, nullptr, pool);
+		pool.post ([]() {}, [&release]() { release.set_value(); });
+	}
+	EXPECT_EQ(handle.wait(), LutErrorCode::LutState::Cancelled);
+	EXPECT_EQ(handle.status(), LutErrorCode::LutState::Cancelled);
+	EXPECT_FALSE(loadCalled);
+}
+
+TEST (AsyncLoad, CancelledWhileParsing)
+{
+	const std::string lutName = write_cube_65();
+
+	// cancel requested from the first progress report: parsing stopped on the next budget check
+	std::promise<void> ready;
+	std::shared_future<void> handleReady = ready.get_future().share();
+	LutAsync::CLoadHandle handle;
+	CCubeLut3D<float> lut;
+	handle = lut.LoadFileAsync (lutName, [&](const std::size_t, const std::size_t)
+	{
+		handleReady.wait();
+		handle.cancel();
+	});
+	ready.set_value();
+	EXPECT_EQ(handle.wait(), LutErrorCode::LutState::Cancelled);
+	EXPECT_LT(handle.progress().first, handle.progress().second);
+
+	// the same file loaded completely without cancellation
+	CCubeLut3D<float> complete;
+	EXPECT_EQ(complete.LoadFileAsync (lutName).wait(), LutErrorCode::LutState::OK);
+	EXPECT_EQ(complete.getLutSize(), 65u);
+}
+
+TEST (AsyncLoad, Overlap_Time)
+{
+	// async load of big LUT while calling thread continues its own work
+	const std::string lutName = write_cube_65();
+	CCubeLut3D<float> lut;
+	auto const start = std::chrono::high_resolution_clock::now();
+	LutAsync::CLoadHandle handle = lut.LoadFileAsync (lutName);
+	auto const posted = std::chrono::high_resolution_clock::now();
+	uint64_t polls = 0u;
+	while (LutErrorCode::LutState::AsyncIoPended == handle.status())
+	{
+		polls++;
+		std::this_thread::sleep_for (std::chrono::microseconds (100));
+	}
+	auto const stop = std::chrono::high_resolution_clock::now();
+	EXPECT_EQ(handle.status(), LutErrorCode::LutState::OK);
+	std::cout << "LoadFileAsync returned in " << std::chrono::duration<double, std::micro>(posted - start).count() << " us, load completed in "
+	          << std::chrono::duration<double, std::milli>(stop - start).count() << " ms (" << polls << " polls of caller)" << std::endl;
+}
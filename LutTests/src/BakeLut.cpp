@@ -0,0 +1,172 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <stdexcept>
+
+const std::string dbgLutsFolder = { CUBE_3D_LUT_FOLDER };
+
+// simple "look" for bake: per-channel gamma and slight cross-talk
+template <typename T>
+std::array<T, 3> look (T r, T g, T b)
+{
+    return { std::pow(r, static_cast<T>(0.9)), static_cast<T>(0.8) * g + static_cast<T>(0.2) * b, static_cast<T>(1) - b };
+}
+
+
+TEST (BakeLut, Bake_Identity_Cube3D_f32)
+{
+    constexpr LutElement::lutSize lutSize = 33u;
+    CCubeLut3D<float> lut;
+    auto const result = LutBaker::Bake (lut, lutSize, [](float r, float g, float b) { return std::array<float, 3>{ r, g, b }; });
+    EXPECT_EQ(result, LutErrorCode::LutState::OK);
+    EXPECT_EQ(lut.getLutSize(), lutSize);
+
+    const auto& body = lut.get_data();
+    ASSERT_EQ(body.size(), lutSize * lutSize * lutSize * 3u);
+
+    // red changes fastest, than green, than blue
+    int errors = 0;
+    for (size_t b = 0; b < lutSize; b++)
+        for (size_t g = 0; g < lutSize; g++)
+            for (size_t r = 0; r < lutSize; r++)
+            {
+                const size_t idx = ((b * lutSize + g) * lutSize + r) * 3u;
+                if (body[idx + 0] != static_cast<float>(r) / 32.f ||
+                    body[idx + 1] != static_cast<float>(g) / 32.f ||
+                    body[idx + 2] != static_cast<float>(b) / 32.f)
+                    errors++;
+            }
+    EXPECT_EQ(errors, 0);
+}
+
+
+TEST (BakeLut, Bake_Block_Equal_Point_Cube3D_f64)
+{
+    constexpr LutElement::lutSize lutSize = 65u;
+    CCubeLut3D<double> lutPoint, lutBlock, lutSingleThread;
+
+    auto const t0 = std::chrono::high_resolution_clock::now();
+    auto const resultPoint = LutBaker::Bake (lutPoint, lutSize, look<double>);
+    auto const t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Bake 65x65x65 LUT: " << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() << " us" << std::endl;
+
+    auto const resultBlock = LutBaker::Bake (lutBlock, lutSize,
+        [](const double* in, double* out, size_t points)
+        {
+            for (size_t i = 0; i < points; i++, in += 3, out += 3)
+            {
+                const auto v = look (in[0], in[1], in[2]);
+                out[0] = v[0], out[1] = v[1], out[2] = v[2];
+            }
+        });
+
+    auto const resultSingle = LutBaker::Bake (lutSingleThread, lutSize, look<double>, 1u);
+
+    EXPECT_EQ(resultPoint,  LutErrorCode::LutState::OK);
+    EXPECT_EQ(resultBlock,  LutErrorCode::LutState::OK);
+    EXPECT_EQ(resultSingle, LutErrorCode::LutState::OK);
+    EXPECT_TRUE(lutPoint.get_data() == lutSingleThread.get_data());
+
+    // Point and block functors are inlined into different loops, so -ffast-math and FMA contraction
+    // may fuse the multiply-adds of look() differently: results agree to rounding, not bit exactly.
+    const auto& pointBody = lutPoint.get_data();
+    const auto& blockBody = lutBlock.get_data();
+    ASSERT_EQ(pointBody.size(), blockBody.size());
+    size_t mismatch = 0;
+    for (size_t i = 0; i < pointBody.size(); i++)
+        if (std::abs(pointBody[i] - blockBody[i]) > 1e-12)
+            mismatch++;
+    EXPECT_EQ(mismatch, 0u);
+}
+
+
+TEST (BakeLut, Bake_Custom_Domain_Cube3D_f32)
+{
+    CCubeLut3D<float> lut;
+    const LutElement::lutTableRaw<float> dMin{ -1.f, 0.f, 0.f };
+    const LutElement::lutTableRaw<float> dMax{  1.f, 2.f, 4.f };
+    auto const result = LutBaker::Bake (lut, 5u, dMin, dMax, [](float r, float g, float b) { return std::array<float, 3>{ r, g, b }; });
+    EXPECT_EQ(result, LutErrorCode::LutState::OK);
+
+    const auto& body = lut.get_data();
+    const size_t last = body.size() - 3u;
+    EXPECT_EQ(body[0], -1.f);
+    EXPECT_EQ(body[3],  -0.5f);
+    EXPECT_EQ(body[last + 0], 1.f);
+    EXPECT_EQ(body[last + 1], 2.f);
+    EXPECT_EQ(body[last + 2], 4.f);
+
+    CCubeLut3D<float> lutReversed;
+    EXPECT_EQ(LutBaker::Bake (lutReversed, 5u, dMax, dMin, look<float>), LutErrorCode::LutState::DomainBoundReversed);
+}
+
+
+TEST (BakeLut, Bake_Cube1D_f32)
+{
+    constexpr LutElement::lutSize lutSize = 1024u;
+    CCubeLut1D<float> lut;
+    auto const result = LutBaker::Bake (lut, lutSize, look<float>);
+    EXPECT_EQ(result, LutErrorCode::LutState::OK);
+
+    const auto& body = lut.get_data();
+    ASSERT_EQ(body.size(), lutSize * 3u);
+    int errors = 0;
+    for (size_t i = 0; i < lutSize; i++)
+    {
+        const float x = static_cast<float>(i) / static_cast<float>(lutSize - 1);
+        const auto expected = look (x, x, x);
+        if (body[i * 3] != expected[0] || body[i * 3 + 1] != expected[1] || body[i * 3 + 2] != expected[2])
+            errors++;
+    }
+    EXPECT_EQ(errors, 0);
+}
+
+
+TEST (BakeLut, Bake_Functor_Exception_Rethrown)
+{
+    // exception thrown on calling thread (first chunk) and on worker thread (last chunk)
+    for (const float badBlue : { 0.f, 1.f })
+    {
+        CCubeLut3D<float> lut;
+        auto throwing = [badBlue](float r, float g, float b) -> std::array<float, 3>
+        {
+            if (b == badBlue)
+                throw std::runtime_error ("bake failed");
+            return { r, g, b };
+        };
+        EXPECT_THROW(LutBaker::Bake (lut, 33u, throwing, 4u), std::runtime_error);
+    }
+}
+
+
+TEST (BakeLut, Bake_Save_And_Load_Cube3D_f32)
+{
+    const std::string lutName{ dbgLutsFolder + "/Baked_17.cube" };
+    auto const saveResult = LutBaker::BakeToFile<CCubeLut3D<float>> (lutName, 17u, look<float>);
+    EXPECT_EQ(saveResult, LutErrorCode::LutState::OK);
+
+    CCubeLut3D<float> baked, loaded;
+    LutBaker::Bake (baked, 17u, look<float>);
+    auto const loadResult = loaded.LoadFile (lutName);
+    EXPECT_EQ(loadResult, LutErrorCode::LutState::OK);
+    EXPECT_EQ(loaded.getLutSize(), 17u);
+
+    const auto& a = baked.get_data();
+    const auto& b = loaded.get_data();
+    ASSERT_EQ(a.size(), b.size());
+    int errors = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > 1e-5f)
+            errors++;
+    EXPECT_EQ(errors, 0);
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    std::cout << "Save to: " << dbgLutsFolder << std::endl;
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+
+constexpr float tolerance = 1e-5f;
+
+std::vector<float> random_pixels (const size_t pixels, const unsigned int seed = 12345u)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-0.05f, 1.05f);
+    std::vector<float> buf(pixels * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+std::array<float, 3> look_warm (float r, float g, float b) { return { std::sqrt(r), 0.9f * g, b * b }; }
+std::array<float, 3> look_cold (float r, float g, float b) { return { r * r, g, 0.5f + 0.5f * b }; }
+std::array<float, 3> look_wide (float r, float g, float b) { return { 1.2f * r - 0.1f, g, 1.f - b }; }  // nodes outside of domain
+
+// reference: two separate passes and mix
+void blend_reference (CCubeLut3D<float>& lutA, CCubeLut3D<float>& lutB, const std::vector<float>& weights,
+                      const std::vector<float>& src, std::vector<float>& dst)
+{
+    const auto viewA = Interpolator::make_lattice_view (lutA);
+    const auto viewB = Interpolator::make_lattice_view (lutB);
+    dst.resize (src.size());
+    for (size_t i = 0; i < src.size(); i += 3)
+    {
+        float a[3], b[3];
+        Interpolator::tetrahedral_interpolation (viewA, &src[i], a);
+        Interpolator::tetrahedral_interpolation (viewB, &src[i], b);
+        const float w = weights[weights.size() == 1u ? 0u : i / 3u];
+        for (int c = 0; c < 3; c++)
+            dst[i + c] = a[c] * (1.f - w) + b[c] * w;
+    }
+}
+
+int count_errors (const std::vector<float>& a, const std::vector<float>& b)
+{
+    int errors = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > tolerance)
+            errors++;
+    return errors;
+}
+
+
+TEST (BlendLut, Scalar_Weight_Same_Size)
+{
+    CCubeLut3D<float> warm, cold;
+    ASSERT_EQ(LutBaker::Bake (warm, 33u, look_warm), LutErrorCode::LutState::OK);
+    ASSERT_EQ(LutBaker::Bake (cold, 33u, look_cold), LutErrorCode::LutState::OK);
+
+    constexpr size_t pixels = 1920u * 20u;
+    const std::vector<float> src = random_pixels (pixels);
+    std::vector<float> dst (src.size()), ref;
+
+    for (const float w : { 0.f, 0.3f, 1.f })
+    {
+        Interpolator::blend_interpolation (warm, cold, w, src.data(), dst.data(), pixels);
+        blend_reference (warm, cold, { w }, src, ref);
+        EXPECT_EQ(count_errors (dst, ref), 0) << "weight = " << w;
+    }
+
+    // in-place processing
+    std::vector<float> inplace (src);
+    Interpolator::blend_interpolation (warm, cold, 0.3f, inplace.data(), inplace.data(), pixels, 1u);
+    blend_reference (warm, cold, { 0.3f }, src, ref);
+    EXPECT_EQ(count_errors (inplace, ref), 0);
+}
+
+
+TEST (BlendLut, Scalar_Weight_Out_Of_Domain_Lattice)
+{
+    // lattice can't be pre-mixed: clamp of each LUT output differs from clamp of mixed output
+    CCubeLut3D<float> wide, cold;
+    ASSERT_EQ(LutBaker::Bake (wide, 17u, look_wide), LutErrorCode::LutState::OK);
+    ASSERT_EQ(LutBaker::Bake (cold, 17u, look_cold), LutErrorCode::LutState::OK);
+
+    LutElement::lutTable3D<float> mixed;
+    EXPECT_FALSE(Interpolator::blend_lattice (Interpolator::make_lattice_view (wide), Interpolator::make_lattice_view (cold), 0.5f, mixed));
+
+    constexpr size_t pixels = 10000u;
+    const std::vector<float> src = random_pixels (pixels);
+    std::vector<float> dst (src.size()), ref;
+    Interpolator::blend_interpolation (wide, cold, 0.5f, src.data(), dst.data(), pixels);
+    blend_reference (wide, cold, { 0.5f }, src, ref);
+    EXPECT_EQ(count_errors (dst, ref), 0);
+}
+
+
+TEST (BlendLut, Per_Pixel_Weight_Different_Size)
+{
+    CCubeLut3D<float> warm, cold;
+    ASSERT_EQ(LutBaker::Bake (warm, 17u, look_warm), LutErrorCode::LutState::OK);
+    ASSERT_EQ(LutBaker::Bake (cold, 65u, look_cold), LutErrorCode::LutState::OK);
+
+    constexpr size_t pixels = 1920u * 20u;
+    const std::vector<float> src = random_pixels (pixels);
+    std::vector<float> weights (pixels);
+    for (size_t i = 0; i < pixels; i++)
+        weights[i] = static_cast<float>(i % 1920u) / 1919.f;  // horizontal gradient matte
+
+    std::vector<float> dst (src.size()), dstSingle (src.size()), ref;
+    Interpolator::blend_interpolation (warm, cold, weights.data(), src.data(), dst.data(), pixels);
+    Interpolator::blend_interpolation (warm, cold, weights.data(), src.data(), dstSingle.data(), pixels, 1u);
+    blend_reference (warm, cold, weights, src, ref);
+
+    EXPECT_TRUE(dst == dstSingle);
+    EXPECT_EQ(count_errors (dst, ref), 0);
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
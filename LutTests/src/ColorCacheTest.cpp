@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <chrono>
+#include <vector>
+#include <random>
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.6f * r + 0.4f * g), 0.9f * g * g + 0.05f, 0.5f + 0.45f * std::sin(3.f * b) };
+}
+
+// posterized frame: 'colors' distinct colors in flat areas
+std::vector<float> posterized_frame (size_t pixels, size_t colors)
+{
+    std::mt19937 gen(11u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float> palette (colors * 3u);
+    for (auto& v : palette)
+        v = dist(gen);
+    std::vector<float> buf (pixels * 3u);
+    for (size_t i = 0; i < pixels; i++)
+    {
+        const size_t c = ((i / 37u) * 2654435761u) % colors;
+        std::copy (&palette[c * 3u], &palette[c * 3u] + 3u, &buf[i * 3u]);
+    }
+    return buf;
+}
+
+std::vector<float> noise_frame (size_t pixels)
+{
+    std::mt19937 gen(12u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float> buf (pixels * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+
+TEST (ColorCache, Equal_To_Direct_Evaluation)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    for (const auto& src : { posterized_frame (500000u, 2000u), noise_frame (200000u) })
+    {
+        const size_t pixels = src.size() / 3u;
+        std::vector<float> ref (src.size()), dst (src.size());
+        Interpolator::tetrahedral_interpolation (view, src.data(), ref.data(), pixels);
+        Interpolator::ColorCacheStats stats;
+        ASSERT_EQ(Interpolator::cached_interpolation (lut, src.data(), dst.data(), pixels, 0u, &stats), LutErrorCode::LutState::OK);
+        EXPECT_TRUE(ref == dst);
+        EXPECT_EQ(stats.lookups, pixels);
+
+        // in-place
+        dst = src;
+        ASSERT_EQ(Interpolator::cached_interpolation (lut, dst.data(), dst.data(), pixels), LutErrorCode::LutState::OK);
+        EXPECT_TRUE(ref == dst);
+    }
+}
+
+
+TEST (ColorCache, Hit_Rate_Telemetry)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+
+    const auto poster = posterized_frame (1u << 20, 2000u);
+    const auto noise = noise_frame (1u << 18);
+    EXPECT_GT(Interpolator::color_cache_hit_rate (poster.data(), poster.size() / 3u), 0.9);
+    EXPECT_LT(Interpolator::color_cache_hit_rate (noise.data(), noise.size() / 3u), 0.01);
+
+    std::vector<float> dst (poster.size());
+    Interpolator::ColorCacheStats stats;
+    ASSERT_EQ(Interpolator::adaptive_interpolation (lut, poster.data(), dst.data(), poster.size() / 3u, 0u, &stats), LutErrorCode::LutState::OK);
+    EXPECT_GT(stats.hit_rate(), 0.95);
+
+    dst.resize (noise.size());
+    ASSERT_EQ(Interpolator::adaptive_interpolation (lut, noise.data(), dst.data(), noise.size() / 3u, 0u, &stats), LutErrorCode::LutState::OK);
+    EXPECT_EQ(stats.lookups, 0u); // direct path selected
+}
+
+
+TEST (ColorCache, Performance)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+    const auto src = posterized_frame (1920u * 1080u, 3000u);
+    const size_t pixels = src.size() / 3u;
+    std::vector<float> dst (src.size());
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    Interpolator::tetrahedral_interpolation (view, src.data(), dst.data(), pixels);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    Interpolator::cached_interpolation (view, src.data(), dst.data(), pixels, 1u);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Direct: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms; cached: "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
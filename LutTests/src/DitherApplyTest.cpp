@@ -0,0 +1,220 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <numeric>
+#include <random>
+#include <limits>
+#include <cmath>
+
+using Interpolator::PixelFormat;
+using Interpolator::DitherMode;
+
+constexpr size_t width = 256u, height = 128u;
+
+std::array<float, 3> identity (float r, float g, float b) { return { r, g, b }; }
+
+// flat field between two 8 bit codes
+std::vector<float> flat_frame (const float v)
+{
+    return std::vector<float> (width * height * 3u, v);
+}
+
+double mean_code (const std::vector<uint8_t>& img)
+{
+    return std::accumulate (img.begin(), img.end(), 0.0) / static_cast<double>(img.size());
+}
+
+
+// Void-and-cluster (Ulichney) blue noise: ranks assigned by repeatedly removing tightest cluster / filling
+// largest void of the binary pattern, where density measured by toroidal gaussian filter. Filter weights and
+// density kept in fixed point, so ranks don't depend on floating point optimization of the build.
+std::vector<uint32_t> void_and_cluster_ranks (const size_t size, const double sigma = 1.5, const uint32_t seed = 0x5EEDu)
+{
+    const size_t pixels = size * size;
+
+    // toroidal gaussian kernel indexed by (dy * size + dx)
+    std::vector<int64_t> kernel (pixels);
+    for (size_t dy = 0; dy < size; dy++)
+        for (size_t dx = 0; dx < size; dx++)
+        {
+            const double ddx = static_cast<double>(std::min(dx, size - dx));
+            const double ddy = static_cast<double>(std::min(dy, size - dy));
+            kernel[dy * size + dx] = std::llround (std::exp(-(ddx * ddx + ddy * ddy) / (2.0 * sigma * sigma)) * 16777216.0);
+        }
+
+    std::vector<uint8_t> pattern (pixels, 0u);
+    std::vector<int64_t> energy (pixels, 0);
+
+    auto toggle = [&](const size_t p, const bool set)
+    {
+        pattern[p] = (true == set ? 1u : 0u);
+        const size_t px = p % size, py = p / size;
+        for (size_t y = 0; y < size; y++)
+        {
+            const size_t dy = (y + size - py) % size;
+            for (size_t x = 0; x < size; x++)
+            {
+                const int64_t k = kernel[dy * size + (x + size - px) % size];
+                energy[y * size + x] += (true == set ? k : -k);
+            }
+        }
+    };
+    auto tightest_cluster = [&]()
+    {
+        size_t best = 0u; int64_t bestVal = -1;
+        for (size_t p = 0; p < pixels; p++)
+            if (1u == pattern[p] && energy[p] > bestVal) { bestVal = energy[p]; best = p; }
+        return best;
+    };
+    auto largest_void = [&]()
+    {
+        size_t best = 0u; int64_t bestVal = std::numeric_limits<int64_t>::max();
+        for (size_t p = 0; p < pixels; p++)
+            if (0u == pattern[p] && energy[p] < bestVal) { bestVal = energy[p]; best = p; }
+        return best;
+    };
+
+    // initial pattern: ~10% random points, relaxed until stable
+    std::mt19937 gen (seed);
+    const size_t initialOnes = std::max(size_t(1u), pixels / 10u);
+    for (size_t n = 0; n < initialOnes; )
+    {
+        const size_t p = static_cast<size_t>(gen() % pixels);
+        if (0u == pattern[p]) { toggle (p, true); n++; }
+    }
+    for (size_t iter = 0; iter < pixels; iter++)
+    {
+        const size_t cluster = tightest_cluster();
+        toggle (cluster, false);
+        const size_t voidPos = largest_void();
+        toggle (voidPos, true);
+        if (voidPos == cluster)
+            break;
+    }
+
+    std::vector<uint32_t> rank (pixels, 0u);
+    const std::vector<uint8_t> prototype (pattern);
+    const std::vector<int64_t> prototypeEnergy (energy);
+
+    // phase 1: ranks below initial points - remove clusters
+    for (size_t r = initialOnes; r > 0u; r--)
+    {
+        const size_t p = tightest_cluster();
+        toggle (p, false);
+        rank[p] = static_cast<uint32_t>(r - 1u);
+    }
+
+    // phase 2 and 3: fill voids up to complete pattern
+    pattern = prototype;
+    energy  = prototypeEnergy;
+    for (size_t r = initialOnes; r < pixels; r++)
+    {
+        const size_t p = largest_void();
+        toggle (p, true);
+        rank[p] = static_cast<uint32_t>(r);
+    }
+    return rank;
+}
+
+
+TEST (DitherApply, Threshold_Maps)
+{
+    const auto& bayer = Interpolator::bayer_map();
+    std::vector<float> sorted (bayer.begin(), bayer.end());
+    std::sort (sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); i++)
+        EXPECT_FLOAT_EQ(sorted[i], (static_cast<float>(i) + 0.5f) / 64.f);
+    EXPECT_FLOAT_EQ(bayer[0], 0.5f / 64.f);  // [0 32 8 40 ...] first row of 8x8 Bayer matrix
+    EXPECT_FLOAT_EQ(bayer[1], 32.5f / 64.f);
+
+    // blue noise map is permutation of all thresholds
+    const auto& blue = Interpolator::blue_noise_map();
+    ASSERT_EQ(blue.size(), 64u * 64u);
+    std::vector<float> blueSorted (blue.begin(), blue.end());
+    std::sort (blueSorted.begin(), blueSorted.end());
+    int errors = 0;
+    for (size_t i = 0; i < blueSorted.size(); i++)
+        if (blueSorted[i] != (static_cast<float>(i) + 0.5f) / 4096.f)
+            errors++;
+    EXPECT_EQ(errors, 0);
+
+    // blue noise: lowest thresholds spread over the tile, no adjacent pixels among first 5%
+    int adjacent = 0;
+    for (size_t y = 0; y < 64u; y++)
+        for (size_t x = 0; x < 64u; x++)
+            if (blue[y * 64 + x] < 0.05f && (blue[y * 64 + (x + 1) % 64] < 0.05f || blue[((y + 1) % 64) * 64 + x] < 0.05f))
+                adjacent++;
+    EXPECT_EQ(adjacent, 0);
+}
+
+
+TEST (DitherApply, Blue_Noise_Table_Regenerated)
+{
+    // shipped table equal to output of the generator
+    const std::vector<uint32_t> rank = void_and_cluster_ranks (Interpolator::blueNoiseMapSize);
+    const uint16_t* table = Interpolator::blue_noise_ranks();
+    int errors = 0;
+    for (size_t i = 0; i < rank.size(); i++)
+        if (rank[i] != table[i])
+            errors++;
+    EXPECT_EQ(errors, 0);
+}
+
+
+TEST (DitherApply, Mean_Level_Preserved)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 17u, identity), LutErrorCode::LutState::OK);
+
+    const float level = 100.3f / 255.f;
+    std::vector<float> src = flat_frame (level);
+    std::vector<uint8_t> plain (src.size()), bayer (src.size()), blue (src.size());
+    const auto srcView = Interpolator::make_interleaved_view (src.data(), width, height, PixelFormat::F32);
+
+    ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, Interpolator::make_interleaved_view (plain.data(), width, height, PixelFormat::U8), DitherMode::None), LutErrorCode::LutState::OK);
+    ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, Interpolator::make_interleaved_view (bayer.data(), width, height, PixelFormat::U8), DitherMode::Bayer), LutErrorCode::LutState::OK);
+    ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, Interpolator::make_interleaved_view (blue.data(), width, height, PixelFormat::U8), DitherMode::BlueNoise), LutErrorCode::LutState::OK);
+
+    // without dither: banding to nearest code; with dither: mean level kept, error within 1 code
+    EXPECT_NEAR(mean_code (plain), 100.0, 1e-9);
+    EXPECT_NEAR(mean_code (bayer), 100.3, 0.02);
+    EXPECT_NEAR(mean_code (blue),  100.3, 0.02);
+    for (const auto v : bayer)
+        ASSERT_TRUE(100u == v || 101u == v);
+}
+
+
+TEST (DitherApply, Deterministic_Across_Threads)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, [](float r, float g, float b) { return std::array<float, 3>{ r * r, std::sqrt(g), 0.5f * (r + b) }; }), LutErrorCode::LutState::OK);
+
+    // smooth gradient
+    std::vector<float> src (width * height * 3u);
+    for (size_t y = 0; y < height; y++)
+        for (size_t x = 0; x < width; x++)
+        {
+            float* p = &src[(y * width + x) * 3u];
+            p[0] = static_cast<float>(x) / width;
+            p[1] = static_cast<float>(y) / height;
+            p[2] = 0.25f;
+        }
+
+    const auto srcView = Interpolator::make_interleaved_view (src.data(), width, height, PixelFormat::F32);
+    for (const auto mode : { DitherMode::Bayer, DitherMode::BlueNoise })
+    {
+        std::vector<uint32_t> single (width * height), multi (width * height);
+        ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, Interpolator::make_interleaved_view (single.data(), width, height, PixelFormat::U10Packed), mode, 1u), LutErrorCode::LutState::OK);
+        ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, Interpolator::make_interleaved_view (multi.data(), width, height, PixelFormat::U10Packed), mode), LutErrorCode::LutState::OK);
+        EXPECT_TRUE(single == multi);
+    }
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
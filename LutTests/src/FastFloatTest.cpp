@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "fast_float.h"
+#include "lutCube3D.h"
+#include <chrono>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename T>
+static bool same_bits (const T a, const T b)
+{
+	return 0 == std::memcmp (&a, &b, sizeof(T));
+}
+
+template <typename T>
+static T reference_value (const char* str)
+{
+	return static_cast<T>(0);
+}
+template <> float  reference_value<float>  (const char* str) { return std::strtof (str, nullptr); }
+template <> double reference_value<double> (const char* str) { return std::strtod (str, nullptr); }
+
+template <typename T>
+static void check_formats (const char* format, const uint32_t count)
+{
+	std::mt19937_64 gen (12345u);
+	std::uniform_real_distribution<double> dist (-2.0, 2.0);
+	char buffer[64];
+	uint32_t mismatch = 0u;
+	for (uint32_t i = 0u; i < count; i++)
+	{
+		const int len = std::snprintf (buffer, sizeof(buffer), format, dist(gen));
+		T value{};
+		EXPECT_TRUE(LutFastFloat::from_chars (buffer, static_cast<std::size_t>(len), value));
+		if (!same_bits (value, reference_value<T>(buffer)))
+			mismatch++;
+	}
+	EXPECT_EQ(mismatch, 0u) << "format " << format;
+}
+
+
+TEST (FastFloat, FixedFormat_Float)
+{
+	for (const char* format : { "%.6f", "%.4f", "%.10f", "%.9g", "%.17g", "%e", "%.3e" })
+		check_formats<float> (format, 100000u);
+}
+
+TEST (FastFloat, FixedFormat_Double)
+{
+	for (const char* format : { "%.6f", "%.4f", "%.10f", "%.9g", "%.17g", "%e", "%.3e" })
+		check_formats<double> (format, 100000u);
+}
+
+TEST (FastFloat, SpecialTokens)
+{
+	const char* tokens[] = { "0", "-0", "+1", "1.", ".5", "00.25", "1e3", "1E-3", "-0.000000", "123456789012345678901234567890",
+	                         "0.1000000000000000000000000001", "1e308", "4.9e-324", "2.2250738585072011e-308", "1e400", "inf", "nan" };
+	for (const char* token : tokens)
+	{
+		double value = 0.0;
+		EXPECT_TRUE(LutFastFloat::from_chars (token, std::strlen(token), value)) << token;
+		const double reference = std::strtod (token, nullptr);
+		if (reference != reference)
+			EXPECT_TRUE(value != value) << token;
+		else if (0.0 == reference)	// sign of zero not preserved in fast-math builds
+			EXPECT_EQ(value, 0.0) << token;
+		else
+			EXPECT_TRUE(same_bits (value, reference)) << token;
+	}
+
+	for (const char* bad : { "", "-", ".", "e5", "1e", "1.0.0", "1,5", "0x", "1e+", "abc" })
+	{
+		double value = 42.0;
+		EXPECT_FALSE(LutFastFloat::from_chars (bad, std::strlen(bad), value)) << bad;
+		EXPECT_EQ(value, 42.0);
+	}
+}
+
+TEST (FastFloat, LocaleIndependent)
+{
+	// decimal comma locale: C runtime strtod stops on '.', fast parser must not
+	const char* locales[] = { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "German_Germany.1252" };
+	const std::string previous = std::setlocale (LC_NUMERIC, nullptr);
+	bool localeSet = false;
+	for (const char* name : locales)
+		if (nullptr != std::setlocale (LC_NUMERIC, name)) { localeSet = true; break; }
+
+	double value = 0.0, exotic = 0.0;
+	const bool ok = LutFastFloat::from_chars ("0.123456", 8u, value);
+	const bool okSlow = LutFastFloat::from_chars ("0.12345678901234567890123", 25u, exotic);
+	std::setlocale (LC_NUMERIC, previous.c_str());
+
+	EXPECT_TRUE(ok);
+	EXPECT_TRUE(okSlow);
+	EXPECT_EQ(value, 0.123456);
+	EXPECT_EQ(exotic, 0.12345678901234567890123);
+	if (false == localeSet)
+		std::cout << "Decimal comma locale not available, checked in current locale only" << std::endl;
+}
+
+TEST (FastFloat, Cube65_LoadTime)
+{
+	constexpr uint32_t lutSize = 65u;
+	std::string text = "TITLE \"Generated\"\nLUT_3D_SIZE 65\n";
+	text.reserve (lutSize * lutSize * lutSize * 30u);
+	char line[96];
+	for (uint32_t b = 0u; b < lutSize; b++)
+		for (uint32_t g = 0u; g < lutSize; g++)
+			for (uint32_t r = 0u; r < lutSize; r++)
+			{
+				const int len = std::snprintf (line, sizeof(line), "%.6f %.6f %.6f\n",
+					std::sqrt(r / 64.0), std::sqrt(g / 64.0), std::sqrt(b / 64.0));
+				text.append (line, static_cast<std::size_t>(len));
+			}
+
+	CCubeLut3D<float> lut;
+	auto const start = std::chrono::high_resolution_clock::now();
+	auto const result = lut.LoadFromMemory (text.data(), text.size());
+	auto const stop = std::chrono::high_resolution_clock::now();
+	EXPECT_EQ(result, LutErrorCode::LutState::OK);
+	EXPECT_EQ(lut.getLutSize(), lutSize);
+
+	const auto& body = lut.get_data();
+	ASSERT_EQ(body.size(), lutSize * lutSize * lutSize * 3u);
+	EXPECT_EQ(body[3], std::strtof ("0.125000", nullptr));
+
+	std::cout << "65^3 Cube (" << text.size() / 1024u << " KB) parsed in "
+	          << std::chrono::duration<double, std::milli>(stop - start).count() << " ms" << std::endl;
+}
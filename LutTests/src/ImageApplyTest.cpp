@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include "half_float.h"
+#include <array>
+#include <vector>
+#include <random>
+
+using Interpolator::PixelFormat;
+using Interpolator::PixelLayout;
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.7f * r + 0.3f * b), 0.8f * g * g + 0.1f * r, 0.5f + 0.45f * std::sin(3.f * b) };
+}
+
+class ImageApplyTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+        view = Interpolator::make_lattice_view (lut);
+    }
+
+    std::array<float, 3> reference (float r, float g, float b)
+    {
+        const float in[3] = { r, g, b };
+        std::array<float, 3> out;
+        Interpolator::tetrahedral_interpolation (view, in, out.data());
+        return out;
+    }
+
+    CCubeLut3D<float> lut;
+    Interpolator::LatticeView<float> view;
+    static constexpr size_t width = 301u, height = 17u;
+};
+
+constexpr size_t ImageApplyTest::width;
+constexpr size_t ImageApplyTest::height;
+
+
+TEST (HalfFloat, Conversion)
+{
+    for (const float v : { 0.f, -0.f, 1.f, -2.5f, 0.333251953125f, 65504.f, 6.103515625e-05f, 5.9604644775390625e-08f })
+        EXPECT_EQ(HalfFloat::to_float (HalfFloat::from_float (v)), v);
+
+    EXPECT_EQ(HalfFloat::from_float (1.f), 0x3C00u);
+    EXPECT_EQ(HalfFloat::from_float (70000.f), 0x7C00u);           // overflow -> inf
+    EXPECT_EQ(HalfFloat::from_float (1.f + 1.f / 2048.f), 0x3C00u); // tie rounded to even
+    EXPECT_EQ(HalfFloat::from_float (1.f + 3.f / 2048.f), 0x3C02u); // tie rounded to even
+    EXPECT_EQ(HalfFloat::from_float (1e-9f), 0u);                   // underflow -> zero
+}
+
+
+TEST_F (ImageApplyTest, U8_RGBA_Padded_To_F32_Planar)
+{
+    // interleaved RGBA with row padding
+    const size_t srcStride = width * 4u + 13u;
+    std::vector<uint8_t> src (srcStride * height);
+    std::mt19937 gen(1u);
+    for (auto& v : src)
+        v = static_cast<uint8_t>(gen() & 0xFFu);
+
+    std::vector<float> r (width * height), g (width * height), b (width * height), a (width * height);
+    const auto srcView = Interpolator::make_interleaved_view (src.data(), width, height, PixelFormat::U8, true, srcStride);
+    const auto dstView = Interpolator::make_planar_view (r.data(), g.data(), b.data(), a.data(), width, height, PixelFormat::F32);
+    ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, dstView), LutErrorCode::LutState::OK);
+
+    int errors = 0;
+    for (size_t y = 0; y < height; y++)
+        for (size_t x = 0; x < width; x++)
+        {
+            const uint8_t* p = &src[y * srcStride + x * 4u];
+            const auto ref = reference (p[0] / 255.f, p[1] / 255.f, p[2] / 255.f);
+            const size_t i = y * width + x;
+            if (std::abs(ref[0] - r[i]) > 1e-5f || std::abs(ref[1] - g[i]) > 1e-5f || std::abs(ref[2] - b[i]) > 1e-5f ||
+                std::abs(a[i] - p[3] / 255.f) > 1e-6f)
+                errors++;
+        }
+    EXPECT_EQ(errors, 0);
+}
+
+
+TEST_F (ImageApplyTest, U16_In_Place_Alpha_Untouched)
+{
+    std::vector<uint16_t> img (width * height * 4u);
+    std::mt19937 gen(2u);
+    for (auto& v : img)
+        v = static_cast<uint16_t>(gen() & 0xFFFFu);
+    const std::vector<uint16_t> orig (img);
+
+    const auto imgView = Interpolator::make_interleaved_view (img.data(), width, height, PixelFormat::U16, true);
+    ASSERT_EQ(Interpolator::image_interpolation (view, imgView, imgView), LutErrorCode::LutState::OK);
+
+    int errors = 0;
+    for (size_t i = 0; i < width * height; i++)
+    {
+        const auto ref = reference (orig[i * 4] / 65535.f, orig[i * 4 + 1] / 65535.f, orig[i * 4 + 2] / 65535.f);
+        for (int c = 0; c < 3; c++)
+            if (std::abs(static_cast<int>(img[i * 4 + c]) - static_cast<int>(ref[c] * 65535.f + 0.5f)) > 1)
+                errors++;
+        if (img[i * 4 + 3] != orig[i * 4 + 3])
+            errors++;
+    }
+    EXPECT_EQ(errors, 0);
+}
+
+
+TEST_F (ImageApplyTest, U10Packed_To_F16_And_U12)
+{
+    std::vector<uint32_t> src (width * height);
+    std::mt19937 gen(3u);
+    for (auto& v : src)
+        v = gen();
+
+    std::vector<uint16_t> half (width * height * 4u), u12 (width * height * 3u);
+    const auto srcView  = Interpolator::make_interleaved_view (src.data(), width, height, PixelFormat::U10Packed, true);
+    const auto halfView = Interpolator::make_interleaved_view (half.data(), width, height, PixelFormat::F16, true);
+    const auto u12View  = Interpolator::make_interleaved_view (u12.data(), width, height, PixelFormat::U12, false);
+    ASSERT_EQ(Interpolator::image_interpolation (view, srcView, halfView, 1u), LutErrorCode::LutState::OK);
+    ASSERT_EQ(Interpolator::image_interpolation (view, srcView, u12View), LutErrorCode::LutState::OK);
+
+    int errors = 0;
+    for (size_t i = 0; i < width * height; i++)
+    {
+        const uint32_t w = src[i];
+        const auto ref = reference ((w & 0x3FFu) / 1023.f, ((w >> 10) & 0x3FFu) / 1023.f, ((w >> 20) & 0x3FFu) / 1023.f);
+        for (int c = 0; c < 3; c++)
+        {
+            if (std::abs(HalfFloat::to_float (half[i * 4 + c]) - ref[c]) > 1e-3f)
+                errors++;
+            if (u12[i * 3 + c] > 4095u || std::abs(static_cast<int>(u12[i * 3 + c]) - static_cast<int>(ref[c] * 4095.f + 0.5f)) > 1)
+                errors++;
+        }
+        if (std::abs(HalfFloat::to_float (half[i * 4 + 3]) - static_cast<float>(w >> 30) / 3.f) > 1e-3f)
+            errors++;
+    }
+    EXPECT_EQ(errors, 0);
+}
+
+
+TEST_F (ImageApplyTest, Invalid_Views)
+{
+    std::vector<float> buf (width * height * 3u);
+    auto good = Interpolator::make_interleaved_view (buf.data(), width, height, PixelFormat::F32);
+    auto small = Interpolator::make_interleaved_view (buf.data(), width - 1u, height, PixelFormat::F32);
+    auto badStride = Interpolator::make_interleaved_view (buf.data(), width, height, PixelFormat::F32, false, width * 4u);
+    auto packedPlanar = Interpolator::make_planar_view (buf.data(), buf.data(), buf.data(), nullptr, width, height, PixelFormat::U10Packed);
+    auto noPlane = Interpolator::make_planar_view (buf.data(), nullptr, buf.data(), nullptr, width, height, PixelFormat::F32);
+
+    EXPECT_EQ(Interpolator::image_interpolation (view, good, small), LutErrorCode::LutState::IncorrectDimension);
+    EXPECT_EQ(Interpolator::image_interpolation (view, good, badStride), LutErrorCode::LutState::IncorrectDimension);
+    EXPECT_EQ(Interpolator::image_interpolation (view, packedPlanar, good), LutErrorCode::LutState::IncorrectDimension);
+    EXPECT_EQ(Interpolator::image_interpolation (view, good, noPlane), LutErrorCode::LutState::NotInitialized);
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
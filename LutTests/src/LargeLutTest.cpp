@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "lutCube3D.h"
+#include "lutInterpolator.hpp"
+#include "huge_pages.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+TEST (LargeLut, Cube300_LoadAndInterpolate)
+{
+	// 300^3 lattice (~310 MB as float), node (r, g, b) holds its own lattice coordinates
+	constexpr uint32_t size = 300u;
+	constexpr uint32_t maxIdx = size - 1u;
+	std::vector<std::string> numbers (size);
+	for (uint32_t i = 0u; i < size; i++)
+		numbers[i] = std::to_string (i);
+
+	std::string text = "LUT_3D_SIZE 300\nDOMAIN_MIN 0 0 0\nDOMAIN_MAX 299 299 299\n";
+	text.reserve (static_cast<std::size_t>(size) * size * size * 12u);
+	for (uint32_t b = 0u; b < size; b++)
+		for (uint32_t g = 0u; g < size; g++)
+		{
+			const std::string gb = " " + numbers[g] + " " + numbers[b] + "\n";
+			for (uint32_t r = 0u; r < size; r++)
+				text.append (numbers[r]).append (gb);
+		}
+
+	CCubeLut3D<float> lut;
+	auto const start = std::chrono::high_resolution_clock::now();
+	const auto err = lut.LoadFromMemory (text.data(), text.size());
+	auto const stop = std::chrono::high_resolution_clock::now();
+	std::string().swap (text);
+	ASSERT_EQ(err, LutErrorCode::LutState::OK);
+	EXPECT_EQ(lut.getLutSize(), size);
+	ASSERT_EQ(lut.get_data().size(), static_cast<std::size_t>(size) * size * size * 3u);
+
+	const auto view = Interpolator::make_lattice_view (lut);
+	const float far[3]  = { 1.f, 1.f, 1.f };
+	const float near[3] = { 1.f - 0.5f / maxIdx, 1.f, 1.f - 0.25f / maxIdx };
+	float out[3];
+
+	Interpolator::tetrahedral_interpolation (view, far, out);
+	EXPECT_FLOAT_EQ(out[0], 299.f);
+	EXPECT_FLOAT_EQ(out[1], 299.f);
+	EXPECT_FLOAT_EQ(out[2], 299.f);
+
+	Interpolator::tetrahedral_interpolation (view, near, out);
+	EXPECT_NEAR(out[0], 298.5f,  1e-2f);
+	EXPECT_NEAR(out[1], 299.f,   1e-2f);
+	EXPECT_NEAR(out[2], 298.75f, 1e-2f);
+
+	std::cout << "300^3 Cube parsed in " << std::chrono::duration<double, std::milli>(stop - start).count() << " ms" << std::endl;
+}
+
+TEST (LargeLut, SizeLimits)
+{
+	CCubeLut3D<float> lut;
+	const std::string tooBig = "LUT_3D_SIZE 1025\n0 0 0\n";
+	EXPECT_EQ(lut.LoadFromMemory (tooBig.data(), tooBig.size()), LutErrorCode::LutState::LutSizeOutOfRange);
+	EXPECT_EQ(lut.CreateLut (257u), LutErrorCode::LutState::OK);
+	EXPECT_EQ(lut.get_data().size(), 257u * 257u * 257u * 3u);
+}
+
+TEST (LargeLut, HugePagesAdvice)
+{
+	// advice is optional: small buffers never advised, large ones only when OS supports THP
+	std::vector<float> small, large;
+	EXPECT_FALSE(LutMemory::reserve_huge (small, 1024u));
+	EXPECT_GE(small.capacity(), 1024u);
+
+	const bool advised = LutMemory::reserve_huge (large, 64u * 1024u * 1024u / sizeof(float));
+	EXPECT_GE(large.capacity(), 64u * 1024u * 1024u / sizeof(float));
+	large.assign (large.capacity(), 1.f);
+	EXPECT_EQ(large.back(), 1.f);
+	std::cout << "Huge pages advice " << (advised ? "applied" : "not available") << std::endl;
+}
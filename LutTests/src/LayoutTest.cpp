@@ -0,0 +1,114 @@
+#include "gtest/gtest.h"
+#include "lutLayout.h"
+#include "lut3DL.h"
+#include "lutCube3D.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+template <typename T>
+static std::vector<T> make_lattice (const std::size_t size)
+{
+	std::vector<T> body (size * size * size * 3u);
+	for (std::size_t i = 0u; i < body.size(); i++)
+		body[i] = static_cast<T>(i % 65521u);
+	return body;
+}
+
+// straightforward reference: node (slow = i, middle = g, fast = j) moved to (slow = j, middle = g, fast = i)
+template <typename T>
+static std::vector<T> reference_swap (const std::vector<T>& src, const std::size_t N)
+{
+	std::vector<T> dst (src.size());
+	for (std::size_t i = 0u; i < N; i++)
+		for (std::size_t g = 0u; g < N; g++)
+			for (std::size_t j = 0u; j < N; j++)
+				for (std::size_t c = 0u; c < 3u; c++)
+					dst[((j * N + g) * N + i) * 3u + c] = src[((i * N + g) * N + j) * 3u + c];
+	return dst;
+}
+
+
+TEST (Layout, SwapRedBlue_MatchesReference)
+{
+	for (const std::size_t size : { 2u, 3u, 17u, 33u, 65u })
+	{
+		const auto src = make_lattice<float> (size);
+		std::vector<float> dst (src.size());
+		LutLayout::swap_red_blue_axes (src.data(), dst.data(), size);
+		EXPECT_TRUE(dst == reference_swap (src, size)) << "size = " << size;
+
+		// swap is involution
+		std::vector<float> back (src.size());
+		LutLayout::swap_red_blue_axes (dst.data(), back.data(), size);
+		EXPECT_TRUE(back == src) << "size = " << size;
+	}
+}
+
+TEST (Layout, SwapRedBlue_Threads)
+{
+	constexpr std::size_t size = 129u;
+	const auto src = make_lattice<uint16_t> (size);
+	std::vector<uint16_t> single (src.size()), multi (src.size());
+	LutLayout::swap_red_blue_axes (src.data(), single.data(), size, 3u, 1u);
+	LutLayout::swap_red_blue_axes (src.data(), multi.data(), size, 3u, 8u);
+	EXPECT_TRUE(single == multi);
+	EXPECT_TRUE(single == reference_swap (src, size));
+}
+
+TEST (Layout, NormalizeAxisOrder)
+{
+	auto body = make_lattice<double> (9u);
+	const auto original = body;
+	LutLayout::normalize_axis_order (body, 9u, LutElement::AxisOrder::RedFastest);
+	EXPECT_TRUE(body == original);
+	LutLayout::normalize_axis_order (body, 9u, LutElement::AxisOrder::BlueFastest);
+	EXPECT_TRUE(body == reference_swap (original, 9u));
+}
+
+TEST (Layout, NativeOrderDeclared)
+{
+	EXPECT_EQ(CLut3DL<float>::getNativeAxisOrder(), LutElement::AxisOrder::BlueFastest);
+	EXPECT_EQ(CCubeLut3D<float>::getNativeAxisOrder(), LutElement::AxisOrder::RedFastest);
+	EXPECT_EQ(LutElement::canonicalAxisOrder, LutElement::AxisOrder::RedFastest);
+}
+
+TEST (Layout, Lut3DL_CanonicalBody)
+{
+	// blue fastest file content, node value encodes its (r, g, b) lattice coordinate
+	constexpr uint32_t size = 5u;
+	std::string text;
+	for (uint32_t r = 0u; r < size; r++)
+		for (uint32_t g = 0u; g < size; g++)
+			for (uint32_t b = 0u; b < size; b++)
+				text += std::to_string (r) + " " + std::to_string (g * 10u) + " " + std::to_string (b * 100u) + "\n";
+
+	CLut3DL<float> lut;
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+	const auto& body = lut.get_data();
+	const auto& native = lut.get_native_data();
+	ASSERT_EQ(body.size(), size * size * size * 3u);
+	ASSERT_EQ(native.size(), body.size());
+
+	bool canonical = true;
+	for (uint32_t b = 0u; b < size; b++)
+		for (uint32_t g = 0u; g < size; g++)
+			for (uint32_t r = 0u; r < size; r++)
+			{
+				const std::size_t idx = ((b * size + g) * size + r) * 3u;
+				canonical = canonical && (body[idx] == r && body[idx + 1u] == g * 10u && body[idx + 2u] == b * 100u);
+				canonical = canonical && (native[idx] == r && native[idx + 1u] == g * 10u && native[idx + 2u] == b * 100u);
+			}
+	EXPECT_TRUE(canonical);
+}
+
+TEST (Layout, Transpose129_Time)
+{
+	constexpr std::size_t size = 129u;
+	auto body = make_lattice<float> (size);
+	auto const start = std::chrono::high_resolution_clock::now();
+	LutLayout::normalize_axis_order (body, size, LutElement::AxisOrder::BlueFastest);
+	auto const stop = std::chrono::high_resolution_clock::now();
+	std::cout << "129^3 axis swap: " << std::chrono::duration<double, std::milli>(stop - start).count() << " ms" << std::endl;
+}
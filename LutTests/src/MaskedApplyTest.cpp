@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+#include <chrono>
+
+constexpr float tolerance = 1e-5f;
+constexpr size_t width = 1920u, height = 270u;
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.7f * r + 0.3f * b), 0.8f * g * g + 0.1f * r, 0.5f + 0.45f * std::sin(3.f * b) };
+}
+
+std::vector<float> random_frame (void)
+{
+    std::mt19937 gen(31u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float> buf(width * height * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+// reference: LUT on complete frame and blend by weight
+template <typename W>
+std::vector<float> reference (CCubeLut3D<float>& lut, const std::vector<float>& src, W weight)
+{
+    std::vector<float> full (src.size()), out (src.size());
+    Interpolator::tetrahedral_interpolation (Interpolator::make_lattice_view (lut), src.data(), full.data(), width * height);
+    for (size_t y = 0; y < height; y++)
+        for (size_t x = 0; x < width; x++)
+        {
+            const float w = weight (x, y);
+            for (size_t c = 0; c < 3; c++)
+            {
+                const size_t i = (y * width + x) * 3u + c;
+                out[i] = src[i] + (full[i] - src[i]) * w;
+            }
+        }
+    return out;
+}
+
+int count_errors (const std::vector<float>& a, const std::vector<float>& b)
+{
+    int errors = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > tolerance)
+            errors++;
+    return errors;
+}
+
+
+TEST (MaskedApply, Roi_List)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    const std::vector<float> src = random_frame();
+
+    // overlapping windows and window crossing frame border
+    const std::vector<Interpolator::RoiRect> rois { { 100u, 20u, 400u, 100u }, { 300u, 50u, 300u, 100u }, { 1800u, 200u, 500u, 500u } };
+    auto inside = [&](size_t x, size_t y) {
+        for (const auto& r : rois)
+            if (x >= r.x && x < r.x + r.width && y >= r.y && y < r.y + r.height)
+                return 1.f;
+        return 0.f;
+    };
+
+    std::vector<float> dst (src.size()), inplace (src);
+    ASSERT_EQ(Interpolator::masked_interpolation (lut, src.data(), dst.data(), width, height, rois), LutErrorCode::LutState::OK);
+    ASSERT_EQ(Interpolator::masked_interpolation (lut, inplace.data(), inplace.data(), width, height, rois), LutErrorCode::LutState::OK);
+    const auto ref = reference (lut, src, inside);
+    EXPECT_EQ(count_errors (dst, ref), 0);
+    EXPECT_EQ(count_errors (inplace, ref), 0);
+}
+
+
+TEST (MaskedApply, Mask_8_And_16_Bits)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    const std::vector<float> src = random_frame();
+
+    // soft-edged elliptic matte
+    std::vector<uint8_t> mask8 (width * height);
+    std::vector<uint16_t> mask16 (width * height);
+    auto matte = [](size_t x, size_t y) {
+        const float dx = (static_cast<float>(x) - 960.f) / 400.f, dy = (static_cast<float>(y) - 135.f) / 100.f;
+        return std::min(1.f, std::max(0.f, (1.f - (dx * dx + dy * dy)) * 4.f));
+    };
+    for (size_t y = 0; y < height; y++)
+        for (size_t x = 0; x < width; x++)
+        {
+            mask8[y * width + x]  = static_cast<uint8_t>(matte (x, y) * 255.f + 0.5f);
+            mask16[y * width + x] = static_cast<uint16_t>(matte (x, y) * 65535.f + 0.5f);
+        }
+
+    std::vector<float> dst8 (src.size()), dst16 (src.size());
+    Interpolator::MaskView m8, m16;
+    m8.data = mask8.data();
+    m16.data = mask16.data();
+    m16.is16bit = true;
+    ASSERT_EQ(Interpolator::masked_interpolation (lut, src.data(), dst8.data(), width, height, {}, m8), LutErrorCode::LutState::OK);
+    ASSERT_EQ(Interpolator::masked_interpolation (lut, src.data(), dst16.data(), width, height, {}, m16), LutErrorCode::LutState::OK);
+
+    EXPECT_EQ(count_errors (dst8,  reference (lut, src, [&](size_t x, size_t y) { return mask8[y * width + x] / 255.f; })), 0);
+    EXPECT_EQ(count_errors (dst16, reference (lut, src, [&](size_t x, size_t y) { return mask16[y * width + x] / 65535.f; })), 0);
+}
+
+
+TEST (MaskedApply, Work_Scales_With_Area)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    std::vector<float> frame = random_frame();
+
+    const std::vector<Interpolator::RoiRect> window { { 480u, 60u, 640u, 120u } };  // ~15% of frame
+    auto t0 = std::chrono::high_resolution_clock::now();
+    Interpolator::masked_interpolation (lut, frame.data(), frame.data(), width, height, window, Interpolator::MaskView{}, 1u);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    Interpolator::masked_interpolation (lut, frame.data(), frame.data(), width, height, {}, Interpolator::MaskView{}, 1u);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Window: " << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count()
+              << " us, full frame: " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << " us" << std::endl;
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
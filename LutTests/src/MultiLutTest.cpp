@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+#include <chrono>
+
+constexpr float tolerance = 1e-5f;
+
+bool near_equal (const float* a, const float* b, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        if (std::abs(a[i] - b[i]) > tolerance)
+            return false;
+    return true;
+}
+
+std::vector<float> random_pixels (const size_t pixels)
+{
+    std::mt19937 gen(4321u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float> buf(pixels * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+// set of candidate looks: gamma variations
+std::vector<CCubeLut3D<float>> make_looks (const size_t count, const LutElement::lutSize lutSize)
+{
+    std::vector<CCubeLut3D<float>> looks (count);
+    for (size_t k = 0; k < count; k++)
+    {
+        const float gamma = 0.5f + 0.1f * static_cast<float>(k);
+        LutBaker::Bake (looks[k], lutSize, [gamma](float r, float g, float b) {
+            return std::array<float, 3>{ std::pow(r, gamma), std::pow(g, 1.f / gamma), b * gamma * 0.5f }; });
+    }
+    return looks;
+}
+
+
+TEST (MultiLut, Equal_To_Separate_Passes)
+{
+    constexpr size_t nLuts = 20u, pixels = 256u * 144u;
+    auto looks = make_looks (nLuts, 33u);
+    std::vector<Interpolator::LatticeView<float>> views;
+    for (auto& l : looks)
+        views.push_back (Interpolator::make_lattice_view (l));
+
+    const std::vector<float> src = random_pixels (pixels);
+    std::vector<std::vector<float>> out (nLuts, std::vector<float>(src.size()));
+    std::vector<float*> dst;
+    for (auto& o : out)
+        dst.push_back (o.data());
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(Interpolator::multi_lut_interpolation (views, src.data(), dst, pixels, 1u), LutErrorCode::LutState::OK);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::vector<float> ref (src.size());
+    int errors = 0;
+    for (size_t k = 0; k < nLuts; k++)
+    {
+        Interpolator::tetrahedral_interpolation (views[k], src.data(), ref.data(), pixels);
+        if (false == near_equal (ref.data(), out[k].data(), ref.size()))
+            errors++;
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(errors, 0);
+
+    std::cout << "Shared cells: " << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count()
+              << " us, separate passes: " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << " us" << std::endl;
+}
+
+
+TEST (MultiLut, Contact_Sheet_Layout)
+{
+    constexpr size_t nLuts = 5u, width = 64u, height = 36u, columns = 3u;
+    auto looks = make_looks (nLuts, 17u);
+    std::vector<Interpolator::LatticeView<float>> views;
+    for (auto& l : looks)
+        views.push_back (Interpolator::make_lattice_view (l));
+
+    const std::vector<float> src = random_pixels (width * height);
+    std::vector<float> sheet (columns * width * 2u * height * 3u, -1.f);
+    EXPECT_EQ(Interpolator::multi_lut_contact_sheet (views, src.data(), width, height, columns, sheet.data()), LutErrorCode::LutState::OK);
+
+    std::vector<float> ref (src.size());
+    int errors = 0;
+    for (size_t k = 0; k < nLuts; k++)
+    {
+        Interpolator::tetrahedral_interpolation (views[k], src.data(), ref.data(), width * height);
+        for (size_t y = 0; y < height; y++)
+        {
+            const float* row = &sheet[(((k / columns) * height + y) * columns * width + (k % columns) * width) * 3u];
+            if (false == near_equal (row, &ref[y * width * 3u], width * 3u))
+                errors++;
+        }
+    }
+    EXPECT_EQ(errors, 0);
+
+    // unused cell of the sheet untouched
+    EXPECT_EQ(sheet.back(), -1.f);
+}
+
+
+TEST (MultiLut, Different_Size_Rejected)
+{
+    auto looks = make_looks (2u, 17u);
+    CCubeLut3D<float> other;
+    ASSERT_EQ(LutBaker::Bake (other, 33u, [](float r, float g, float b) { return std::array<float, 3>{ r, g, b }; }), LutErrorCode::LutState::OK);
+
+    std::vector<Interpolator::LatticeView<float>> views { Interpolator::make_lattice_view (looks[0]), Interpolator::make_lattice_view (other) };
+    std::vector<float> src (3u), out0 (3u), out1 (3u);
+    EXPECT_EQ(Interpolator::multi_lut_interpolation (views, src.data(), { out0.data(), out1.data() }, 1u), LutErrorCode::LutState::IncorrectDimension);
+
+    views[1] = Interpolator::make_lattice_view (looks[1]);
+    EXPECT_EQ(Interpolator::multi_lut_interpolation (views, src.data(), { out0.data() }, 1u), LutErrorCode::LutState::IncorrectDimension);
+    EXPECT_EQ(Interpolator::multi_lut_interpolation (std::vector<Interpolator::LatticeView<float>>{}, src.data(), {}, 1u), LutErrorCode::LutState::NotInitialized);
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
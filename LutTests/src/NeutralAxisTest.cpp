@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+
+constexpr float tolerance = 1e-6f;
+
+// non-linear look with cross-channel mixing
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.7f * r + 0.3f * b), 0.8f * g * g + 0.1f * r, 0.5f + 0.5f * std::sin(3.f * b) * 0.9f };
+}
+
+int count_errors (const std::vector<float>& a, const std::vector<float>& b)
+{
+    int errors = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > tolerance)
+            errors++;
+    return errors;
+}
+
+
+TEST (NeutralAxis, Diagonal_Curve)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 17u, look), LutErrorCode::LutState::OK);
+
+    const auto& axis = lut.getNeutralAxis();
+    ASSERT_EQ(axis.size(), 17u * 3u);
+    const auto ref = look (0.5f, 0.5f, 0.5f);
+    EXPECT_NEAR(axis[8 * 3 + 0], ref[0], tolerance);
+    EXPECT_NEAR(axis[8 * 3 + 1], ref[1], tolerance);
+    EXPECT_NEAR(axis[8 * 3 + 2], ref[2], tolerance);
+
+    // diagonal rebuilt after LUT body modified
+    auto& body = lut.get_data();
+    body[body.size() - 1] = 0.25f;
+    EXPECT_EQ(lut.getNeutralAxis().back(), 0.25f);
+}
+
+
+TEST (NeutralAxis, Cached_Between_Calls)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+
+    // marker in cached diagonal: lost if diagonal rebuilt by interpolation call
+    auto& axis = const_cast<LutElement::lutTable3D<float>&>(lut.getNeutralAxis());
+    const float marker = axis[16 * 3 + 1] + 0.125f;
+    axis[16 * 3 + 1] = marker;
+
+    std::vector<float> src (64u * 3u, 0.5f), dst (src.size());
+    for (int i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(Interpolator::neutral_axis_interpolation (lut, src.data(), dst.data(), 64u, 1u), LutErrorCode::LutState::OK);
+        EXPECT_EQ(lut.getNeutralAxis()[16 * 3 + 1], marker);
+    }
+}
+
+
+TEST (NeutralAxis, Concurrent_Callers_On_One_Lut)
+{
+    CCubeLut3D<float> lut, ref;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    ASSERT_EQ(LutBaker::Bake (ref, 33u, look), LutErrorCode::LutState::OK);
+
+    std::vector<float> src (4096u * 3u), expected (src.size());
+    for (size_t i = 0; i < src.size(); i++)
+        src[i] = static_cast<float>(i / 3u) / 4095.f;
+    ASSERT_EQ(Interpolator::neutral_axis_interpolation (ref, src.data(), expected.data(), 4096u, 1u), LutErrorCode::LutState::OK);
+
+    // first request of diagonal races on cold cache
+    constexpr size_t callers = 8u;
+    std::vector<std::vector<float>> dst (callers, std::vector<float>(src.size()));
+    std::vector<LutErrorCode::LutState> err (callers);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < callers; i++)
+        workers.emplace_back ([&, i]() { err[i] = Interpolator::neutral_axis_interpolation (lut, src.data(), dst[i].data(), 4096u, 1u); });
+    for (auto& t : workers)
+        t.join();
+
+    for (size_t i = 0; i < callers; i++)
+    {
+        EXPECT_EQ(err[i], LutErrorCode::LutState::OK);
+        EXPECT_EQ(count_errors (dst[i], expected), 0);
+    }
+}
+
+
+TEST (NeutralAxis, Equal_To_Tetrahedral)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    // grayscale frame and frame with grayscale and color regions
+    constexpr size_t pixels = 1920u * 64u;
+    std::mt19937 gen(777u);
+    std::uniform_real_distribution<float> dist(-0.1f, 1.1f);
+    std::vector<float> gray (pixels * 3u), mixed (pixels * 3u);
+    for (size_t i = 0; i < pixels; i++)
+    {
+        const float v = dist(gen);
+        gray[i * 3] = gray[i * 3 + 1] = gray[i * 3 + 2] = v;
+        mixed[i * 3] = v;
+        mixed[i * 3 + 1] = (i % 100u < 70u) ? v : dist(gen);
+        mixed[i * 3 + 2] = v;
+    }
+
+    for (const auto* src : { &gray, &mixed })
+    {
+        std::vector<float> fast (src->size()), ref (src->size());
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(Interpolator::neutral_axis_interpolation (lut, src->data(), fast.data(), pixels, 1u), LutErrorCode::LutState::OK);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        Interpolator::tetrahedral_interpolation (view, src->data(), ref.data(), pixels);
+        auto t2 = std::chrono::high_resolution_clock::now();
+
+        EXPECT_EQ(count_errors (fast, ref), 0);
+        std::cout << (src == &gray ? "Gray" : "Mixed") << " frame: neutral path "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count() << " us, tetrahedral "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << " us" << std::endl;
+    }
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include "parallel_text.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// LUT body text: 'size'^3 rows, red fastest, optional comment and blank lines between rows
+static std::string make_body (const uint32_t size, const char* separator, const bool withNoise)
+{
+	std::string text;
+	text.reserve (static_cast<std::size_t>(size) * size * size * 30u);
+	char line[128];
+	const double scale = 1.0 / static_cast<double>(size - 1u);
+	for (uint32_t b = 0u; b < size; b++)
+		for (uint32_t g = 0u; g < size; g++)
+		{
+			if (true == withNoise)
+			{
+				text += "# slice comment";
+				text += separator;
+				text += "   ";
+				text += separator;
+			}
+			for (uint32_t r = 0u; r < size; r++)
+			{
+				const int len = std::snprintf (line, sizeof(line), "%.6f %.6f %.6f%s", r * scale, g * scale, b * scale, separator);
+				text.append (line, static_cast<std::size_t>(len));
+			}
+		}
+	return text;
+}
+
+static bool is_data_row (const string_view& row)
+{
+	return '#' != row[0];
+}
+
+
+TEST (ParallelParse, SameResultForAnyThreadsNumber)
+{
+	for (const char* separator : { "\n", "\r\n", "\r" })
+	{
+		const std::string text = make_body (48u, separator, true);
+		std::vector<float> single, multi;
+		const auto r1 = LutText::parse_rows (text.data(), text.size(), separator[0], ~std::size_t(0), 3u, single, is_data_row, 1u);
+		ASSERT_TRUE(r1.ok());
+		EXPECT_EQ(r1.rows, 48u * 48u * 48u);
+
+		for (const uint32_t threads : { 2u, 3u, 7u, 16u })
+		{
+			const auto rN = LutText::parse_rows (text.data(), text.size(), separator[0], ~std::size_t(0), 3u, multi, is_data_row, threads);
+			EXPECT_TRUE(rN.ok());
+			EXPECT_EQ(rN.rows, r1.rows);
+			EXPECT_TRUE(single == multi) << "threads = " << threads;
+		}
+	}
+}
+
+TEST (ParallelParse, DeterministicErrors)
+{
+	std::string text = make_body (40u, "\n", false);
+	// corrupt rows 50000 and 12345: reported error always the first one in text order
+	for (const std::size_t badRow : { std::size_t(50000u), std::size_t(12345u) })
+	{
+		std::size_t pos = 0u;
+		for (std::size_t i = 0u; i < badRow; i++)
+			pos = text.find ('\n', pos) + 1u;
+		text[pos] = 'x';
+	}
+
+	for (const uint32_t threads : { 1u, 2u, 4u, 8u })
+	{
+		std::vector<double> body;
+		const auto result = LutText::parse_rows (text.data(), text.size(), '\n', ~std::size_t(0), 3u, body, is_data_row, threads);
+		EXPECT_FALSE(result.ok());
+		EXPECT_EQ(result.errorRow, 12345u) << "threads = " << threads;
+	}
+
+	// rows above requested number not parsed: error behind limit ignored
+	std::vector<double> body;
+	const auto limited = LutText::parse_rows (text.data(), text.size(), '\n', 10000u, 3u, body, is_data_row, 4u);
+	EXPECT_TRUE(limited.ok());
+	EXPECT_EQ(limited.parsed, 10000u);
+	EXPECT_EQ(body.size(), 30000u);
+}
+
+TEST (ParallelParse, Cube3D_TruncatedBody)
+{
+	const std::string full = "LUT_3D_SIZE 65\n" + make_body (65u, "\n", false);
+	const std::string truncated = full.substr (0u, full.rfind ('\n', full.size() / 2u) + 1u);
+	CCubeLut3D<float> lut;
+	EXPECT_EQ(lut.LoadFromMemory (truncated.data(), truncated.size()), LutErrorCode::LutState::PrematureEndOfFile);
+	EXPECT_EQ(lut.LoadFromMemory (full.data(), full.size()), LutErrorCode::LutState::OK);
+}
+
+TEST (ParallelParse, Lut3DL_Large)
+{
+	constexpr uint32_t size = 65u;
+	std::string text = "# generated\n";
+	for (uint32_t i = 0u; i < size; i++)
+		text += std::to_string (i * 16u) + (i + 1u < size ? " " : "\n");
+	// 3DL body iterates blue fastest
+	for (uint32_t r = 0u; r < size; r++)
+		for (uint32_t g = 0u; g < size; g++)
+			for (uint32_t b = 0u; b < size; b++)
+				text += std::to_string (r * 64u) + " " + std::to_string (g * 64u) + " " + std::to_string (b * 64u) + "\n";
+
+	CLut3DL<float> lut;
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+	EXPECT_EQ(lut.getLutSize(), size);
+	const auto& body = lut.get_data();
+	ASSERT_EQ(body.size(), size * size * size * 3u);
+	EXPECT_EQ(body[3], 64.f);
+	EXPECT_EQ(body[body.size() - 1u], 4096.f);
+}
+
+TEST (ParallelParse, Csp3D_Large)
+{
+	constexpr uint32_t size = 65u;
+	const std::string text = "CSPLUTV100\n3D\n\n2\n0.0 1.0\n0.0 1.0\n2\n0.0 1.0\n0.0 1.0\n2\n0.0 1.0\n0.0 1.0\n\n65 65 65\n" +
+	                         make_body (size, "\n", false);
+	CCineSpaceLut3D<float> lut;
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+	const auto& body = lut.get_data();
+	ASSERT_EQ(body.size(), size * size * size * 3u);
+	EXPECT_EQ(body[body.size() - 1u], 1.f);
+}
+
+TEST (ParallelParse, Cube129_LoadTime)
+{
+	constexpr uint32_t size = 129u;
+	const std::string body = make_body (size, "\n", false);
+	const std::string text = "TITLE \"Generated\"\nLUT_3D_SIZE 129\n" + body;
+
+	std::vector<float> single;
+	auto const t0 = std::chrono::high_resolution_clock::now();
+	EXPECT_TRUE(LutText::parse_rows (body.data(), body.size(), '\n', ~std::size_t(0), 3u, single, is_data_row, 1u).ok());
+	auto const t1 = std::chrono::high_resolution_clock::now();
+
+	CCubeLut3D<float> lut;
+	auto const t2 = std::chrono::high_resolution_clock::now();
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+	auto const t3 = std::chrono::high_resolution_clock::now();
+	EXPECT_EQ(lut.getLutSize(), size);
+
+	EXPECT_TRUE(lut.get_data() == single);
+
+	std::cout << "129^3 Cube (" << text.size() / (1024u * 1024u) << " MB): single thread "
+	          << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, parallel loader "
+	          << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms (" << LutParallel::threads_number() << " threads)" << std::endl;
+}
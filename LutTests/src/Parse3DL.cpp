@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "lut3DL.h"
+#include <algorithm>
 
 const std::string dbgLutsFolder = { TrDL_LUT_FOLDER };
 
@@ -100,6 +101,53 @@ TEST(Parse3DL, Fuji_Sepia_3DL_f64)
     EXPECT_EQ(result, LutErrorCode::LutState::OK);
 }
 
+TEST(Parse3DL, Custom_14bits_17nodes_native)
+{
+    const std::string lutName{ dbgLutsFolder + "/Custom_14bits_17nodes.3dl" };
+    CLut3DL<float> lutFloat, lutNative;
+    lutNative.setNativeStorageOnly(true);
+    EXPECT_EQ(lutFloat.LoadFile(lutName), LutErrorCode::LutState::OK);
+    EXPECT_EQ(lutNative.LoadFile(lutName), LutErrorCode::LutState::OK);
+
+    // bit depth declared in file comments
+    EXPECT_TRUE(lutFloat.isIntegerBody());
+    EXPECT_EQ(lutFloat.getInputBitDepth(), 14u);
+    EXPECT_EQ(lutFloat.getOutputBitDepth(), 14u);
+    EXPECT_EQ(lutFloat.get_inout_range(), std::make_pair(16383.f, 16383.f));
+
+    // float body holds the same code values, native only storage keeps integer body
+    const auto& native = lutFloat.get_native_data();
+    const auto& body = lutFloat.get_data();
+    ASSERT_EQ(native.size(), 17u * 17u * 17u * 3u);
+    ASSERT_EQ(body.size(), native.size());
+    EXPECT_TRUE(std::equal(native.begin(), native.end(), body.begin(), [](const uint16_t n, const float f) { return static_cast<float>(n) == f; }));
+    EXPECT_TRUE(lutNative.get_data().empty());
+    EXPECT_TRUE(lutNative.get_native_data() == native);
+}
+
+TEST(Parse3DL, Fuji_Sepia_3DL_bit_depth)
+{
+    // no range comments: input depth from grid line maximum, output depth from LUT body maximum
+    const std::string lutName{ dbgLutsFolder + "/Fuji_XTrans_III-Sepia.3dl" };
+    CLut3DL<double> lutFileF64;
+    EXPECT_EQ(lutFileF64.LoadFile(lutName), LutErrorCode::LutState::OK);
+    EXPECT_TRUE(lutFileF64.isIntegerBody());
+    EXPECT_EQ(lutFileF64.getInputBitDepth(), 10u);
+    EXPECT_EQ(lutFileF64.getOutputBitDepth(), 12u);
+    EXPECT_DOUBLE_EQ(lutFileF64.get_native_scale(), 1.0 / 4095.0);
+}
+
+TEST(Parse3DL, Float_Body_Not_Native)
+{
+    const std::string text = "0.0 0.0 0.0\n1.0 0.0 0.0\n0.0 1.0 0.0\n1.0 1.0 0.0\n0.0 0.0 1.0\n1.0 0.0 1.0\n0.0 1.0 1.0\n1.0 1.0 1.0\n";
+    CLut3DL<float> lut;
+    EXPECT_EQ(lut.LoadFromMemory(text.data(), text.size()), LutErrorCode::LutState::OK);
+    EXPECT_FALSE(lut.isIntegerBody());
+    EXPECT_TRUE(lut.get_native_data().empty());
+    EXPECT_EQ(lut.get_data().size(), 24u);
+    EXPECT_EQ(lut.getOutputBitDepth(), 0u);
+}
+
 
 int main (int argc, char** argv)
 {
@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <thread>
+
+using Interpolator::PreviewQuality;
+
+constexpr size_t width = 1920u, height = 1080u;
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { 0.1f + 0.8f * r * r, 0.2f + 0.6f * g, 0.5f + 0.3f * std::sin(2.f * b) };
+}
+
+std::array<float, 3> identity (float r, float g, float b) { return { r, g, b }; }
+
+std::vector<float> smooth_frame (void)
+{
+    std::vector<float> buf (width * height * 3u);
+    for (size_t y = 0; y < height; y++)
+        for (size_t x = 0; x < width; x++)
+        {
+            float* p = &buf[(y * width + x) * 3u];
+            p[0] = static_cast<float>(x) / (width - 1u);
+            p[1] = static_cast<float>(y) / (height - 1u);
+            p[2] = 0.5f + 0.5f * std::sin(static_cast<float>(x + y) * 0.002f);
+        }
+    return buf;
+}
+
+float max_difference (const std::vector<float>& a, const std::vector<float>& b)
+{
+    float maxDiff = 0.f;
+    for (size_t i = 0; i < a.size(); i++)
+        maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]));
+    return maxDiff;
+}
+
+
+TEST (PreviewApply, Reduced_Lut_Cached_On_Object)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, identity), LutErrorCode::LutState::OK);
+
+    const auto& reduced = lut.getPreviewLut (17u);
+    ASSERT_EQ(reduced.size(), 17u * 17u * 17u * 3u);
+    EXPECT_EQ(&reduced, &lut.getPreviewLut (17u));
+    // identity resampled exactly
+    for (size_t b = 0; b < 17u; b++)
+        for (size_t g = 0; g < 17u; g++)
+            for (size_t r = 0; r < 17u; r++)
+            {
+                const float* p = &reduced[((b * 17u + g) * 17u + r) * 3u];
+                EXPECT_NEAR(p[0], r / 16.f, 1e-6f);
+                EXPECT_NEAR(p[1], g / 16.f, 1e-6f);
+                EXPECT_NEAR(p[2], b / 16.f, 1e-6f);
+            }
+
+    // modification of LUT body invalidates reduced LUT
+    for (auto& v : lut.get_data())
+        v *= 0.5f;
+    EXPECT_NEAR(lut.getPreviewLut (17u).back(), 0.5f, 1e-6f);
+
+    // LUT smaller than preview size used as is
+    CCubeLut3D<float> small;
+    ASSERT_EQ(LutBaker::Bake (small, 9u, identity), LutErrorCode::LutState::OK);
+    EXPECT_EQ(&small.getPreviewLut (17u), &small.get_data());
+}
+
+
+TEST (PreviewApply, Reduced_Lut_Kept_Between_Tiers)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+
+    constexpr size_t w = 64u, h = 32u;
+    std::vector<float> src (w * h * 3u, 0.5f), dst (src.size());
+    ASSERT_EQ(Interpolator::preview_interpolation (lut, src.data(), dst.data(), w, h, PreviewQuality::Trilinear), LutErrorCode::LutState::OK);
+
+    // marker in cached reduced LUT: lost if reduced LUT rebuilt
+    auto& reduced = const_cast<LutElement::lutTable3D<float>&>(lut.getPreviewLut (Interpolator::previewLutSize));
+    reduced[0] = -1.f;
+    for (const auto quality : { PreviewQuality::Final, PreviewQuality::Nearest, PreviewQuality::Final, PreviewQuality::Trilinear })
+    {
+        EXPECT_EQ(Interpolator::preview_interpolation (lut, src.data(), dst.data(), w, h, quality), LutErrorCode::LutState::OK);
+        EXPECT_EQ(lut.getPreviewLut (Interpolator::previewLutSize)[0], -1.f);
+    }
+    // other read only users of LUT object keep it as well
+    Interpolator::tetrahedral_interpolation (Interpolator::make_lattice_view (lut), src.data(), dst.data(), w * h);
+    EXPECT_EQ(lut.getPreviewLut (Interpolator::previewLutSize)[0], -1.f);
+}
+
+
+TEST (PreviewApply, Concurrent_Callers_On_One_Lut)
+{
+    CCubeLut3D<float> lut, ref;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    ASSERT_EQ(LutBaker::Bake (ref, 65u, look), LutErrorCode::LutState::OK);
+
+    constexpr size_t w = 256u, h = 64u;
+    std::vector<float> src (w * h * 3u);
+    std::mt19937 gen(11u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    for (auto& v : src)
+        v = dist(gen);
+    std::vector<float> expected (src.size());
+    ASSERT_EQ(Interpolator::preview_interpolation (ref, src.data(), expected.data(), w, h, PreviewQuality::Trilinear, 1u, 1u), LutErrorCode::LutState::OK);
+
+    // first requests of reduced LUTs (shared size and other sizes) race on cold cache
+    constexpr size_t callers = 8u;
+    std::vector<std::vector<float>> dst (callers, std::vector<float>(src.size()));
+    std::vector<LutErrorCode::LutState> err (callers);
+    std::vector<size_t> otherSize (callers);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < callers; i++)
+        workers.emplace_back ([&, i]()
+        {
+            err[i] = Interpolator::preview_interpolation (lut, src.data(), dst[i].data(), w, h, PreviewQuality::Trilinear, 1u, 1u);
+            otherSize[i] = lut.getPreviewLut (9u + i).size();
+        });
+    for (auto& t : workers)
+        t.join();
+
+    for (size_t i = 0; i < callers; i++)
+    {
+        EXPECT_EQ(err[i], LutErrorCode::LutState::OK);
+        EXPECT_TRUE(dst[i] == expected);
+        EXPECT_EQ(otherSize[i], (9u + i) * (9u + i) * (9u + i) * 3u);
+    }
+}
+
+
+TEST (PreviewApply, Tiers_Close_To_Final)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    const std::vector<float> src = smooth_frame();
+    std::vector<float> ref (src.size()), dst (src.size());
+
+    ASSERT_EQ(Interpolator::preview_interpolation (lut, src.data(), ref.data(), width, height, PreviewQuality::Final), LutErrorCode::LutState::OK);
+    std::vector<float> tetra (src.size());
+    Interpolator::tetrahedral_interpolation (Interpolator::make_lattice_view (lut), src.data(), tetra.data(), width * height);
+    EXPECT_TRUE(ref == tetra);
+
+    ASSERT_EQ(Interpolator::preview_interpolation (lut, src.data(), dst.data(), width, height, PreviewQuality::Trilinear), LutErrorCode::LutState::OK);
+    EXPECT_LT(max_difference (ref, dst), 0.005f);
+
+    ASSERT_EQ(Interpolator::preview_interpolation (lut, src.data(), dst.data(), width, height, PreviewQuality::Nearest), LutErrorCode::LutState::OK);
+    EXPECT_LT(max_difference (ref, dst), 0.06f);
+
+    for (const size_t step : { 2u, 4u, 7u })
+    {
+        ASSERT_EQ(Interpolator::preview_interpolation (lut, src.data(), dst.data(), width, height, PreviewQuality::Trilinear, step), LutErrorCode::LutState::OK);
+        EXPECT_LT(max_difference (ref, dst), 0.01f);
+    }
+
+    EXPECT_EQ(Interpolator::preview_interpolation (lut, src.data(), dst.data(), width, height, PreviewQuality::Nearest, 0u), LutErrorCode::LutState::IncorrectDimension);
+}
+
+
+TEST (PreviewApply, Performance)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    const std::vector<float> src = smooth_frame();
+    std::vector<float> dst (src.size());
+    lut.getPreviewLut (Interpolator::previewLutSize);
+
+    for (const auto q : { PreviewQuality::Final, PreviewQuality::Trilinear, PreviewQuality::Nearest })
+        for (const size_t step : { 1u, 4u })
+        {
+            auto t0 = std::chrono::high_resolution_clock::now();
+            Interpolator::preview_interpolation (lut, src.data(), dst.data(), width, height, q, step, 1u);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            std::cout << "Quality " << static_cast<int>(q) << ", step " << step << ": "
+                      << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+        }
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+#include "lutProbe.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include "lutHald.h"
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+const std::string cubeLutsFolder = { CUBE_3D_LUT_FOLDER };
+const std::string cspLutsFolder  = { CSP_LUT_FOLDER };
+const std::string trdlLutsFolder = { TrDL_LUT_FOLDER };
+const std::string haldLutsFolder = { HALD_LUT_FOLDER };
+
+
+TEST (Probe, FormatFromName)
+{
+	EXPECT_EQ(LutProbe::format_from_name ("a/b/Look.CUBE"), LutElement::LutFormat::Cube);
+	EXPECT_EQ(LutProbe::format_from_name ("look.3dl"), LutElement::LutFormat::Lut3DL);
+	EXPECT_EQ(LutProbe::format_from_name ("look.csp"), LutElement::LutFormat::CineSpace);
+	EXPECT_EQ(LutProbe::format_from_name ("hald.HCLUT.png"), LutElement::LutFormat::Hald);
+	EXPECT_EQ(LutProbe::format_from_name ("look.clf"), LutElement::LutFormat::Unknown);
+	EXPECT_EQ(LutProbe::format_from_name ("look"), LutElement::LutFormat::Unknown);
+}
+
+TEST (Probe, Cube_TitleAndDomain)
+{
+	LutProbe::LutInfo<float> info;
+	ASSERT_EQ(LutProbe::probe_file (cubeLutsFolder + "/Small25_with_Domain.cube", info), LutErrorCode::LutState::OK);
+	EXPECT_EQ(info.format, LutElement::LutFormat::Cube);
+	EXPECT_EQ(info.lutSize, 25u);
+	EXPECT_EQ(info.title, "Small LUT with DOMAIN 0.1 - 0.95");
+	EXPECT_FLOAT_EQ(info.domainMin[1], 0.1f);
+	EXPECT_FLOAT_EQ(info.domainMax[2], 0.95f);
+	EXPECT_EQ(info.order, LutElement::AxisOrder::RedFastest);
+	EXPECT_GT(info.fileSize, info.bodyOffset);
+}
+
+TEST (Probe, Lut3DL_GridAndBitDepth)
+{
+	LutProbe::LutInfo<float> info;
+	ASSERT_EQ(LutProbe::probe_file (trdlLutsFolder + "/Custom_10bits_17nodes.3dl", info), LutErrorCode::LutState::OK);
+	EXPECT_EQ(info.format, LutElement::LutFormat::Lut3DL);
+	EXPECT_EQ(info.lutSize, 17u);
+	EXPECT_TRUE(info.integerBody);
+	EXPECT_EQ(info.inBits, 10u);
+	EXPECT_EQ(info.outBits, 10u);
+	EXPECT_EQ(info.order, LutElement::AxisOrder::BlueFastest);
+
+	// without grid line LUT size defined by rows number
+	const std::string text = "# no grid\n0 0 0\n0 0 1\n0 1 0\n0 1 1\n1 0 0\n1 0 1\n1 1 0\n1 1 1\n";
+	ASSERT_EQ(LutProbe::probe_memory (text.data(), text.size(), LutElement::LutFormat::Lut3DL, info), LutErrorCode::LutState::OK);
+	EXPECT_EQ(info.lutSize, 2u);
+	EXPECT_EQ(info.outBits, 0u);
+}
+
+TEST (Probe, CineSpace_Size)
+{
+	LutProbe::LutInfo<float> info;
+	ASSERT_EQ(LutProbe::probe_file (cspLutsFolder + "/linear_3D.csp", info), LutErrorCode::LutState::OK);
+	CCineSpaceLut3D<float> lut;
+	ASSERT_EQ(lut.LoadFile (cspLutsFolder + "/linear_3D.csp"), LutErrorCode::LutState::OK);
+	EXPECT_EQ(info.format, LutElement::LutFormat::CineSpace);
+	EXPECT_EQ(info.lutSize, lut.getLutSize());
+	EXPECT_EQ(info.componentSize[0], lut.getLutComponentSize (LutElement::LutComponent::Red));
+	EXPECT_EQ(info.componentSize[2], lut.getLutComponentSize (LutElement::LutComponent::Blue));
+	EXPECT_EQ(info.title, "XML data will be included later <metadata> <whatever> </whatever> </metadata>");
+	EXPECT_EQ(info.domainMin, (std::array<float, 3>{{ 0.f, 0.f, 0.f }}));
+	EXPECT_EQ(info.domainMax, (std::array<float, 3>{{ 1.f, 1.f, 1.f }}));
+
+	// domain taken from range of pre-LUT input values
+	const std::string text = "CSPLUTV100\n3D\n\nBEGIN METADATA\nshow LUT\nEND METADATA\n\n2\n0 4\n0 1\n3\n-1 0 2\n0 0.5 1\n2\n0 1\n0 1\n\n2 2 2\n"
+	                         "0 0 0\n1 0 0\n0 1 0\n1 1 0\n0 0 1\n1 0 1\n0 1 1\n1 1 1\n";
+	ASSERT_EQ(LutProbe::probe_memory (text.data(), text.size(), LutElement::LutFormat::CineSpace, info), LutErrorCode::LutState::OK);
+	EXPECT_EQ(info.title, "show LUT");
+	EXPECT_EQ(info.domainMin, (std::array<float, 3>{{ 0.f, -1.f, 0.f }}));
+	EXPECT_EQ(info.domainMax, (std::array<float, 3>{{ 4.f,  2.f, 1.f }}));
+	EXPECT_EQ(info.lutSize, 2u);
+}
+
+TEST (Probe, Hald_IHDR)
+{
+	LutProbe::LutInfo<float> info;
+	ASSERT_EQ(LutProbe::probe_file (haldLutsFolder + "/contrast.HCLUT.png", info), LutErrorCode::LutState::OK);
+	EXPECT_EQ(info.format, LutElement::LutFormat::Hald);
+	EXPECT_EQ(info.lutSize, 64u);
+	EXPECT_EQ(info.outBits, 8u);
+
+	ASSERT_EQ(LutProbe::probe_file (haldLutsFolder + "/neutral_hald_512.png", info), LutErrorCode::LutState::OK);
+	EXPECT_EQ(info.lutSize, 64u);
+	EXPECT_EQ(info.outBits, 16u);
+
+	const std::string notPng = "definitely not a PNG file content";
+	EXPECT_EQ(LutProbe::probe_memory (notPng.data(), notPng.size(), LutElement::LutFormat::Hald, info), LutErrorCode::LutState::ReadError);
+}
+
+TEST (Probe, Errors)
+{
+	LutProbe::LutInfo<float> info;
+	EXPECT_EQ(LutProbe::probe_file (cubeLutsFolder + "/not_exists.cube", info), LutErrorCode::LutState::FileNotOpened);
+	EXPECT_EQ(LutProbe::probe_file (cubeLutsFolder + "/Tiny.unknown", info), LutErrorCode::LutState::NonImplemented);
+	const std::string oneD = "LUT_1D_SIZE 2\n0 0 0\n1 1 1\n";
+	EXPECT_EQ(LutProbe::probe_memory (oneD.data(), oneD.size(), LutElement::LutFormat::Cube, info), LutErrorCode::LutState::IncorrectDimension);
+}
+
+TEST (Probe, LazyLut_ParsesOnFirstAccess)
+{
+	const std::string lutName { cubeLutsFolder + "/Small25.cube" };
+	LutProbe::CLazyLut<float> lazy;
+	ASSERT_EQ(lazy.Open (lutName), LutErrorCode::LutState::OK);
+	EXPECT_FALSE(lazy.isLoaded());
+	EXPECT_EQ(lazy.getInfo().lutSize, 25u);
+
+	CCubeLut3D<float> eager;
+	ASSERT_EQ(eager.LoadFile (lutName), LutErrorCode::LutState::OK);
+	EXPECT_TRUE(lazy.get_data() == eager.get_data());
+	EXPECT_TRUE(lazy.isLoaded());
+
+	lazy.Unload();
+	EXPECT_FALSE(lazy.isLoaded());
+	EXPECT_EQ(lazy.get_data().size(), 25u * 25u * 25u * 3u);
+
+	// broken header: body never parsed, empty data returned
+	LutProbe::CLazyLut<float> missing;
+	EXPECT_EQ(missing.Open (cubeLutsFolder + "/not_exists.cube"), LutErrorCode::LutState::FileNotOpened);
+	EXPECT_TRUE(missing.get_data().empty());
+}
+
+TEST (Probe, LazyLut_Concurrent_Access)
+{
+	// body parsed once and shared by all threads requesting it at the same time
+	LutProbe::CLazyLut<float> lazy;
+	ASSERT_EQ(lazy.Open (cubeLutsFolder + "/Small25.cube"), LutErrorCode::LutState::OK);
+	constexpr std::size_t threads = 4u;
+	std::vector<const LutElement::lutTable3D<float>*> data (threads, nullptr);
+	std::vector<std::thread> workers;
+	for (std::size_t i = 0u; i < threads; i++)
+		workers.emplace_back ([&lazy, &data, i]() { data[i] = &lazy.get_data(); });
+	for (auto& w : workers)
+		w.join();
+	for (const auto* d : data)
+	{
+		EXPECT_EQ(d, data[0]);
+		EXPECT_EQ(d->size(), 25u * 25u * 25u * 3u);
+	}
+	EXPECT_EQ(lazy.getLastError(), LutErrorCode::LutState::OK);
+}
+
+TEST (Probe, LazyLut_Hald)
+{
+	LutProbe::CLazyLut<float> lazy;
+	ASSERT_EQ(lazy.Open (haldLutsFolder + "/contrast.HCLUT.png"), LutErrorCode::LutState::OK);
+	EXPECT_EQ(lazy.getInfo().lutSize, 64u);
+	EXPECT_EQ(lazy.get_data().size(), 64u * 64u * 64u * 3u);
+	EXPECT_EQ(lazy.Load(), LutErrorCode::LutState::OK);
+}
+
+TEST (Probe, Library_Time)
+{
+	// probe of every file vs complete load of every file
+	const std::vector<std::string> files =
+	{
+		cubeLutsFolder + "/Small25.cube", cubeLutsFolder + "/MagicHour.cube", cubeLutsFolder + "/Identify_33.cube",
+		trdlLutsFolder + "/Test.3dl", trdlLutsFolder + "/Fuji_XTrans_III-Sepia.3dl",
+		cspLutsFolder  + "/linear_3D.csp", haldLutsFolder + "/contrast.HCLUT.png"
+	};
+	constexpr int repeat = 20;
+
+	LutProbe::LutInfo<float> info;
+	auto const start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < repeat; i++)
+		for (const auto& name : files)
+			EXPECT_EQ(LutProbe::probe_file (name, info), LutErrorCode::LutState::OK) << name;
+	auto const probed = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < repeat; i++)
+		for (const auto& name : files)
+		{
+			LutProbe::CLazyLut<float> lut;
+			lut.Open (name);
+			EXPECT_EQ(lut.Load(), LutErrorCode::LutState::OK) << name;
+		}
+	auto const loaded = std::chrono::high_resolution_clock::now();
+
+	const double files_number = static_cast<double>(repeat * files.size());
+	std::cout << "Probe: " << std::chrono::duration<double, std::micro>(probed - start).count() / files_number << " us per file, full load: "
+	          << std::chrono::duration<double, std::micro>(loaded - probed).count() / files_number << " us per file" << std::endl;
+}
@@ -0,0 +1,285 @@
+#include "gtest/gtest.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include "lutHald.h"
+#include "crc_utils.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+const std::string haldLutsFolder = { HALD_LUT_FOLDER };
+
+
+static std::string make_cube (const uint32_t size)
+{
+	std::ostringstream text;
+	text << "LUT_3D_SIZE " << size << "\n";
+	const double scale = 1.0 / static_cast<double>(size - 1u);
+	for (uint32_t b = 0u; b < size; b++)
+		for (uint32_t g = 0u; g < size; g++)
+			for (uint32_t r = 0u; r < size; r++)
+				text << r * scale << " " << g * scale << " " << b * scale << "\n";
+	return text.str();
+}
+
+static void put_be32 (std::vector<uint8_t>& out, const uint32_t value)
+{
+	out.push_back (static_cast<uint8_t>(value >> 24));
+	out.push_back (static_cast<uint8_t>(value >> 16));
+	out.push_back (static_cast<uint8_t>(value >> 8));
+	out.push_back (static_cast<uint8_t>(value));
+}
+
+// PNG chunk with valid CRC; declared length may differ from real data size
+static void put_chunk (std::vector<uint8_t>& png, const char* name, const std::vector<uint8_t>& data, const uint32_t declaredLength)
+{
+	put_be32 (png, declaredLength);
+	std::vector<uint8_t> body (name, name + 4);
+	body.insert (body.end(), data.begin(), data.end());
+	png.insert (png.end(), body.begin(), body.end());
+	put_be32 (png, crc32_reflected (body));
+}
+
+static void put_chunk (std::vector<uint8_t>& png, const char* name, const std::vector<uint8_t>& data)
+{
+	put_chunk (png, name, data, static_cast<uint32_t>(data.size()));
+}
+
+static std::vector<uint8_t> png_signature (void)
+{
+	return { 0x89u, 0x50u, 0x4Eu, 0x47u, 0x0Du, 0x0Au, 0x1Au, 0x0Au };
+}
+
+static std::vector<uint8_t> ihdr_rgb8 (const uint32_t width, const uint32_t height)
+{
+	std::vector<uint8_t> ihdr;
+	put_be32 (ihdr, width);
+	put_be32 (ihdr, height);
+	ihdr.insert (ihdr.end(), { 8u, 2u, 0u, 0u, 0u });  // 8 bits, RGB, deflate, no filter, no interlace
+	return ihdr;
+}
+
+// zlib stream with single stored block holding 'raw' bytes
+static std::vector<uint8_t> zlib_stored (const std::vector<uint8_t>& raw)
+{
+	std::vector<uint8_t> z { 0x78u, 0x01u, 0x01u };
+	const uint16_t len = static_cast<uint16_t>(raw.size());
+	z.insert (z.end(), { static_cast<uint8_t>(len), static_cast<uint8_t>(len >> 8), static_cast<uint8_t>(~len), static_cast<uint8_t>(~len >> 8) });
+	z.insert (z.end(), raw.begin(), raw.end());
+	uint32_t a = 1u, b = 0u;
+	for (const uint8_t v : raw)
+		a = (a + v) % 65521u, b = (b + a) % 65521u;
+	put_be32 (z, (b << 16) | a);
+	return z;
+}
+
+static std::string write_png (const std::string& name, const std::vector<uint8_t>& png)
+{
+	const std::string fileName { haldLutsFolder + "/" + name };
+	std::ofstream file (fileName, std::ios::binary | std::ios::trunc);
+	file.write (reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+	return fileName;
+}
+
+// 8x8 RGB image (4^3 Hald) with 'raw' as content of IDAT stream
+static std::string write_hald_4 (const std::string& name, const std::vector<uint8_t>& raw)
+{
+	std::vector<uint8_t> png = png_signature();
+	put_chunk (png, "IHDR", ihdr_rgb8 (8u, 8u));
+	put_chunk (png, "IDAT", zlib_stored (raw));
+	put_chunk (png, "IEND", {});
+	return write_png (name, png);
+}
+
+
+TEST (ResourceLimits, Cube_InputAndLattice)
+{
+	const std::string text = make_cube (33u);
+	CCubeLut3D<float> lut;
+	ASSERT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+
+	LutLimits::LoadLimits limits;
+	limits.maxInputBytes = text.size() - 1u;
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::ResourceLimitExceeded);
+
+	limits = LutLimits::LoadLimits{};
+	limits.maxLatticePoints = 17u * 17u * 17u;
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::ResourceLimitExceeded);
+	EXPECT_TRUE(lut.get_data().empty());
+
+	limits = LutLimits::LoadLimits{};
+	limits.maxDecodedBytes = 33u * 33u * 33u * 3u * sizeof(float);
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+}
+
+TEST (ResourceLimits, Cube_Deadline)
+{
+	const std::string text = make_cube (65u);
+	CCubeLut3D<float> lut;
+	LutLimits::LoadLimits limits;
+	limits.timeout = std::chrono::milliseconds (1);
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::ResourceLimitExceeded);
+
+	limits.timeout = std::chrono::milliseconds (60000);
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+}
+
+TEST (ResourceLimits, Lut3DL_WithoutLineBreaks)
+{
+	// 4 MB of numbers in one line: read as grid line, rejected after lut3DMaxSize + 1 values
+	std::string text;
+	for (uint32_t i = 0u; i < 1000000u; i++)
+		text += "512 ";
+	CLut3DL<float> lut;
+	auto const start = std::chrono::high_resolution_clock::now();
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::LutSizeOutOfRange);
+	std::size_t bodyOffset = 0u;
+	EXPECT_EQ(lut.LoadHeader (text.data(), text.size(), bodyOffset), LutErrorCode::LutState::LutSizeOutOfRange);
+	auto const stop = std::chrono::high_resolution_clock::now();
+	std::cout << "3DL without line breaks rejected in " << std::chrono::duration<double, std::micro>(stop - start).count() << " us" << std::endl;
+}
+
+TEST (ResourceLimits, Lut3DL_RowsLimit)
+{
+	// no grid line: LUT size defined by rows, rows above limit never stored
+	std::string text;
+	for (uint32_t i = 0u; i < 17u * 17u * 17u; i++)
+		text += "0 512 1023\n";
+	CLut3DL<float> lut;
+	ASSERT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::OK);
+
+	LutLimits::LoadLimits limits;
+	limits.maxLatticePoints = 9u * 9u * 9u;
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::ResourceLimitExceeded);
+	EXPECT_EQ(lut.getLutSize(), 0u);
+
+	// grid line declares LUT size above limit: body not parsed at all
+	const std::string grid = "0 64 128 192 256 320 384 448 512 576 640 704 768 832 896 960 1023\n" + text;
+	EXPECT_EQ(lut.LoadFromMemory (grid.data(), grid.size()), LutErrorCode::LutState::ResourceLimitExceeded);
+}
+
+TEST (ResourceLimits, CineSpace_PreLutSize)
+{
+	// pre-LUT size far above number of values in line: pre-LUT rejected without allocation, LUT not loaded
+	const std::string text = "CSPLUTV100\n3D\n\n4000000000\n0 1\n0 1\n2\n0 1\n0 1\n2\n0 1\n0 1\n\n2 2 2\n"
+	                         "0 0 0\n1 0 0\n0 1 0\n1 1 0\n0 0 1\n1 0 1\n0 1 1\n1 1 1\n";
+	CCineSpaceLut3D<float> lut;
+	lut.LoadFromMemory (text.data(), text.size());
+	EXPECT_EQ(lut.getLutSize(), 0u);
+	EXPECT_TRUE(lut.get_data().empty());
+
+	const std::string valid = "CSPLUTV100\n3D\n\n2\n0 1\n0 1\n2\n0 1\n0 1\n2\n0 1\n0 1\n\n2 2 2\n"
+	                          "0 0 0\n1 0 0\n0 1 0\n1 1 0\n0 0 1\n1 0 1\n0 1 1\n1 1 1\n";
+	ASSERT_EQ(lut.LoadFromMemory (valid.data(), valid.size()), LutErrorCode::LutState::OK);
+	LutLimits::LoadLimits limits;
+	limits.maxLatticePoints = 7u;
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFromMemory (valid.data(), valid.size()), LutErrorCode::LutState::ResourceLimitExceeded);
+}
+
+TEST (ResourceLimits, CineSpace_DeclaredSizeWithoutBody)
+{
+	// 1024^3 nodes declared by few bytes of text: no memory reserved for declared size without limits set
+	const std::string text = "CSPLUTV100\n3D\n\n2\n0 1\n0 1\n2\n0 1\n0 1\n2\n0 1\n0 1\n\n1024 1024 1024\n0 0 0\n1 1 1\n";
+	CCineSpaceLut3D<double> lut;
+	EXPECT_EQ(lut.LoadFromMemory (text.data(), text.size()), LutErrorCode::LutState::CouldNotParseTableData);
+	EXPECT_LT(lut.get_data().capacity(), 1024u);
+}
+
+TEST (ResourceLimits, Hald_ForgedIHDR)
+{
+	std::vector<uint8_t> png = png_signature();
+	put_chunk (png, "IHDR", ihdr_rgb8 (65535u, 65535u));
+	put_chunk (png, "IDAT", zlib_stored (std::vector<uint8_t>(64u, 0u)));
+	put_chunk (png, "IEND", {});
+	const std::string huge = write_png ("forged_ihdr_65535.png", png);
+
+	CHaldLut<float> lut;
+	EXPECT_EQ(lut.LoadFile (huge), LutErrorCode::LutState::LutSizeInvalid);
+
+	// 65536^2 pixels overflows 32 bits product of width and height; 41^3 x 41^3 is Hald of 1681^3 nodes
+	for (const uint32_t width : { 65536u, 68921u })
+	{
+		png = png_signature();
+		put_chunk (png, "IHDR", ihdr_rgb8 (width, width));
+		put_chunk (png, "IDAT", zlib_stored (std::vector<uint8_t>(64u, 0u)));
+		put_chunk (png, "IEND", {});
+		const std::string forged = write_png ("forged_ihdr_" + std::to_string (width) + ".png", png);
+		EXPECT_EQ(lut.LoadFile (forged), (65536u == width ? LutErrorCode::LutState::LutSizeInvalid : LutErrorCode::LutState::LutSizeOutOfRange));
+		EXPECT_TRUE(lut.get_data().empty());
+	}
+
+	// valid 8 x 8 geometry, but image data shorter than rows declared by IHDR
+	const std::string shortData = write_hald_4 ("forged_ihdr_short.png", std::vector<uint8_t>(64u, 0u));
+	EXPECT_NE(lut.LoadFile (shortData), LutErrorCode::LutState::OK);
+	EXPECT_TRUE(lut.get_data().empty());
+
+	// 4096 x 4096 image (256^3 Hald) above lattice limit: rejected before decoding
+	png = png_signature();
+	put_chunk (png, "IHDR", ihdr_rgb8 (4096u, 4096u));
+	put_chunk (png, "IDAT", zlib_stored (std::vector<uint8_t>(64u, 0u)));
+	put_chunk (png, "IEND", {});
+	const std::string big = write_png ("forged_ihdr_4096.png", png);
+	LutLimits::LoadLimits limits;
+	limits.maxLatticePoints = 65u * 65u * 65u;
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFile (big), LutErrorCode::LutState::ResourceLimitExceeded);
+}
+
+TEST (ResourceLimits, Hald_ChunkSize)
+{
+	// declared chunk sizes above file size or negative: chunk not allocated and not read
+	for (const uint32_t declared : { 0x7FFFFFF0u, 0xFFFFFFF0u })
+	{
+		std::vector<uint8_t> png = png_signature();
+		put_chunk (png, "IHDR", ihdr_rgb8 (8u, 8u));
+		put_chunk (png, "IDAT", std::vector<uint8_t>(16u, 0u), declared);
+		const std::string name = write_png ("forged_chunk_size.png", png);
+		CHaldLut<float> lut;
+		EXPECT_NE(lut.LoadFile (name), LutErrorCode::LutState::OK);
+		EXPECT_TRUE(lut.get_data().empty());
+	}
+}
+
+TEST (ResourceLimits, Hald_DecodedSize)
+{
+	// image data matches IHDR: 8 rows of filter byte + 8 RGB pixels
+	std::vector<uint8_t> raw (8u * (1u + 8u * 3u), 0x40u);
+	for (std::size_t row = 0u; row < 8u; row++)
+		raw[row * 25u] = 0u;
+	CHaldLut<float> lut;
+	ASSERT_EQ(lut.LoadFile (write_hald_4 ("exact_4.png", raw)), LutErrorCode::LutState::OK);
+	EXPECT_EQ(lut.get_data().size(), 4u * 4u * 4u * 3u);
+
+	// stream decoded to more than IHDR declares: decoding stopped at expected size
+	raw.resize (raw.size() + 100u, 0x40u);
+	CHaldLut<float> bomb;
+	EXPECT_EQ(bomb.LoadFile (write_hald_4 ("bomb_4.png", raw)), LutErrorCode::LutState::ResourceLimitExceeded);
+}
+
+TEST (ResourceLimits, Hald_LimitsOnValidFile)
+{
+	const std::string lutName { haldLutsFolder + "/contrast.HCLUT.png" };
+	CHaldLut<float> lut;
+	LutLimits::LoadLimits limits;
+	limits.maxDecodedBytes = 1024u * 1024u;
+	lut.setLoadLimits (limits);
+	EXPECT_EQ(lut.LoadFile (lutName), LutErrorCode::LutState::ResourceLimitExceeded);
+
+	CHaldLut<float> small;
+	limits.maxDecodedBytes = 64u * 1024u * 1024u;
+	limits.maxLatticePoints = 64u * 64u * 64u;
+	limits.timeout = std::chrono::milliseconds (60000);
+	small.setLoadLimits (limits);
+	EXPECT_EQ(small.LoadFile (lutName), LutErrorCode::LutState::OK);
+	EXPECT_EQ(small.getLutSize(), 64u);
+}
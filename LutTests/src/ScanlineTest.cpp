@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <random>
+
+constexpr size_t width = 1920u, height = 1080u;
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.6f * r + 0.4f * g), 0.9f * g * g + 0.05f, 0.5f + 0.45f * std::sin(3.f * b) };
+}
+
+// smooth gradients with mild noise, values slightly outside of [0...1] on borders
+std::vector<float> smooth_frame (void)
+{
+    std::mt19937 gen(3u);
+    std::uniform_real_distribution<float> noise(-0.001f, 0.001f);
+    std::vector<float> buf (width * height * 3u);
+    for (size_t y = 0; y < height; y++)
+        for (size_t x = 0; x < width; x++)
+        {
+            float* p = &buf[(y * width + x) * 3u];
+            p[0] = -0.02f + 1.04f * static_cast<float>(x) / width + noise(gen);
+            p[1] = 0.5f + 0.4f * std::sin(static_cast<float>(y) * 0.01f) + noise(gen);
+            p[2] = 0.3f + 0.2f * static_cast<float>(x + y) / (width + height) + noise(gen);
+        }
+    return buf;
+}
+
+
+TEST (Scanline, Equal_To_Tetrahedral)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    std::vector<float> src = smooth_frame();
+    // random pixels also evaluated correctly
+    std::mt19937 gen(4u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    for (size_t i = 0; i < width * 3u * 10u; i++)
+        src[i] = dist(gen);
+
+    std::vector<float> ref (src.size()), dst (src.size());
+    Interpolator::tetrahedral_interpolation (view, src.data(), ref.data(), width * height);
+
+    Interpolator::ScanlineStats stats;
+    ASSERT_EQ(Interpolator::scanline_interpolation (lut, src.data(), dst.data(), width, height, 0u, &stats), LutErrorCode::LutState::OK);
+    float maxDiff = 0.f;
+    for (size_t i = 0; i < dst.size(); i++)
+        maxDiff = std::max(maxDiff, std::abs(dst[i] - ref[i]));
+    EXPECT_LE(maxDiff, 1e-6f);
+    EXPECT_EQ(stats.pixels, width * height);
+    EXPECT_GT(stats.hit_rate(), 0.8);
+
+    // in-place
+    ASSERT_EQ(Interpolator::scanline_interpolation (lut, src.data(), src.data(), width, height), LutErrorCode::LutState::OK);
+    EXPECT_TRUE(src == dst);
+}
+
+
+TEST (Scanline, Random_Frame_Low_Hit_Rate)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    std::mt19937 gen(5u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float> src (640u * 480u * 3u), dst (src.size());
+    for (auto& v : src)
+        v = dist(gen);
+
+    Interpolator::ScanlineStats stats;
+    ASSERT_EQ(Interpolator::scanline_interpolation (lut, src.data(), dst.data(), 640u, 480u, 2u, &stats), LutErrorCode::LutState::OK);
+    EXPECT_LT(stats.hit_rate(), 0.01);
+    EXPECT_EQ(Interpolator::scanline_interpolation (lut, src.data(), dst.data(), 0u, 480u), LutErrorCode::LutState::IncorrectDimension);
+}
+
+
+TEST (Scanline, Performance)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+    const std::vector<float> src = smooth_frame();
+    std::vector<float> dst (src.size());
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    Interpolator::tetrahedral_interpolation (view, src.data(), dst.data(), width * height);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    Interpolator::scanline_interpolation (view, src.data(), dst.data(), width, height, 1u);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Tetrahedral: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms; scanline: "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << std::endl;
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
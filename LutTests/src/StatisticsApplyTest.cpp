@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+
+constexpr size_t width = 640u, height = 360u;
+
+// look pushing highlights out of [0...1]
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { 1.3f * r - 0.1f, g * g, 0.2f + 0.7f * b };
+}
+
+std::vector<float> random_frame (void)
+{
+    std::mt19937 gen(5u);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float> buf(width * height * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+
+TEST (StatisticsApply, Equal_To_Separate_Pass)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+    const std::vector<float> src = random_frame();
+
+    std::vector<float> dst (src.size());
+    Interpolator::FrameStatistics<float> stats (64u, 32u, 100u);
+    ASSERT_EQ(Interpolator::statistics_interpolation (lut, src.data(), dst.data(), width, height, stats), LutErrorCode::LutState::OK);
+
+    // reference: apply LUT, then second pass over output frame
+    std::vector<float> ref (src.size());
+    Interpolator::tetrahedral_interpolation (view, src.data(), ref.data(), width * height);
+    EXPECT_TRUE(ref == dst);
+
+    std::array<std::vector<uint64_t>, 3> hist { std::vector<uint64_t>(64u), std::vector<uint64_t>(64u), std::vector<uint64_t>(64u) };
+    std::vector<uint64_t> waveform (32u * 100u);
+    uint64_t clipped = 0u;
+    for (size_t y = 0; y < height; y++)
+        for (size_t x = 0; x < width; x++)
+        {
+            const float* in = &src[(y * width + x) * 3u];
+            const float* out = &ref[(y * width + x) * 3u];
+            const auto raw = look (in[0], in[1], in[2]);
+            if (raw[0] < -1e-4f || raw[0] > 1.0001f)
+                clipped++;
+            for (size_t c = 0; c < 3; c++)
+            {
+                const float binScale = 64.f / (view.domainMax[c] - view.domainMin[c]);
+                hist[c][std::min(static_cast<size_t>((out[c] - view.domainMin[c]) * binScale), size_t(63))]++;
+            }
+            const float luma = 0.2126f * out[0] + 0.7152f * out[1] + 0.0722f * out[2];
+            waveform[(x * 32u / width) * 100u + std::min(static_cast<size_t>(luma * 100.f), size_t(99))]++;
+        }
+
+    EXPECT_EQ(stats.pixels, width * height);
+    // exact LUT output near clip boundary differs from analytic look only by interpolation error
+    EXPECT_NEAR(static_cast<double>(stats.clippedPixels), static_cast<double>(clipped), 0.001 * width * height);
+    EXPECT_NEAR(stats.minValue[0], -0.1f, 0.01f);
+    EXPECT_NEAR(stats.maxValue[0],  1.2f, 0.01f);
+
+    uint64_t histDiff = 0u, wfDiff = 0u;
+    for (size_t c = 0; c < 3; c++)
+        for (size_t i = 0; i < 64u; i++)
+            histDiff += (stats.histogram[c][i] > hist[c][i] ? stats.histogram[c][i] - hist[c][i] : hist[c][i] - stats.histogram[c][i]);
+    for (size_t i = 0; i < waveform.size(); i++)
+        wfDiff += (stats.waveform[i] > waveform[i] ? stats.waveform[i] - waveform[i] : waveform[i] - stats.waveform[i]);
+    // values exactly on bin edge may fall to neighbour bin due to floating point contraction
+    EXPECT_LE(histDiff, 16u);
+    EXPECT_LE(wfDiff, 16u);
+}
+
+
+TEST (StatisticsApply, Merge_Independent_Of_Threads)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 17u, look), LutErrorCode::LutState::OK);
+    const std::vector<float> src = random_frame();
+    std::vector<float> dst (src.size());
+
+    Interpolator::FrameStatistics<float> single (256u, 64u), multi (256u, 64u);
+    ASSERT_EQ(Interpolator::statistics_interpolation (lut, src.data(), dst.data(), width, height, single, 1u), LutErrorCode::LutState::OK);
+    ASSERT_EQ(Interpolator::statistics_interpolation (lut, src.data(), dst.data(), width, height, multi, 7u), LutErrorCode::LutState::OK);
+
+    EXPECT_TRUE(single.histogram == multi.histogram);
+    EXPECT_TRUE(single.waveform == multi.waveform);
+    EXPECT_EQ(single.clippedPixels, multi.clippedPixels);
+    EXPECT_EQ(single.minValue, multi.minValue);
+    EXPECT_EQ(single.maxValue, multi.maxValue);
+
+    // statistics reset on each frame
+    ASSERT_EQ(Interpolator::statistics_interpolation (lut, src.data(), dst.data(), width, height, multi), LutErrorCode::LutState::OK);
+    EXPECT_EQ(multi.pixels, width * height);
+}
+
+
+uint64_t abs_difference (const std::vector<uint64_t>& a, const std::vector<uint64_t>& b)
+{
+    uint64_t diff = 0u;
+    for (size_t i = 0; i < a.size() && i < b.size(); i++)
+        diff += (a[i] > b[i] ? a[i] - b[i] : b[i] - a[i]);
+    return diff;
+}
+
+
+TEST (StatisticsApply, Collected_By_Image_Apply)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+
+    // U16 planar source, dithered U8 interleaved output
+    std::mt19937 gen(9u);
+    std::vector<uint16_t> r (width * height), g (width * height), b (width * height);
+    std::vector<float> decoded (width * height * 3u);
+    for (size_t i = 0; i < width * height; i++)
+    {
+        r[i] = static_cast<uint16_t>(gen()); g[i] = static_cast<uint16_t>(gen()); b[i] = static_cast<uint16_t>(gen());
+        decoded[i * 3u + 0] = static_cast<float>(r[i]) * (1.f / 65535.f);
+        decoded[i * 3u + 1] = static_cast<float>(g[i]) * (1.f / 65535.f);
+        decoded[i * 3u + 2] = static_cast<float>(b[i]) * (1.f / 65535.f);
+    }
+    std::vector<uint8_t> out (width * height * 3u), plain (out.size());
+    const auto srcView = Interpolator::make_planar_view (r.data(), g.data(), b.data(), nullptr, width, height, Interpolator::PixelFormat::U16);
+    const auto outView = Interpolator::make_interleaved_view (out.data(), width, height, Interpolator::PixelFormat::U8, false);
+    const auto plainView = Interpolator::make_interleaved_view (plain.data(), width, height, Interpolator::PixelFormat::U8, false);
+
+    Interpolator::FrameStatistics<float> stats (64u, 32u, 100u), ref (64u, 32u, 100u);
+    stats.pixels = 12345u; // stale values of previous frame dropped
+    ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, outView, Interpolator::DitherMode::BlueNoise, 5u, &stats), LutErrorCode::LutState::OK);
+    ASSERT_EQ(Interpolator::image_interpolation (lut, srcView, plainView, Interpolator::DitherMode::BlueNoise, 3u), LutErrorCode::LutState::OK);
+    // image unchanged by statistics collection; value on rounding edge may move by 1 LSB due to floating point contraction
+    size_t moved = 0u;
+    for (size_t i = 0; i < out.size(); i++)
+    {
+        EXPECT_LE(std::abs(static_cast<int>(out[i]) - static_cast<int>(plain[i])), 1);
+        moved += (out[i] != plain[i] ? 1u : 0u);
+    }
+    EXPECT_LE(moved, 16u);
+
+    // reference: separate statistics pass over decoded frame
+    std::vector<float> tmp (decoded.size());
+    ASSERT_EQ(Interpolator::statistics_interpolation (lut, decoded.data(), tmp.data(), width, height, ref), LutErrorCode::LutState::OK);
+
+    EXPECT_EQ(stats.pixels, width * height);
+    EXPECT_EQ(stats.clippedPixels, ref.clippedPixels);
+    for (size_t c = 0; c < 3; c++)
+    {
+        EXPECT_NEAR(stats.minValue[c], ref.minValue[c], 1e-6f);
+        EXPECT_NEAR(stats.maxValue[c], ref.maxValue[c], 1e-6f);
+        // values exactly on bin edge may fall to neighbour bin due to floating point contraction
+        EXPECT_LE(abs_difference (stats.histogram[c], ref.histogram[c]), 16u);
+    }
+    EXPECT_LE(abs_difference (stats.waveform, ref.waveform), 16u);
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
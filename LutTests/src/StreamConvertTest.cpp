@@ -0,0 +1,235 @@
+#include "gtest/gtest.h"
+#include "lutStream.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cube text (red fastest), node value is smooth function of lattice coordinates in [0...1]
+static std::string make_cube (const uint32_t size)
+{
+	std::ostringstream text;
+	text << "TITLE \"stream\"\nLUT_3D_SIZE " << size << "\n";
+	const double scale = 1.0 / static_cast<double>(size - 1u);
+	for (uint32_t b = 0u; b < size; b++)
+		for (uint32_t g = 0u; g < size; g++)
+			for (uint32_t r = 0u; r < size; r++)
+				text << r * scale << " " << (g * scale) * (g * scale) << " " << 1.0 - b * scale << "\n";
+	return text.str();
+}
+
+// 3DL text (blue fastest) with 10 bits grid and 12 bits integer body, node value encodes its lattice coordinates
+static std::string make_3dl (const uint32_t size)
+{
+	std::string text = "# OUTPUT RANGE: 12\n";
+	for (uint32_t i = 0u; i < size; i++)
+		text += std::to_string (i * 1023u / (size - 1u)) + (i + 1u < size ? " " : "\n");
+	for (uint32_t r = 0u; r < size; r++)
+		for (uint32_t g = 0u; g < size; g++)
+			for (uint32_t b = 0u; b < size; b++)
+				text += std::to_string (r * 100u) + " " + std::to_string (g * 10u) + " " + std::to_string (4095u - b) + "\n";
+	return text;
+}
+
+static LutErrorCode::LutState stream_convert
+(
+	const std::string& src,
+	const LutStream::LutFormat srcFormat,
+	std::ostringstream& dst,
+	const LutStream::LutFormat dstFormat,
+	const LutStream::StreamOptions& options = {}
+)
+{
+	LutStream::CLutRowReader<float> reader;
+	LutErrorCode::LutState err = reader.OpenMemory (src.data(), src.size(), srcFormat);
+	if (LutErrorCode::LutState::OK != err)
+		return err;
+	LutStream::CLutRowWriter<float> writer;
+	if (LutErrorCode::LutState::OK != (err = writer.Open (dst, dstFormat, reader.getHeader(), options)))
+		return err;
+	return LutStream::stream_rows (reader, writer, options);
+}
+
+
+TEST (StreamConvert, RingBuffer_KeepsOrder)
+{
+	LutStream::CRowRing<float> ring (7u);
+	constexpr std::size_t rows = 10000u;
+	std::thread producer ([&]()
+	{
+		for (std::size_t i = 0u; i < rows; i += 3u)
+		{
+			float chunk[9];
+			const std::size_t n = std::min(static_cast<std::size_t>(3u), rows - i);
+			for (std::size_t j = 0u; j < n * 3u; j++)
+				chunk[j] = static_cast<float>(i * 3u + j);
+			ring.Push (chunk, n);
+		}
+		ring.Close();
+	});
+
+	std::vector<float> received;
+	float chunk[15];
+	std::size_t n = 0u;
+	while (0u != (n = ring.Pop (chunk, 5u)))
+		received.insert (received.end(), chunk, chunk + n * 3u);
+	producer.join();
+
+	ASSERT_EQ(received.size(), rows * 3u);
+	bool ordered = true;
+	for (std::size_t i = 0u; i < received.size(); i++)
+		ordered = ordered && (received[i] == static_cast<float>(i));
+	EXPECT_TRUE(ordered);
+}
+
+TEST (StreamConvert, Cube_To_CSP)
+{
+	const std::string src = make_cube (17u);
+	std::ostringstream dst;
+	ASSERT_EQ(stream_convert (src, LutStream::LutFormat::Cube, dst, LutStream::LutFormat::CineSpace), LutErrorCode::LutState::OK);
+
+	CCubeLut3D<float> cube;
+	CCineSpaceLut3D<float> csp;
+	const std::string out = dst.str();
+	ASSERT_EQ(cube.LoadFromMemory (src.data(), src.size()), LutErrorCode::LutState::OK);
+	ASSERT_EQ(csp.LoadFromMemory (out.data(), out.size()), LutErrorCode::LutState::OK);
+	EXPECT_EQ(csp.getLutSize(), 17u);
+
+	const auto& a = cube.get_data();
+	const auto& b = csp.get_data();
+	ASSERT_EQ(a.size(), b.size());
+	float maxDiff = 0.f;
+	for (std::size_t i = 0u; i < a.size(); i++)
+		maxDiff = std::max(maxDiff, std::fabs (a[i] - b[i]));
+	EXPECT_LE(maxDiff, 1e-6f);
+}
+
+TEST (StreamConvert, CSP_PreLut_To_Cube)
+{
+	// linear pre-LUT [0...4] -> [0...1] on every channel is input domain of LUT
+	const std::string body = "0 0 0\n1 0 0\n0 0.5 0\n1 0.5 0\n0 0 1\n1 0 1\n0 0.5 1\n1 0.5 1\n";
+	const std::string src = "CSPLUTV100\n3D\n\nBEGIN METADATA\ngraded\nEND METADATA\n\n"
+	                        "2\n0 4\n0 1\n3\n0 2 4\n0 0.5 1\n2\n0 4\n0 1\n\n2 2 2\n" + body;
+	std::ostringstream dstCube;
+	ASSERT_EQ(stream_convert (src, LutStream::LutFormat::CineSpace, dstCube, LutStream::LutFormat::Cube), LutErrorCode::LutState::OK);
+
+	const std::string outCube = dstCube.str();
+	CCubeLut3D<float> cube;
+	CCineSpaceLut3D<float> csp;
+	ASSERT_EQ(cube.LoadFromMemory (outCube.data(), outCube.size()), LutErrorCode::LutState::OK);
+	ASSERT_EQ(csp.LoadFromMemory (src.data(), src.size()), LutErrorCode::LutState::OK);
+	EXPECT_EQ(cube.getTitle(), "graded");
+	const auto domain = cube.getMinMaxDomain();
+	EXPECT_EQ(domain.first,  (std::vector<float>{ 0.f, 0.f, 0.f }));
+	EXPECT_EQ(domain.second, (std::vector<float>{ 4.f, 4.f, 4.f }));
+	EXPECT_TRUE(cube.get_data() == csp.get_data());
+
+	// Cube -> CSP -> Cube keeps domain, title and body
+	std::ostringstream dstCsp, dstBack;
+	ASSERT_EQ(stream_convert (outCube, LutStream::LutFormat::Cube, dstCsp, LutStream::LutFormat::CineSpace), LutErrorCode::LutState::OK);
+	ASSERT_EQ(stream_convert (dstCsp.str(), LutStream::LutFormat::CineSpace, dstBack, LutStream::LutFormat::Cube), LutErrorCode::LutState::OK);
+	EXPECT_EQ(dstBack.str(), outCube);
+
+	// non-linear pre-LUT can not be expressed by domain; 3DL has no domain at all
+	std::string nonLinear = src;
+	nonLinear.replace (nonLinear.find ("0 0.5 1\n2"), 7u, "0 0.8 1");
+	std::ostringstream dst1, dst2;
+	EXPECT_EQ(stream_convert (nonLinear, LutStream::LutFormat::CineSpace, dst1, LutStream::LutFormat::Cube), LutErrorCode::LutState::NonImplemented);
+	EXPECT_EQ(stream_convert (src, LutStream::LutFormat::CineSpace, dst2, LutStream::LutFormat::Lut3DL), LutErrorCode::LutState::NonImplemented);
+}
+
+TEST (StreamConvert, Lut3DL_To_Cube_Reordered)
+{
+	// blue fastest source to red fastest target: same result for single pass and for one slab per pass
+	constexpr uint32_t size = 9u;
+	const std::string src = make_3dl (size);
+	LutStream::StreamOptions onePass, slabPerPass;
+	slabPerPass.blockBytes = 1u;
+
+	std::ostringstream dst1, dst2;
+	ASSERT_EQ(stream_convert (src, LutStream::LutFormat::Lut3DL, dst1, LutStream::LutFormat::Cube, onePass), LutErrorCode::LutState::OK);
+	ASSERT_EQ(stream_convert (src, LutStream::LutFormat::Lut3DL, dst2, LutStream::LutFormat::Cube, slabPerPass), LutErrorCode::LutState::OK);
+	EXPECT_EQ(dst1.str(), dst2.str());
+
+	// converted Cube matches canonical body of 3DL loader scaled by native scale
+	CLut3DL<float> lut3dl;
+	CCubeLut3D<float> cube;
+	const std::string out = dst1.str();
+	ASSERT_EQ(lut3dl.LoadFromMemory (src.data(), src.size()), LutErrorCode::LutState::OK);
+	ASSERT_EQ(cube.LoadFromMemory (out.data(), out.size()), LutErrorCode::LutState::OK);
+	const auto& ref = lut3dl.get_data();
+	const auto& body = cube.get_data();
+	ASSERT_EQ(body.size(), ref.size());
+	const float scale = lut3dl.get_native_scale();
+	float maxDiff = 0.f;
+	for (std::size_t i = 0u; i < ref.size(); i++)
+		maxDiff = std::max(maxDiff, std::fabs (ref[i] * scale - body[i]));
+	EXPECT_LE(maxDiff, 1e-6f);
+}
+
+TEST (StreamConvert, Cube_To_3DL_RoundTrip)
+{
+	constexpr uint32_t size = 17u;
+	const std::string src = make_cube (size);
+	std::ostringstream dst3dl, dstCube;
+	ASSERT_EQ(stream_convert (src, LutStream::LutFormat::Cube, dst3dl, LutStream::LutFormat::Lut3DL), LutErrorCode::LutState::OK);
+
+	const std::string text3dl = dst3dl.str();
+	CLut3DL<float> lut3dl;
+	ASSERT_EQ(lut3dl.LoadFromMemory (text3dl.data(), text3dl.size()), LutErrorCode::LutState::OK);
+	EXPECT_EQ(lut3dl.getLutSize(), size);
+	EXPECT_TRUE(lut3dl.isIntegerBody());
+	EXPECT_EQ(lut3dl.getInputBitDepth(), 10u);
+	EXPECT_EQ(lut3dl.getOutputBitDepth(), 12u);
+
+	ASSERT_EQ(stream_convert (text3dl, LutStream::LutFormat::Lut3DL, dstCube, LutStream::LutFormat::Cube), LutErrorCode::LutState::OK);
+	CCubeLut3D<float> original, restored;
+	const std::string outCube = dstCube.str();
+	ASSERT_EQ(original.LoadFromMemory (src.data(), src.size()), LutErrorCode::LutState::OK);
+	ASSERT_EQ(restored.LoadFromMemory (outCube.data(), outCube.size()), LutErrorCode::LutState::OK);
+	const auto& a = original.get_data();
+	const auto& b = restored.get_data();
+	ASSERT_EQ(a.size(), b.size());
+	float maxDiff = 0.f;
+	for (std::size_t i = 0u; i < a.size(); i++)
+		maxDiff = std::max(maxDiff, std::fabs (a[i] - b[i]));
+	EXPECT_LE(maxDiff, 0.5f / 4095.f + 1e-6f);
+}
+
+TEST (StreamConvert, Errors)
+{
+	std::string src = make_cube (5u);
+	std::ostringstream dst1, dst2, dst3;
+
+	// truncated body
+	const std::string truncated = src.substr (0u, src.rfind ('\n', src.size() - 2u) + 1u);
+	EXPECT_EQ(stream_convert (truncated, LutStream::LutFormat::Cube, dst1, LutStream::LutFormat::CineSpace), LutErrorCode::LutState::PrematureEndOfFile);
+
+	// broken row in the middle of body
+	std::size_t pos = 0u;
+	for (uint32_t i = 0u; i < 20u; i++)
+		pos = src.find ('\n', pos) + 1u;
+	src.insert (pos, "x");
+	EXPECT_EQ(stream_convert (src, LutStream::LutFormat::Cube, dst2, LutStream::LutFormat::Cube), LutErrorCode::LutState::CouldNotParseTableData);
+
+	// header without LUT size
+	const std::string noSize = "TITLE \"none\"\n0 0 0\n";
+	EXPECT_EQ(stream_convert (noSize, LutStream::LutFormat::Cube, dst3, LutStream::LutFormat::Cube), LutErrorCode::LutState::GenericError);
+}
+
+TEST (StreamConvert, Cube65_Reordered_Time)
+{
+	const std::string src = make_cube (65u);
+	std::ostringstream dst;
+	LutStream::StreamOptions options;
+	options.blockBytes = 65u * 65u * 3u * sizeof(float) * 8u;    // 8 slabs per pass: 9 passes over source
+	auto const start = std::chrono::high_resolution_clock::now();
+	EXPECT_EQ(stream_convert (src, LutStream::LutFormat::Cube, dst, LutStream::LutFormat::Lut3DL, options), LutErrorCode::LutState::OK);
+	auto const stop = std::chrono::high_resolution_clock::now();
+	std::cout << "65^3 Cube to 3DL streamed in " << std::chrono::duration<double, std::milli>(stop - start).count() << " ms" << std::endl;
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <limits>
+
+constexpr float tolerance = 1e-6f;
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.7f * r + 0.3f * b), 0.8f * g * g + 0.1f * r, 0.5f + 0.45f * std::sin(3.f * b) };
+}
+
+std::vector<float> random_pixels (const size_t pixels, const float minVal, const float maxVal)
+{
+    std::mt19937 gen(2024u);
+    std::uniform_real_distribution<float> dist(minVal, maxVal);
+    std::vector<float> buf(pixels * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+int count_errors (const std::vector<float>& a, const std::vector<float>& b)
+{
+    int errors = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        if (std::abs(a[i] - b[i]) > tolerance)
+            errors++;
+    return errors;
+}
+
+
+TEST (SubCube, Region)
+{
+    std::array<size_t, 3> origin, size;
+    Interpolator::sub_lattice_region (65u, std::array<float, 3>{{ 0.f, 0.1f, 0.5f }}, std::array<float, 3>{{ 0.2f, 0.1f, 1.5f }}, origin, size);
+    EXPECT_EQ(origin[0], 0u);   EXPECT_EQ(size[0], 14u);   // cubes 0...12 -> nodes 0...13
+    EXPECT_EQ(origin[1], 6u);   EXPECT_EQ(size[1], 2u);    // single cube
+    EXPECT_EQ(origin[2], 32u);  EXPECT_EQ(size[2], 33u);   // input clipped to 1.0 -> last cube 62
+}
+
+
+TEST (SubCube, Dark_Frame_Equal_To_Full_Lattice)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    // dim interior shot: small part of the cube
+    constexpr size_t pixels = 1920u * 108u;
+    const std::vector<float> src = random_pixels (pixels, 0.05f, 0.35f);
+    std::vector<float> dst (src.size()), ref (src.size());
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    EXPECT_TRUE(Interpolator::subcube_interpolation (lut, src.data(), dst.data(), pixels, 1u));
+    auto t1 = std::chrono::high_resolution_clock::now();
+    Interpolator::tetrahedral_interpolation (view, src.data(), ref.data(), pixels);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    EXPECT_EQ(count_errors (dst, ref), 0);
+    std::cout << "Sub-cube: " << std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count()
+              << " us, full lattice: " << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << " us" << std::endl;
+}
+
+
+TEST (SubCube, Full_Range_Frame_Uses_Full_Lattice)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+
+    constexpr size_t pixels = 10000u;
+    const std::vector<float> src = random_pixels (pixels, -0.1f, 1.1f);
+    std::vector<float> dst (src.size()), ref (src.size());
+    EXPECT_FALSE(Interpolator::subcube_interpolation (lut, src.data(), dst.data(), pixels));
+    Interpolator::tetrahedral_interpolation (Interpolator::make_lattice_view (lut), src.data(), ref.data(), pixels);
+    EXPECT_EQ(count_errors (dst, ref), 0);
+}
+
+
+TEST (SubCube, NaN_Pixel_Uses_Full_Lattice)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+
+    // dark frame with single NaN pixel (not first one): NaN skipped by bounds, but clipped into top cube
+    constexpr size_t pixels = 1001u;
+    std::vector<float> src (pixels * 3u, 0.1f);
+    src[500u * 3u + 1u] = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> dst (src.size()), ref (src.size());
+    EXPECT_FALSE(Interpolator::subcube_interpolation (lut, src.data(), dst.data(), pixels, 1u));
+    Interpolator::tetrahedral_interpolation (Interpolator::make_lattice_view (lut), src.data(), ref.data(), pixels);
+    EXPECT_EQ(count_errors (dst, ref), 0);
+
+    // Inf rejected the same way, finite frame still uses sub-cube
+    src[500u * 3u + 1u] = std::numeric_limits<float>::infinity();
+    EXPECT_FALSE(Interpolator::subcube_interpolation (lut, src.data(), dst.data(), pixels, 1u));
+    src[500u * 3u + 1u] = 0.1f;
+    EXPECT_TRUE(Interpolator::subcube_interpolation (lut, src.data(), dst.data(), pixels, 1u));
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
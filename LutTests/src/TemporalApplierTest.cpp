@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <random>
+
+constexpr size_t width = 1280u, height = 720u;
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.6f * r + 0.4f * g), 0.9f * g * g + 0.05f, 0.5f + 0.45f * std::sin(3.f * b) };
+}
+
+std::vector<float> random_frame (const uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    std::vector<float> buf (width * height * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+// moving overlay: box of random pixels at new position on static background
+void draw_box (std::vector<float>& frame, size_t x0, size_t y0, size_t w, size_t h, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    for (size_t y = y0; y < y0 + h; y++)
+        for (size_t x = x0; x < x0 + w; x++)
+            for (size_t c = 0; c < 3u; c++)
+                frame[(y * width + x) * 3u + c] = dist(gen);
+}
+
+
+TEST (TemporalApplier, Equal_To_Full_Frame_Apply)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    Lut::CTemporalApplier<float> applier;
+    ASSERT_EQ(applier.SetLut (lut), LutErrorCode::LutState::OK);
+
+    const std::vector<float> background = random_frame (1u);
+    std::vector<float> ref (background.size()), dst (background.size());
+    for (uint32_t f = 0; f < 5u; f++)
+    {
+        std::vector<float> frame (background);
+        draw_box (frame, 100u + f * 50u, 200u, 120u, 40u, f);
+        Interpolator::tetrahedral_interpolation (view, frame.data(), ref.data(), width * height);
+
+        ASSERT_EQ(applier.Apply (frame.data(), dst.data(), width, height), LutErrorCode::LutState::OK);
+        EXPECT_TRUE(ref == dst);
+
+        const auto& stats = applier.LastFrameStats();
+        EXPECT_EQ(stats.tiles, 20u * 45u);
+        if (0u == f)
+            EXPECT_EQ(stats.reusedTiles, 0u);
+        else
+            EXPECT_GT(stats.reuse_rate(), 0.95);
+    }
+    EXPECT_EQ(applier.TotalStats().tiles, 5u * 20u * 45u);
+}
+
+
+TEST (TemporalApplier, In_Place_And_Reset)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 17u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    Lut::CTemporalApplier<float> applier;
+    std::vector<float> frame = random_frame (2u);
+    EXPECT_EQ(applier.Apply (frame.data(), frame.data(), width, height), LutErrorCode::LutState::NotInitialized);
+    ASSERT_EQ(applier.SetLut (lut), LutErrorCode::LutState::OK);
+
+    const std::vector<float> input (frame);
+    std::vector<float> ref (frame.size());
+    Interpolator::tetrahedral_interpolation (view, input.data(), ref.data(), width * height);
+
+    for (int i = 0; i < 2; i++)
+    {
+        frame = input;
+        ASSERT_EQ(applier.Apply (frame.data(), frame.data(), width, height, 3u), LutErrorCode::LutState::OK);
+        EXPECT_TRUE(ref == frame);
+    }
+    EXPECT_EQ(applier.LastFrameStats().reuse_rate(), 1.0);
+
+    applier.Reset();
+    frame = input;
+    ASSERT_EQ(applier.Apply (frame.data(), frame.data(), width, height), LutErrorCode::LutState::OK);
+    EXPECT_EQ(applier.LastFrameStats().reusedTiles, 0u);
+
+    // frame size change drops history
+    ASSERT_EQ(applier.Apply (frame.data(), frame.data(), width / 2u, height), LutErrorCode::LutState::OK);
+    EXPECT_EQ(applier.LastFrameStats().reusedTiles, 0u);
+}
+
+
+TEST (TemporalApplier, Performance)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 65u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+    Lut::CTemporalApplier<float> applier;
+    ASSERT_EQ(applier.SetLut (lut), LutErrorCode::LutState::OK);
+
+    std::vector<float> frame = random_frame (3u), dst (frame.size());
+    applier.Apply (frame.data(), dst.data(), width, height, 1u);
+    draw_box (frame, 500u, 300u, 64u, 64u, 9u);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    Interpolator::tetrahedral_interpolation (view, frame.data(), dst.data(), width * height);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    applier.Apply (frame.data(), dst.data(), width, height, 1u);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Full frame: " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms; temporal: "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms (reused "
+              << applier.LastFrameStats().reuse_rate() * 100.0 << "% tiles)" << std::endl;
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,219 @@
+#include "gtest/gtest.h"
+#include "text_tokenizer.h"
+#include "lutCube3D.h"
+#include "lut3DL.h"
+#include "lutCineSpace3D.h"
+#include <string>
+#include <vector>
+
+const std::string dbgLutsFolder = { CUBE_3D_LUT_FOLDER };
+
+static std::string with_separator (const std::string& text, const std::string& separator)
+{
+	std::string out;
+	for (const char c : text)
+	{
+		if ('\n' == c)
+			out += separator;
+		else
+			out += c;
+	}
+	return out;
+}
+
+static std::vector<std::string> all_lines (const std::string& text)
+{
+	std::vector<std::string> lines;
+	LutText::CTextTokenizer tokenizer (text.data(), text.size());
+	string_view line;
+	while (tokenizer.next_line(line))
+		lines.emplace_back(line.data(), line.size());
+	return lines;
+}
+
+static const std::string tinyCube =
+	"# tiny cube\n"
+	"TITLE \"Tiny\"\n"
+	"LUT_3D_SIZE 2\n"
+	"DOMAIN_MIN 0.0 0.0 0.0\n"
+	"DOMAIN_MAX 1.0 1.0 1.0\n"
+	"\n"
+	"0.0 0.0 0.0\n"
+	"1.0 0.0 0.0\n"
+	"0.0 1.0 0.0\n"
+	"1.0 1.0 0.0\n"
+	"0.0 0.0 1.0\n"
+	"1.0 0.0 1.0\n"
+	"0.0 1.0 1.0\n"
+	"1.0 1.0 1.0\n";
+
+
+TEST (TextTokenizer, LineSeparators)
+{
+	const std::string text = "first line\nsecond\n\nlast";
+	const std::vector<std::string> expected = { "first line", "second", "", "last" };
+
+	EXPECT_EQ(all_lines(text), expected);
+	EXPECT_EQ(all_lines(with_separator(text, "\r\n")), expected);
+	EXPECT_EQ(all_lines(with_separator(text, "\r")), expected);
+
+	LutText::CTextTokenizer cr ("a\rb", 3u);
+	EXPECT_EQ(cr.separator(), '\r');
+	LutText::CTextTokenizer crlf ("a\r\nb", 4u);
+	EXPECT_EQ(crlf.separator(), '\n');
+
+	LutText::CTextTokenizer empty (nullptr, 10u);
+	string_view line;
+	EXPECT_FALSE(empty.next_line(line));
+	EXPECT_TRUE(empty.eof());
+}
+
+TEST (TextTokenizer, Tokens)
+{
+	string_view line { "  0.5\t-1e-3   +2  " };
+	EXPECT_EQ(LutText::count_tokens(line), 3u);
+	EXPECT_EQ(LutText::count_tokens(line, 2u), 2u);
+
+	float values[4] = {};
+	EXPECT_EQ(LutText::parse_numbers(line, values, 4u), 3u);
+	EXPECT_EQ(values[0], 0.5f);
+	EXPECT_EQ(values[1], -1e-3f);
+	EXPECT_EQ(values[2], 2.f);
+
+	double d = 0.0;
+	EXPECT_FALSE(LutText::parse_number(string_view{ "1.0abc" }, d));
+	EXPECT_FALSE(LutText::parse_number(string_view{ "" }, d));
+
+	uint32_t n = 0u;
+	EXPECT_TRUE(LutText::parse_integer(string_view{ "33" }, n));
+	EXPECT_EQ(n, 33u);
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "3.3" }, n));
+
+	// out of range of target type rejected instead of truncated
+	EXPECT_TRUE(LutText::parse_integer(string_view{ "4294967295" }, n));
+	EXPECT_EQ(n, 4294967295u);
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "4294967298" }, n));
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "-1" }, n));
+	int32_t i32 = 0;
+	EXPECT_TRUE(LutText::parse_integer(string_view{ "-2147483648" }, i32));
+	EXPECT_EQ(i32, INT32_MIN);
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "2147483648" }, i32));
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "-2147483649" }, i32));
+	int64_t i64 = 0;
+	EXPECT_TRUE(LutText::parse_integer(string_view{ "9223372036854775807" }, i64));
+	EXPECT_EQ(i64, INT64_MAX);
+	EXPECT_TRUE(LutText::parse_integer(string_view{ "-9223372036854775808" }, i64));
+	EXPECT_EQ(i64, INT64_MIN);
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "9223372036854775808" }, i64));
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "9223372036854775810" }, i64));
+	uint64_t u64 = 0u;
+	EXPECT_TRUE(LutText::parse_integer(string_view{ "18446744073709551615" }, u64));
+	EXPECT_EQ(u64, UINT64_MAX);
+	EXPECT_FALSE(LutText::parse_integer(string_view{ "18446744073709551616" }, u64));
+
+	EXPECT_EQ(LutText::trim(string_view{ " \t text \r" }), string_view{ "text" });
+}
+
+TEST (TextTokenizer, Cube3D_Separators)
+{
+	for (const std::string separator : { "\n", "\r\n", "\r" })
+	{
+		const std::string text = with_separator(tinyCube, separator);
+		CCubeLut3D<float> lut;
+		EXPECT_EQ(lut.LoadFromMemory(text.data(), text.size()), LutErrorCode::LutState::OK);
+		EXPECT_EQ(lut.getLutSize(), 2u);
+
+		const auto& body = lut.get_data();
+		ASSERT_EQ(body.size(), 24u);
+		// red channel changes fastest
+		for (std::size_t i = 0; i < 8u; i++)
+		{
+			EXPECT_EQ(body[i * 3u + 0u], static_cast<float>(i & 1u));
+			EXPECT_EQ(body[i * 3u + 1u], static_cast<float>((i >> 1) & 1u));
+			EXPECT_EQ(body[i * 3u + 2u], static_cast<float>((i >> 2) & 1u));
+		}
+	}
+}
+
+TEST (TextTokenizer, Cube3D_Errors)
+{
+	CCubeLut3D<float> lut;
+	const std::string badDomain = "LUT_3D_SIZE 2\nDOMAIN_MIN 0.0 0.0\n";
+	EXPECT_NE(lut.LoadFromMemory(badDomain.data(), badDomain.size()), LutErrorCode::LutState::OK);
+
+	const std::string truncated = tinyCube.substr(0, tinyCube.size() - 12u);
+	EXPECT_NE(lut.LoadFromMemory(truncated.data(), truncated.size()), LutErrorCode::LutState::OK);
+
+	// 2^32 + 2 not truncated to 2
+	std::string hugeSize = tinyCube;
+	hugeSize.replace(hugeSize.find("LUT_3D_SIZE 2"), 13u, "LUT_3D_SIZE 4294967298");
+	EXPECT_EQ(lut.LoadFromMemory(hugeSize.data(), hugeSize.size()), LutErrorCode::LutState::LutSizeOutOfRange);
+}
+
+TEST (TextTokenizer, Lut3DL_Memory)
+{
+	// 3DL body iterates blue fastest
+	std::string text = "# 3DL comment\n0 341 682 1023\n";
+	for (uint32_t r = 0u; r < 4u; r++)
+		for (uint32_t g = 0u; g < 4u; g++)
+			for (uint32_t b = 0u; b < 4u; b++)
+				text += std::to_string(r * 1365u) + " " + std::to_string(g * 1365u) + " " + std::to_string(b * 1365u) + "\n";
+
+	for (const std::string separator : { "\n", "\r\n", "\r" })
+	{
+		const std::string lutText = with_separator(text, separator);
+		CLut3DL<float> lut;
+		EXPECT_EQ(lut.LoadFromMemory(lutText.data(), lutText.size()), LutErrorCode::LutState::OK);
+		EXPECT_EQ(lut.getLutSize(), 4u);
+		const auto& body = lut.get_data();
+		ASSERT_EQ(body.size(), 4u * 4u * 4u * 3u);
+		EXPECT_EQ(body[3], 1365.f);
+		EXPECT_EQ(body[body.size() - 1u], 4095.f);
+	}
+
+	// number of entries not a cube
+	const std::string broken = "0 0 0\n1 1 1\n2 2 2\n";
+	CLut3DL<float> lut;
+	EXPECT_EQ(lut.LoadFromMemory(broken.data(), broken.size()), LutErrorCode::LutState::CouldNotParseTableData);
+}
+
+TEST (TextTokenizer, Csp3D_Memory)
+{
+	std::string text =
+		"CSPLUTV100\n3D\n\n"
+		"BEGIN METADATA\nsome text\nEND METADATA\n\n"
+		"2\n0.0 1.0\n0.0 1.0\n"
+		"2\n0.0 1.0\n0.0 1.0\n"
+		"2\n0.0 1.0\n0.0 1.0\n\n"
+		"2 2 2\n";
+	for (uint32_t i = 0u; i < 8u; i++)
+		text += std::to_string(0.125 * i) + " 0.5 0.25\n";
+
+	for (const std::string separator : { "\n", "\r\n", "\r" })
+	{
+		const std::string lutText = with_separator(text, separator);
+		CCineSpaceLut3D<double> lut;
+		EXPECT_EQ(lut.LoadFromMemory(lutText.data(), lutText.size()), LutErrorCode::LutState::OK);
+		const auto& body = lut.get_data();
+		ASSERT_EQ(body.size(), 24u);
+		for (uint32_t i = 0u; i < 8u; i++)
+		{
+			EXPECT_DOUBLE_EQ(body[i * 3u + 0u], 0.125 * i);
+			EXPECT_DOUBLE_EQ(body[i * 3u + 1u], 0.5);
+			EXPECT_DOUBLE_EQ(body[i * 3u + 2u], 0.25);
+		}
+	}
+}
+
+TEST (TextTokenizer, FileAndMemoryIdentical)
+{
+	const std::string lutName{ dbgLutsFolder + "/MagicHour.cube" };
+	LutText::CMappedFile file { lutName };
+	ASSERT_TRUE(file.good());
+
+	CCubeLut3D<float> fromFile, fromMemory;
+	EXPECT_EQ(fromFile.LoadFile(lutName), LutErrorCode::LutState::OK);
+	EXPECT_EQ(fromMemory.LoadFromMemory(file.data(), file.size()), LutErrorCode::LutState::OK);
+	EXPECT_EQ(fromFile.getLutSize(), fromMemory.getLutSize());
+	EXPECT_TRUE(fromFile.get_data() == fromMemory.get_data());
+}
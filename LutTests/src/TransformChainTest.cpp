@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+
+constexpr float tolerance = 1e-5f;
+
+// affine transform with output inside [0...1] for input inside [0...1]
+constexpr std::array<float, 9> mixMatrix {{ 0.5f, 0.3f, 0.2f,   0.2f, 0.6f, 0.2f,   0.1f, 0.1f, 0.8f }};
+
+std::array<float, 3> mix (float r, float g, float b)
+{
+    return { mixMatrix[0] * r + mixMatrix[1] * g + mixMatrix[2] * b,
+             mixMatrix[3] * r + mixMatrix[4] * g + mixMatrix[5] * b,
+             mixMatrix[6] * r + mixMatrix[7] * g + mixMatrix[8] * b };
+}
+
+std::vector<float> random_pixels (const size_t pixels, const float minVal = 0.f, const float maxVal = 1.f)
+{
+    std::mt19937 gen(12345u);
+    std::uniform_real_distribution<float> dist(minVal, maxVal);
+    std::vector<float> buf(pixels * 3u);
+    for (auto& v : buf)
+        v = dist(gen);
+    return buf;
+}
+
+
+TEST (TransformChain, Tetrahedral_Exact_On_Affine_Lut)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 17u, mix), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    const std::vector<float> src = random_pixels (10000u);
+    std::vector<float> dst (src.size());
+    Interpolator::tetrahedral_interpolation (view, src.data(), dst.data(), src.size() / 3u);
+
+    int errors = 0;
+    for (size_t i = 0; i < src.size(); i += 3)
+    {
+        const auto ref = mix (src[i], src[i + 1], src[i + 2]);
+        for (int c = 0; c < 3; c++)
+            if (std::abs(ref[c] - dst[i + c]) > tolerance)
+                errors++;
+    }
+    EXPECT_EQ(errors, 0);
+
+    // lattice corners reproduced exactly
+    const auto white = Interpolator::tetrahedral_interpolation (lut.get_data(), 1.f, 1.f, 1.f, lut.getMinMaxDomain().first, lut.getMinMaxDomain().second, lut.getLutSize());
+    EXPECT_NEAR(white[0], 1.f, tolerance);
+    EXPECT_NEAR(white[1], 1.f, tolerance);
+    EXPECT_NEAR(white[2], 1.f, tolerance);
+}
+
+
+TEST (TransformChain, Fuse_Matrix_And_Range)
+{
+    Lut::CTransformChain<float> chain;
+    EXPECT_EQ(chain.AddMatrix (mixMatrix, {{ 0.1f, 0.f, -0.1f }}), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.AddMatrix ({{ 2.f, 0.f, 0.f,  0.f, 2.f, 0.f,  0.f, 0.f, 2.f }}), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.stages(), 1u);
+
+    // range without clamp folded into matrix completely
+    EXPECT_EQ(chain.AddRange (0.f, 2.f, 0.f, 1.f, false), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.stages(), 1u);
+
+    // range with clamp leaves clamp only
+    EXPECT_EQ(chain.AddRange (0.f, 1.f, 0.f, 1.f, true), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.stages(), 2u);
+    EXPECT_TRUE(chain.stage_type(0) == Lut::CTransformChain<float>::StageType::Matrix);
+    EXPECT_TRUE(chain.stage_type(1) == Lut::CTransformChain<float>::StageType::Range);
+
+    const auto out = chain.Apply (0.2f, 0.4f, 1.f);
+    const auto ref = mix (0.2f, 0.4f, 1.f);
+    EXPECT_NEAR(out[0], std::min(1.f, ref[0] + 0.1f), tolerance);
+    EXPECT_NEAR(out[1], ref[1], tolerance);
+    EXPECT_NEAR(out[2], std::max(0.f, ref[2] - 0.1f), tolerance);
+}
+
+
+TEST (TransformChain, Matrix_Shaper_Lut3D_Equal_To_Separate_Passes)
+{
+    // log-like shaper as 1D LUT, then 3D LUT
+    CCubeLut1D<float> shaper;
+    ASSERT_EQ(LutBaker::Bake (shaper, 1024u, [](float r, float g, float b) {
+        return std::array<float, 3>{ std::sqrt(r), std::sqrt(g), std::sqrt(b) }; }), LutErrorCode::LutState::OK);
+    CCubeLut3D<float> look;
+    ASSERT_EQ(LutBaker::Bake (look, 33u, [](float r, float g, float b) {
+        return std::array<float, 3>{ r * r, 0.5f * (g + b), 1.f - b }; }), LutErrorCode::LutState::OK);
+
+    Lut::CTransformChain<float> chain;
+    const std::array<float, 9> toWide {{ 0.6f, 0.3f, 0.1f,  0.1f, 0.8f, 0.1f,  0.0f, 0.1f, 0.9f }};
+    EXPECT_EQ(chain.AddMatrix (toWide), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.AddRange (0.f, 1.f, 0.f, 1.f, true), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.AddLut1D (shaper), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.AddLut3D (look), LutErrorCode::LutState::OK);
+    EXPECT_EQ(chain.stages(), 4u);
+
+    constexpr size_t pixels = 1920u * 10u;
+    const std::vector<float> src = random_pixels (pixels, -0.1f, 1.1f);
+    std::vector<float> fused (src.size()), fusedSingle (src.size()), separate (src);
+
+    chain.Apply (src.data(), fused.data(), pixels);
+    chain.Apply (src.data(), fusedSingle.data(), pixels, 1u);
+    EXPECT_TRUE(fused == fusedSingle);
+
+    // reference: stage by stage over full frame
+    const auto lookView = Interpolator::make_lattice_view (look);
+    const auto& shaperBody = shaper.get_data();
+    for (size_t i = 0; i < separate.size(); i += 3)
+    {
+        float* p = &separate[i];
+        const float r = p[0], g = p[1], b = p[2];
+        for (int c = 0; c < 3; c++)
+        {
+            float v = toWide[c * 3] * r + toWide[c * 3 + 1] * g + toWide[c * 3 + 2] * b;
+            v = std::min(1.f, std::max(0.f, v)) * 1023.f;
+            const int i0 = std::min(static_cast<int>(v), 1022);
+            const float t = v - static_cast<float>(i0);
+            p[c] = shaperBody[i0 * 3 + c] * (1.f - t) + shaperBody[i0 * 3 + 3 + c] * t;
+        }
+        Interpolator::tetrahedral_interpolation (lookView, p, p);
+    }
+
+    int errors = 0;
+    for (size_t i = 0; i < separate.size(); i++)
+        if (std::abs(separate[i] - fused[i]) > tolerance)
+            errors++;
+    EXPECT_EQ(errors, 0);
+}
+
+
+TEST (TransformChain, Lut3D_Domain_Clamps_Output)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 17u, mix), LutErrorCode::LutState::OK);
+    const LutElement::lutTableRaw<float> domainMin { 0.f, 0.f, 0.f }, domainMax { 0.5f, 0.5f, 0.5f };
+
+    Lut::CTransformChain<float> chain;
+    ASSERT_EQ(chain.AddLut3D (lut.get_data(), lut.getLutSize(), domainMin, domainMax), LutErrorCode::LutState::OK);
+
+    // same result as 3D kernels: input clipped to [0...1], output clamped to domain
+    const auto view = Interpolator::make_lattice_view (lut.get_data(), lut.getLutSize(), domainMin, domainMax);
+    for (const auto& in : { std::array<float, 3>{{ 0.2f, 0.4f, 0.1f }}, std::array<float, 3>{{ 0.9f, 0.8f, 1.f }}, std::array<float, 3>{{ 2.f, -1.f, 1.5f }} })
+    {
+        std::array<float, 3> ref;
+        Interpolator::tetrahedral_interpolation (view, in.data(), ref.data());
+        const auto out = chain.Apply (in[0], in[1], in[2]);
+        for (int c = 0; c < 3; c++)
+        {
+            EXPECT_EQ(out[c], ref[c]);
+            EXPECT_LE(out[c], 0.5f);
+        }
+    }
+    const auto high = chain.Apply (2.f, 2.f, 2.f);
+    EXPECT_EQ(high[0], 0.5f);
+}
+
+
+TEST (TransformChain, Invalid_Stages)
+{
+    Lut::CTransformChain<double> chain;
+    EXPECT_EQ(chain.AddRange (1.0, 1.0, 0.0, 1.0), LutErrorCode::LutState::DomainBoundReversed);
+    EXPECT_EQ(chain.AddLut3D (LutElement::lutTable3D<double>(3u), 1u), LutErrorCode::LutState::LutSizeInvalid);
+    EXPECT_EQ(chain.AddLut1D (LutElement::lutTable3D<double>(6u), 2u, { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 1.0 }), LutErrorCode::LutState::DomainBoundReversed);
+    EXPECT_TRUE(chain.empty());
+
+    // empty chain passes data unchanged
+    const auto out = chain.Apply (0.25, 0.5, 2.0);
+    EXPECT_EQ(out[0], 0.25);
+    EXPECT_EQ(out[1], 0.5);
+    EXPECT_EQ(out[2], 2.0);
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include "lutBaker.h"
+#include "lutInterpolator.hpp"
+#include <array>
+#include <vector>
+#include <random>
+
+using Interpolator::YCbCrFrame;
+using Interpolator::YCbCrMatrix;
+using Interpolator::YCbCrSubsampling;
+
+std::array<float, 3> look (float r, float g, float b)
+{
+    return { std::sqrt(0.7f * r + 0.3f * b), 0.8f * g * g + 0.1f * r, 0.5f + 0.45f * std::sin(3.f * b) };
+}
+
+std::array<float, 3> identity (float r, float g, float b) { return { r, g, b }; }
+
+
+// P010/P210 style frame storage
+struct Frame
+{
+    Frame (size_t w, size_t h, YCbCrSubsampling s) : luma (w * h), chroma (w * (YCbCrSubsampling::S420 == s ? h / 2u : h))
+    {
+        desc.luma = luma.data();
+        desc.chroma = chroma.data();
+        desc.width = w;
+        desc.height = h;
+        desc.subsampling = s;
+    }
+    std::vector<uint16_t> luma, chroma;
+    YCbCrFrame desc;
+};
+
+// random colors inside of RGB gamut, one color per chroma site (chroma averaging lossless)
+void fill_frame (Frame& f, const YCbCrMatrix matrix)
+{
+    const Interpolator::YCbCrCoefficients<double> k (matrix, false);
+    std::mt19937 gen(99u);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    const size_t siteRows = (YCbCrSubsampling::S420 == f.desc.subsampling ? 2u : 1u);
+    for (size_t cy = 0; cy < f.desc.chroma_height(); cy++)
+        for (size_t x = 0; x < f.desc.width; x += 2u)
+        {
+            const double r = dist(gen), g = dist(gen), b = dist(gen);
+            const double y = k.kr * r + k.kg * g + k.kb * b;
+            const uint16_t yq = static_cast<uint16_t>(y * 876.0 + 64.5) << 6;
+            for (size_t dy = 0; dy < siteRows; dy++)
+                f.luma[(cy * siteRows + dy) * f.desc.width + x] = f.luma[(cy * siteRows + dy) * f.desc.width + x + 1u] = yq;
+            f.chroma[cy * f.desc.width + x]      = static_cast<uint16_t>((b - y) / k.cbToB * 896.0 + 512.5) << 6;
+            f.chroma[cy * f.desc.width + x + 1u] = static_cast<uint16_t>((r - y) / k.crToR * 896.0 + 512.5) << 6;
+        }
+}
+
+int max_code_difference (const std::vector<uint16_t>& a, const std::vector<uint16_t>& b)
+{
+    int maxDiff = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        maxDiff = std::max(maxDiff, std::abs(static_cast<int>(a[i] >> 6) - static_cast<int>(b[i] >> 6)));
+    return maxDiff;
+}
+
+
+TEST (YCbCrApply, Identity_Lut_Preserves_Frame)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, identity), LutErrorCode::LutState::OK);
+
+    for (const auto s : { YCbCrSubsampling::S420, YCbCrSubsampling::S422 })
+        for (const auto m : { YCbCrMatrix::Rec709, YCbCrMatrix::Rec2020 })
+        {
+            Frame src (64u, 32u, s), dst (64u, 32u, s);
+            fill_frame (src, m);
+            ASSERT_EQ(Interpolator::ycbcr_interpolation (lut, src.desc, dst.desc, m), LutErrorCode::LutState::OK);
+            EXPECT_LE(max_code_difference (src.luma, dst.luma), 1);
+            EXPECT_LE(max_code_difference (src.chroma, dst.chroma), 1);
+        }
+}
+
+
+TEST (YCbCrApply, Equal_To_Separate_Passes_420)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 33u, look), LutErrorCode::LutState::OK);
+    const auto view = Interpolator::make_lattice_view (lut);
+
+    constexpr size_t w = 128u, h = 64u;
+    Frame frame (w, h, YCbCrSubsampling::S420);
+    fill_frame (frame, YCbCrMatrix::Rec2020);
+    Frame ref (frame);
+    ref.desc.luma = ref.luma.data();
+    ref.desc.chroma = ref.chroma.data();
+
+    // reference: YCbCr -> RGB frame -> LUT -> YCbCr
+    const Interpolator::YCbCrCoefficients<float> k (YCbCrMatrix::Rec2020, false);
+    std::vector<float> rgb (w * h * 3u);
+    for (size_t y = 0; y < h; y++)
+        for (size_t x = 0; x < w; x++)
+        {
+            const float luma = (static_cast<float>(frame.luma[y * w + x] >> 6) - 64.f) / 876.f;
+            const float cb = (static_cast<float>(frame.chroma[(y / 2u) * w + (x & ~size_t(1))] >> 6) - 512.f) / 896.f;
+            const float cr = (static_cast<float>(frame.chroma[(y / 2u) * w + (x & ~size_t(1)) + 1u] >> 6) - 512.f) / 896.f;
+            float* p = &rgb[(y * w + x) * 3u];
+            p[0] = luma + k.crToR * cr;
+            p[1] = luma - k.cbToG * cb - k.crToG * cr;
+            p[2] = luma + k.cbToB * cb;
+        }
+    Interpolator::tetrahedral_interpolation (view, rgb.data(), rgb.data(), w * h);
+    for (size_t cy = 0; cy < h / 2u; cy++)
+        for (size_t x = 0; x < w; x += 2u)
+        {
+            float sumB = 0.f, sumR = 0.f;
+            for (size_t dy = 0; dy < 2u; dy++)
+                for (size_t dx = 0; dx < 2u; dx++)
+                {
+                    const float* p = &rgb[((cy * 2u + dy) * w + x + dx) * 3u];
+                    const float luma = k.kr * p[0] + k.kg * p[1] + k.kb * p[2];
+                    ref.luma[(cy * 2u + dy) * w + x + dx] = static_cast<uint16_t>(luma * 876.f + 64.5f) << 6;
+                    sumB += p[2] - luma;
+                    sumR += p[0] - luma;
+                }
+            ref.chroma[cy * w + x]      = static_cast<uint16_t>(sumB * 0.25f / k.cbToB * 896.f + 512.5f) << 6;
+            ref.chroma[cy * w + x + 1u] = static_cast<uint16_t>(sumR * 0.25f / k.crToR * 896.f + 512.5f) << 6;
+        }
+
+    // in-place fused kernel
+    ASSERT_EQ(Interpolator::ycbcr_interpolation (lut, frame.desc, frame.desc, YCbCrMatrix::Rec2020), LutErrorCode::LutState::OK);
+    EXPECT_LE(max_code_difference (frame.luma, ref.luma), 1);
+    EXPECT_LE(max_code_difference (frame.chroma, ref.chroma), 1);
+}
+
+
+TEST (YCbCrApply, Invalid_Frame)
+{
+    CCubeLut3D<float> lut;
+    ASSERT_EQ(LutBaker::Bake (lut, 17u, identity), LutErrorCode::LutState::OK);
+    Frame odd (63u, 32u, YCbCrSubsampling::S420), good (64u, 32u, YCbCrSubsampling::S420), s422 (64u, 32u, YCbCrSubsampling::S422);
+    EXPECT_EQ(Interpolator::ycbcr_interpolation (lut, odd.desc, odd.desc, YCbCrMatrix::Rec709), LutErrorCode::LutState::IncorrectDimension);
+    EXPECT_EQ(Interpolator::ycbcr_interpolation (lut, good.desc, s422.desc, YCbCrMatrix::Rec709), LutErrorCode::LutState::IncorrectDimension);
+    good.desc.chroma = nullptr;
+    EXPECT_EQ(Interpolator::ycbcr_interpolation (lut, good.desc, s422.desc, YCbCrMatrix::Rec709), LutErrorCode::LutState::NotInitialized);
+}
+
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -15,7 +15,8 @@ namespace HuffmanUtils
         public:
             virtual ~CHuffmanBlock();
 
-            CHuffmanBlock (std::vector<uint8_t>& iData /* input */, std::vector<uint8_t>& oData /* output */, CStreamPointer& sp);
+            CHuffmanBlock (std::vector<uint8_t>& iData /* input */, std::vector<uint8_t>& oData /* output */, CStreamPointer& sp,
+                           const size_t outLimit = ~static_cast<size_t>(0) /* maximal size of output */);
             CStreamPointer Decode (void);
             CStreamPointer GetStreamPointer(void) noexcept { return m_Sp; }
             
@@ -5,13 +5,17 @@
 #include <array>
 #include <utility>
 #include <memory>
+#include <functional>
 #include "CHuffmanStreamPointer.h"
 #include "CHuffmanTree.h"
+#include "IBlockDecoder.h"
 
 namespace HuffmanUtils
 {
     using InStreamT  = std::vector<uint8_t>;
     using OutStreamT = std::vector<uint8_t>;
+    // called after each decoded block with current size of decoded data; returns false for stop decoding
+    using BlockCallbackT = std::function<bool(size_t)>;
 
     class CHuffmanStream
     {
@@ -28,6 +32,11 @@ namespace HuffmanUtils
             OutStreamT Decode (void);
             OutStreamT Encode (void);
             bool StreamIntegrityStatus(void) const noexcept { return m_Integrity; }
+
+            // decoding fails (COutputLimitError thrown) if decoded data grows above this size
+            void SetOutputLimit (const size_t outLimit) noexcept { m_OutLimit = outLimit; }
+            // decoding stopped (stream integrity status false) if callback returns false
+            void SetBlockCallback (BlockCallbackT callback) { m_BlockCallback = std::move(callback); }
             const CStreamPointer get_sp (void) const noexcept {return m_Sp;}
 
         private:
@@ -46,6 +55,9 @@ namespace HuffmanUtils
 
             CStreamPointer m_Sp = 0ll;
             InStreamT m_StreamData;
+
+            size_t m_OutLimit = ~static_cast<size_t>(0);
+            BlockCallbackT m_BlockCallback;
             
 
     }; // class CHuffmanStream
@@ -5,17 +5,31 @@
 #include <utility>
 #include <type_traits>
 #include <vector>
+#include <stdexcept>
 #include "CHuffmanStreamPointer.h"
 
 
 namespace HuffmanUtils
 {
+    // thrown by block decoder if decoded stream grows above output limit
+    class COutputLimitError : public std::length_error
+    {
+       public:
+           using std::length_error::length_error;
+    }; // class COutputLimitError
+
     class IBlockDecoder
     {
        public:
            virtual bool decode (const std::vector<uint8_t>& in, std::vector<uint8_t>& out, CStreamPointer& inSp) = 0;
            virtual uint8_t get_decoder_type(void) = 0;
 
+           // maximal size of output stream (protection from streams decoded to huge size)
+           void set_output_limit (const size_t outLimit) noexcept { m_outLimit = outLimit; }
+
+       protected:
+           size_t m_outLimit = ~static_cast<size_t>(0);
+
     }; // class IBlockDecoder
 	
 } // namespace HuffmanUtils
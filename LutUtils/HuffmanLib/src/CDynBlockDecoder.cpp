@@ -257,7 +257,11 @@ bool CDynBlockDecoder::decode (const std::vector<uint8_t>& in, std::vector<uint8
            symbol = hLiteraLeaf->symbol;
 
            if (symbol <= 255u)
+           {
+               if (out.size() >= m_outLimit)
+                   throw COutputLimitError("DYN: Decoded data exceeds output limit of " + std::to_string(m_outLimit) + " bytes.");
                out.push_back(static_cast<uint8_t>(symbol));
+           }
            else if (symbol >= static_cast<uint32_t>(cLengthCodesMin) && symbol <= static_cast<uint32_t>(cLengthCodesMax))
            {
                const std::pair<int32_t, int32_t> pair_distance = process_distance_sequence(in, sp, symbol);
@@ -283,6 +287,9 @@ bool CDynBlockDecoder::decode (const std::vector<uint8_t>& in, std::vector<uint8
 
                auto const pre = outVectorSize - distance;
 
+               if (out.size() + static_cast<size_t>(size) > m_outLimit)
+                   throw COutputLimitError("DYN: Decoded data exceeds output limit of " + std::to_string(m_outLimit) + " bytes.");
+
                // Preallocate space for the output vector
                out.reserve(out.size() + size);
 
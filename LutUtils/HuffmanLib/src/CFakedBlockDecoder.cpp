@@ -36,6 +36,9 @@ bool CFakedBlockDecoder::decode (const std::vector<uint8_t>& in, std::vector<uin
     const size_t actualLen = static_cast<size_t>(m_LEN);
     if (0ull != actualLen)
     {
+        if (out.size() + actualLen > m_outLimit)
+            throw COutputLimitError("RAW: Decoded data exceeds output limit of " + std::to_string(m_outLimit) + " bytes.");
+
         // reserve memory for output vector
         out.reserve (out.size() + actualLen);
 
@@ -68,9 +68,10 @@ bool CHuffmanBlock::parse_block_header (CStreamPointer& sp) noexcept
 }
 
 
-CHuffmanBlock::CHuffmanBlock (std::vector<uint8_t>& pData, std::vector<uint8_t>& dData, CStreamPointer& sp) : m_InData(pData), m_OutData(dData)
+CHuffmanBlock::CHuffmanBlock (std::vector<uint8_t>& pData, std::vector<uint8_t>& dData, CStreamPointer& sp, const size_t outLimit) : m_InData(pData), m_OutData(dData)
 {
-    parse_block_header(sp);
+    if (true == parse_block_header(sp))
+        m_iBlockDecoder->set_output_limit(outLimit);
     return;
 }
 
@@ -103,7 +103,7 @@ OutStreamT CHuffmanStream::Decode (void)
     do {
         m_blockCnt++;
 
-        CHuffmanBlock hBlock (m_StreamData, decodedData, m_Sp);
+        CHuffmanBlock hBlock (m_StreamData, decodedData, m_Sp, m_OutLimit);
         finalBlock = hBlock.isFinal();
         m_Sp = hBlock.Decode();
 
@@ -119,6 +119,12 @@ OutStreamT CHuffmanStream::Decode (void)
             errDecode = (false == finalBlock ? true : false);
         }
 
+        if (m_BlockCallback && false == m_BlockCallback(decodedSizeCurr))
+        {
+            m_Integrity = false;
+            return decodedData;
+        }
+
     } while (false == finalBlock && false == errDecode);
 
     auto convertEndian = [&](const uint32_t value) -> uint32_t
@@ -102,7 +102,11 @@ bool CStatBlockDecoder::decode (const std::vector<uint8_t>& in, std::vector<uint
             symbol = read_fixed_huffman_code(in, sp);
 
             if (symbol <= 255u)
+            {
+                if (out.size() >= m_outLimit)
+                    throw COutputLimitError("FIX: Decoded data exceeds output limit of " + std::to_string(m_outLimit) + " bytes.");
                 out.push_back(static_cast<uint8_t>(symbol)); // put literal code 
+            }
             else if (symbol >= static_cast<uint32_t>(cLengthCodesMin) && symbol <= static_cast<uint32_t>(cLengthCodesMax)) // process distance/length codes
             {
                 const std::pair<int32_t, int32_t> pair_distance = process_distance_sequence(in, sp, symbol);
@@ -133,6 +137,9 @@ bool CStatBlockDecoder::decode (const std::vector<uint8_t>& in, std::vector<uint
 
                 auto const pre = outVectorSize - distance;
 
+                if (out.size() + static_cast<size_t>(size) > m_outLimit)
+                    throw COutputLimitError("FIX: Decoded data exceeds output limit of " + std::to_string(m_outLimit) + " bytes.");
+
                 // Preallocate space for the output vector
                 out.reserve(out.size() + size);
 
@@ -0,0 +1,198 @@
+#ifndef __LUT_LIBRARY_FAST_FLOAT_UTILS__
+#define __LUT_LIBRARY_FAST_FLOAT_UTILS__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <locale.h>
+#if defined(__APPLE__)
+ #include <xlocale.h>
+#endif
+
+// Locale independent decimal to binary floating point conversion without allocation.
+// Decimal token split into 64-bit significand and power of ten; when both fit exactly into target type
+// (Clinger fast path) result obtained by single correctly rounded multiplication or division. Remaining
+// inputs (more than 19 significant digits, large exponents, inf/nan, hex floats) converted by C runtime
+// in "C" locale, so result always correctly rounded and independent from process locale.
+namespace LutFastFloat
+{
+
+    namespace detail
+    {
+        // exact powers of ten representable in binary64
+        inline double exact_pow10 (const uint32_t e) noexcept
+        {
+            static const double table[] = {
+                1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+            return table[e];
+        }
+
+        // fast path limits: significand and power of ten exactly representable in T
+        template <typename T> struct fast_path_traits;
+        template <> struct fast_path_traits<float>       { static constexpr uint64_t maxMantissa = 1ull << 24; static constexpr int32_t maxExponent = 10; };
+        template <> struct fast_path_traits<double>      { static constexpr uint64_t maxMantissa = 1ull << 53; static constexpr int32_t maxExponent = 22; };
+        template <> struct fast_path_traits<long double> { static constexpr uint64_t maxMantissa = 1ull << 53; static constexpr int32_t maxExponent = 22; };
+
+        struct decimal_number
+        {
+            uint64_t mantissa = 0u;
+            int32_t  exponent = 0;
+            bool     negative = false;
+            bool     exact    = true;     // false if significand truncated (more than 19 digits)
+        };
+
+        inline bool is_digit (const char c) noexcept { return static_cast<unsigned char>(c - '0') < 10u; }
+
+        // [+-]digits[.digits][(e|E)[+-]digits], at least one digit in significand, complete range consumed
+        inline bool scan_decimal (const char* p, const char* const end, decimal_number& num) noexcept
+        {
+            if (p != end && ('-' == *p || '+' == *p))
+                num.negative = ('-' == *p++);
+
+            const char* const start = p;
+            uint64_t m = 0u;
+            int32_t digits = 0;         // significant digits accumulated in 'm'
+            int32_t dropped = 0;        // integer digits not fit into 'm'
+            while (p != end && '0' == *p)
+                p++;
+            for (; p != end && is_digit (*p); p++)
+            {
+                if (digits < 19)
+                {
+                    m = m * 10u + static_cast<uint64_t>(*p - '0');
+                    digits++;
+                }
+                else
+                {
+                    dropped++;
+                    num.exact = num.exact && ('0' == *p);
+                }
+            }
+            int32_t exp10 = dropped;
+            bool anyDigit = (p != start);
+
+            if (p != end && '.' == *p)
+            {
+                p++;
+                const char* const fraction = p;
+                if (0 == digits)
+                {
+                    // leading zeros of pure fraction: 0.000123
+                    while (p != end && '0' == *p)
+                        p++;
+                    exp10 -= static_cast<int32_t>(p - fraction);
+                }
+                for (; p != end && is_digit (*p); p++)
+                {
+                    if (digits < 19)
+                    {
+                        m = m * 10u + static_cast<uint64_t>(*p - '0');
+                        digits++;
+                        exp10--;
+                    }
+                    else
+                        num.exact = num.exact && ('0' == *p);
+                }
+                anyDigit = anyDigit || (p != fraction);
+            }
+            if (false == anyDigit)
+                return false;
+
+            if (p != end && ('e' == *p || 'E' == *p))
+            {
+                p++;
+                bool negExp = false;
+                if (p != end && ('-' == *p || '+' == *p))
+                    negExp = ('-' == *p++);
+                if (p == end || !is_digit (*p))
+                    return false;
+                int32_t e = 0;
+                for (; p != end && is_digit (*p); p++)
+                {
+                    if (e < 100000)
+                        e = e * 10 + (*p - '0');
+                }
+                exp10 += (negExp ? -e : e);
+            }
+
+            num.mantissa = m;
+            num.exponent = exp10;
+            return (p == end);
+        }
+
+        template <typename T>
+        inline bool fast_path (const decimal_number& num, T& value) noexcept
+        {
+            using Traits = fast_path_traits<T>;
+            if (false == num.exact || num.mantissa > Traits::maxMantissa ||
+                num.exponent < -Traits::maxExponent || num.exponent > Traits::maxExponent)
+                return false;
+
+            // both operands exact: single IEEE operation gives correctly rounded result
+            T v = static_cast<T>(num.mantissa);
+            if (num.exponent < 0)
+                v = v / static_cast<T>(exact_pow10 (static_cast<uint32_t>(-num.exponent)));
+            else if (num.exponent > 0)
+                v = v * static_cast<T>(exact_pow10 (static_cast<uint32_t>(num.exponent)));
+            if (true == num.negative)
+                v = -v;
+            value = v;
+            return true;
+        }
+
+#if defined(_WIN32)
+        inline _locale_t c_locale (void) noexcept { static const _locale_t loc = _create_locale (LC_ALL, "C"); return loc; }
+        inline void strto_c (const char* s, char** end, float& v)       noexcept { v = _strtof_l (s, end, c_locale()); }
+        inline void strto_c (const char* s, char** end, double& v)      noexcept { v = _strtod_l (s, end, c_locale()); }
+        inline void strto_c (const char* s, char** end, long double& v) noexcept { v = _strtold_l (s, end, c_locale()); }
+#else
+        inline locale_t c_locale (void) noexcept { static const locale_t loc = ::newlocale (LC_ALL_MASK, "C", static_cast<locale_t>(0)); return loc; }
+        inline void strto_c (const char* s, char** end, float& v)       noexcept { v = (0 != c_locale() ? ::strtof_l (s, end, c_locale())  : std::strtof (s, end)); }
+        inline void strto_c (const char* s, char** end, double& v)      noexcept { v = (0 != c_locale() ? ::strtod_l (s, end, c_locale())  : std::strtod (s, end)); }
+        inline void strto_c (const char* s, char** end, long double& v) noexcept { v = (0 != c_locale() ? ::strtold_l (s, end, c_locale()) : std::strtold (s, end)); }
+#endif
+
+        // correctly rounded conversion by C runtime; token copied for null termination
+        template <typename T>
+        inline bool slow_path (const char* first, const std::size_t size, T& value) noexcept
+        {
+            constexpr std::size_t maxTokenSize = 127u;
+            if (0u == size || size > maxTokenSize)
+                return false;
+            char buffer[maxTokenSize + 1u];
+            std::memcpy (buffer, first, size);
+            buffer[size] = '\0';
+            char* end = nullptr;
+            T v{};
+            strto_c (buffer, &end, v);
+            if (end != buffer + size)
+                return false;
+            value = v;
+            return true;
+        }
+
+    } // namespace detail
+
+
+    // Parse complete character range [first, first + size) as floating point number.
+    // Returns false (value untouched) if range is not a valid number.
+    template <typename T, typename std::enable_if<std::is_floating_point<T>::value>::type* = nullptr>
+    inline bool from_chars (const char* first, const std::size_t size, T& value) noexcept
+    {
+        if (nullptr == first || 0u == size)
+            return false;
+
+        detail::decimal_number num;
+        if (true == detail::scan_decimal (first, first + size, num) && true == detail::fast_path (num, value))
+            return true;
+        return detail::slow_path (first, size, value);
+    }
+
+} // namespace LutFastFloat
+
+#endif // __LUT_LIBRARY_FAST_FLOAT_UTILS__
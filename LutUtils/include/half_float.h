@@ -0,0 +1,82 @@
+#ifndef __LUT_LIBRARY_HALF_FLOAT_UTILS__
+#define __LUT_LIBRARY_HALF_FLOAT_UTILS__
+
+#include <cstdint>
+#include <cstring>
+
+// IEEE 754 binary16 <-> binary32 conversion (bit manipulation, independent of floating point mode flags)
+namespace HalfFloat
+{
+	inline float to_float (const uint16_t h) noexcept
+	{
+		const uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+		const uint32_t exp  = (h >> 10) & 0x1Fu;
+		uint32_t mant = h & 0x03FFu;
+		uint32_t bits;
+
+		if (0u == exp)
+		{
+			if (0u == mant)
+				bits = sign; // signed zero
+			else
+			{
+				// denormal: normalize mantissa
+				uint32_t e = 113u; // 127 - 15 + 1
+				while (0u == (mant & 0x0400u))
+				{
+					mant <<= 1;
+					e--;
+				}
+				bits = sign | (e << 23) | ((mant & 0x03FFu) << 13);
+			}
+		}
+		else if (0x1Fu == exp)
+			bits = sign | 0x7F800000u | (mant << 13); // Inf / NaN
+		else
+			bits = sign | ((exp + 112u) << 23) | (mant << 13);
+
+		float f;
+		std::memcpy (&f, &bits, sizeof(f));
+		return f;
+	}
+
+
+	// round to nearest even; overflow saturates to infinity
+	inline uint16_t from_float (const float f) noexcept
+	{
+		uint32_t bits;
+		std::memcpy (&bits, &f, sizeof(bits));
+
+		const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+		const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+		if (absBits >= 0x7F800000u) // Inf / NaN
+			return static_cast<uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x0200u : 0u));
+		if (absBits >= 0x477FF000u) // rounds to value above max half (65504)
+			return static_cast<uint16_t>(sign | 0x7C00u);
+		if (absBits < 0x33000001u)  // below half of min denormal
+			return sign;
+
+		const int32_t exp = static_cast<int32_t>(absBits >> 23) - 127;
+		uint32_t mant = (absBits & 0x007FFFFFu) | 0x00800000u;
+
+		if (exp < -14)
+		{
+			// denormal half
+			const uint32_t shift = static_cast<uint32_t>(-exp - 14 + 13);
+			const uint32_t halfMant = mant >> shift;
+			const uint32_t rem  = mant & ((1u << shift) - 1u);
+			const uint32_t half = 1u << (shift - 1u);
+			const uint32_t rounded = halfMant + ((rem > half || (rem == half && (halfMant & 1u))) ? 1u : 0u);
+			return static_cast<uint16_t>(sign | rounded);
+		}
+
+		uint32_t hbits = (static_cast<uint32_t>(exp + 15) << 10) | ((mant >> 13) & 0x03FFu);
+		const uint32_t rem = mant & 0x1FFFu;
+		if (rem > 0x1000u || (rem == 0x1000u && (hbits & 1u)))
+			hbits++; // carry into exponent handled naturally
+		return static_cast<uint16_t>(sign | hbits);
+	}
+}
+
+#endif /* __LUT_LIBRARY_HALF_FLOAT_UTILS__ */
@@ -0,0 +1,53 @@
+#ifndef __LUT_LIBRARY_HUGE_PAGES_UTILS__
+#define __LUT_LIBRARY_HUGE_PAGES_UTILS__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__linux__)
+ #include <sys/mman.h>
+#endif
+
+namespace LutMemory
+{
+
+    // buffers not smaller than this backed by huge pages when OS supports it (2 MB pages on x86-64/ARM64)
+    constexpr std::size_t hugePageSize      = 2u * 1024u * 1024u;
+    constexpr std::size_t hugePageThreshold = 16u * hugePageSize;
+
+    // Ask OS to back memory range with transparent huge pages. Only whole huge pages inside of range are
+    // advised; must be called before memory touched first time. Returns false if advice not applied
+    // (small range, unsupported OS or THP disabled) - memory stays usable with regular pages.
+    inline bool advise_huge_pages (void* ptr, const std::size_t bytes) noexcept
+    {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (nullptr == ptr || bytes < hugePageThreshold)
+            return false;
+        const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(ptr) + hugePageSize - 1u) & ~(static_cast<std::uintptr_t>(hugePageSize) - 1u);
+        const std::uintptr_t end   = (reinterpret_cast<std::uintptr_t>(ptr) + bytes) & ~(static_cast<std::uintptr_t>(hugePageSize) - 1u);
+        if (end <= begin)
+            return false;
+        return (0 == ::madvise (reinterpret_cast<void*>(begin), static_cast<std::size_t>(end - begin), MADV_HUGEPAGE));
+#else
+        (void)ptr; (void)bytes;
+        return false;
+#endif
+    }
+
+    // Reserve vector storage for 'elements' values; large storage (allocated by C runtime with mmap) advised
+    // for huge pages before first touch. Vector size not changed. Returns true if huge pages advised.
+    template <typename T, typename Alloc>
+    inline bool reserve_huge (std::vector<T, Alloc>& buffer, const std::size_t elements)
+    {
+        if (buffer.capacity() >= elements)
+            return false;
+        if (0u == buffer.size())
+            std::vector<T, Alloc>().swap (buffer);    // release old storage first: no copy, lower peak memory
+        buffer.reserve (elements);
+        return advise_huge_pages (buffer.data() + buffer.size(), (elements - buffer.size()) * sizeof(T));
+    }
+
+} // namespace LutMemory
+
+#endif // __LUT_LIBRARY_HUGE_PAGES_UTILS__
@@ -0,0 +1,108 @@
+#ifndef __LUT_LIBRARY_IO_POOL_UTILS__
+#define __LUT_LIBRARY_IO_POOL_UTILS__
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "parallel_for.h"
+
+namespace LutParallel
+{
+
+    // number of threads of library I/O pool: few loads in flight, every load parallelizes parsing itself
+    constexpr uint32_t ioPoolMaxThreads = 4u;
+
+    // Fixed size pool of threads executing posted tasks in FIFO order. Destructor waits for running tasks;
+    // tasks not started till then are dropped: their 'dropped' callbacks invoked on destroying thread.
+    class CIoPool
+    {
+    public:
+        explicit CIoPool (const uint32_t threads)
+        {
+            const uint32_t workers = std::max(1u, threads);
+            m_workers.reserve (workers);
+            for (uint32_t i = 0u; i < workers; i++)
+                m_workers.emplace_back ([this]() { worker(); });
+        }
+
+        CIoPool (const CIoPool&) = delete;
+        CIoPool& operator = (const CIoPool&) = delete;
+
+        ~CIoPool()
+        {
+            std::deque<Task> dropped;
+            {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                m_bStop = true;
+                dropped.swap (m_tasks);
+            }
+            m_cv.notify_all();
+            for (auto& t : dropped)
+                if (t.dropped)
+                    t.dropped();
+            for (auto& w : m_workers)
+                w.join();
+        }
+
+        // 'dropped' invoked instead of 'task' if pool destroyed before task started
+        void post (std::function<void()> task, std::function<void()> dropped = nullptr)
+        {
+            {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                m_tasks.push_back (Task { std::move (task), std::move (dropped) });
+            }
+            m_cv.notify_one();
+            return;
+        }
+
+        uint32_t size (void) const noexcept { return static_cast<uint32_t>(m_workers.size()); }
+
+    private:
+        struct Task
+        {
+            std::function<void()> run;
+            std::function<void()> dropped;
+        };
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::deque<Task> m_tasks;
+        std::vector<std::thread> m_workers;
+        bool m_bStop = false;
+
+        void worker (void)
+        {
+            for (;;)
+            {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock (m_mutex);
+                    m_cv.wait (lock, [this]() { return (true == m_bStop || false == m_tasks.empty()); });
+                    if (true == m_bStop)
+                        return;
+                    task = std::move (m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task.run();
+            }
+        }
+    };
+
+
+    // library owned I/O pool, created on first use
+    inline CIoPool& io_pool (void)
+    {
+        static CIoPool pool (std::max(2u, std::min(ioPoolMaxThreads, threads_number())));
+        return pool;
+    }
+
+} // namespace LutParallel
+
+#endif // __LUT_LIBRARY_IO_POOL_UTILS__
@@ -0,0 +1,130 @@
+#ifndef __LUT_LIBRARY_LOAD_BUDGET_UTILS__
+#define __LUT_LIBRARY_LOAD_BUDGET_UTILS__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace LutLimits
+{
+
+    // Per load resource limits for untrusted LUT files; zero value means no limit.
+    struct LoadLimits
+    {
+        std::size_t maxInputBytes    = 0u;              // size of file (buffer) to parse
+        std::size_t maxDecodedBytes  = 0u;              // size of decoded data: LUT body, inflated image data
+        std::size_t maxLatticePoints = 0u;              // number of LUT lattice nodes
+        std::chrono::milliseconds timeout { 0 };        // wall clock time of one load
+    };
+
+    // hot loops poll deadline once per this number of iterations (lines, rows, chunks)
+    constexpr std::size_t budgetCheckStep = 4096u;
+
+    // progress of current load phase: (done, total) - bytes of text parsed or bytes of image data inflated
+    using ProgressCallback = std::function<void(std::size_t, std::size_t)>;
+
+    // Limits of one load: sizes checked against limits, deadline counted from construction. Deadline and cancel
+    // flag polled concurrently by parse workers; once expired stays expired. Progress callback never invoked
+    // concurrently, but may be invoked from any worker thread.
+    class CLoadBudget
+    {
+    public:
+        CLoadBudget (void) noexcept = default;
+        explicit CLoadBudget (const LoadLimits& limits, const std::atomic<bool>* cancel = nullptr, ProgressCallback progress = nullptr)
+            : m_limits (limits),
+              m_deadline (std::chrono::steady_clock::now() + limits.timeout),
+              m_bDeadline (limits.timeout.count() > 0),
+              m_cancel (cancel),
+              m_progress (std::move (progress)) {}
+
+        CLoadBudget (const CLoadBudget&) = delete;
+        CLoadBudget& operator = (const CLoadBudget&) = delete;
+
+        const LoadLimits& limits (void) const noexcept { return m_limits; }
+
+        bool input_allowed   (const std::size_t bytes)  const noexcept { return allowed (bytes,  m_limits.maxInputBytes); }
+        bool decoded_allowed (const std::size_t bytes)  const noexcept { return allowed (bytes,  m_limits.maxDecodedBytes); }
+        bool lattice_allowed (const std::size_t points) const noexcept { return allowed (points, m_limits.maxLatticePoints); }
+
+        // largest number of lattice points allowed by lattice and decoded size limits
+        std::size_t max_lattice_points (const std::size_t bytesPerPoint) const noexcept
+        {
+            std::size_t points = (0u != m_limits.maxLatticePoints ? m_limits.maxLatticePoints : ~std::size_t(0));
+            if (0u != m_limits.maxDecodedBytes && 0u != bytesPerPoint)
+                points = (points < m_limits.maxDecodedBytes / bytesPerPoint ? points : m_limits.maxDecodedBytes / bytesPerPoint);
+            return points;
+        }
+
+        // true if deadline passed
+        bool expired (void) const noexcept
+        {
+            if (false == m_bDeadline)
+                return false;
+            if (true == m_bExpired.load (std::memory_order_relaxed))
+                return true;
+            if (std::chrono::steady_clock::now() < m_deadline)
+                return false;
+            m_bExpired.store (true, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool cancelled (void) const noexcept { return (nullptr != m_cancel && true == m_cancel->load (std::memory_order_relaxed)); }
+
+        // true if load should stop: cancelled or deadline passed
+        bool stopped (void) const noexcept { return (true == cancelled() || true == expired()); }
+
+        // begin new progress phase of 'total' bytes
+        void start_progress (const std::size_t total) const noexcept
+        {
+            m_total.store (total, std::memory_order_relaxed);
+            m_done.store (0u, std::memory_order_relaxed);
+            return;
+        }
+
+        // 'bytes' more processed (called by parse workers)
+        void advance (const std::size_t bytes) const
+        {
+            if (m_progress)
+                notify (m_done.fetch_add (bytes, std::memory_order_relaxed) + bytes);
+            return;
+        }
+
+        // 'done' bytes processed from begin of phase
+        void report (const std::size_t done) const
+        {
+            if (m_progress)
+            {
+                m_done.store (done, std::memory_order_relaxed);
+                notify (done);
+            }
+            return;
+        }
+
+    private:
+        LoadLimits m_limits;
+        std::chrono::steady_clock::time_point m_deadline;
+        bool m_bDeadline = false;
+        mutable std::atomic<bool> m_bExpired { false };
+
+        const std::atomic<bool>* m_cancel = nullptr;
+        ProgressCallback m_progress;
+        mutable std::atomic<std::size_t> m_done  { 0u };
+        mutable std::atomic<std::size_t> m_total { 0u };
+        mutable std::mutex m_progressMutex;
+
+        void notify (const std::size_t done) const
+        {
+            std::lock_guard<std::mutex> lock (m_progressMutex);
+            m_progress (done, m_total.load (std::memory_order_relaxed));
+            return;
+        }
+
+        static bool allowed (const std::size_t value, const std::size_t limit) noexcept { return (0u == limit || value <= limit); }
+    };
+
+} // namespace LutLimits
+
+#endif // __LUT_LIBRARY_LOAD_BUDGET_UTILS__
@@ -0,0 +1,149 @@
+#ifndef __LUT_LIBRARY_MAPPED_FILE_UTILS__
+#define __LUT_LIBRARY_MAPPED_FILE_UTILS__
+
+#include <cstddef>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#if defined(_WIN32)
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#else
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+#endif
+
+namespace LutText
+{
+
+    // Read-only view of complete file content: memory mapped when OS allows it,
+    // otherwise file content read into internal buffer. Empty file is valid and has size 0.
+    class CMappedFile
+    {
+    public:
+        CMappedFile (void) = default;
+        explicit CMappedFile (const std::string& fileName) { open (fileName); }
+        ~CMappedFile (void) { close(); }
+
+        CMappedFile (const CMappedFile&) = delete;
+        CMappedFile& operator = (const CMappedFile&) = delete;
+
+        bool open (const std::string& fileName)
+        {
+            close();
+#if defined(_WIN32)
+            HANDLE hFile = ::CreateFileA (fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (INVALID_HANDLE_VALUE != hFile)
+            {
+                LARGE_INTEGER fileSize {};
+                if (FALSE != ::GetFileSizeEx (hFile, &fileSize))
+                {
+                    m_size = static_cast<std::size_t>(fileSize.QuadPart);
+                    m_good = true;
+                    if (0u != m_size)
+                    {
+                        m_mapping = ::CreateFileMappingA (hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                        if (nullptr != m_mapping)
+                            m_data = static_cast<const char*>(::MapViewOfFile (m_mapping, FILE_MAP_READ, 0, 0, 0));
+                    }
+                }
+                ::CloseHandle (hFile);
+            }
+#else
+            const int fd = ::open (fileName.c_str(), O_RDONLY);
+            if (fd >= 0)
+            {
+                struct stat st {};
+                if (0 == ::fstat (fd, &st) && S_ISREG(st.st_mode))
+                {
+                    m_size = static_cast<std::size_t>(st.st_size);
+                    m_good = true;
+                    if (0u != m_size)
+                    {
+                        void* p = ::mmap (nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (MAP_FAILED != p)
+                        {
+                            ::madvise (p, m_size, MADV_SEQUENTIAL);
+                            m_data = static_cast<const char*>(p);
+                        }
+                    }
+                }
+                ::close (fd);
+            }
+#endif
+            // mapping not available - read file content
+            if (true == m_good && 0u != m_size && nullptr == m_data)
+            {
+                std::ifstream file (fileName, std::ios::in | std::ios::binary);
+                m_buffer.resize (m_size);
+                m_good = file.read (m_buffer.data(), static_cast<std::streamsize>(m_size)).good();
+                m_data = m_buffer.data();
+                m_mapped = false;
+                return m_good;
+            }
+            m_mapped = (nullptr != m_data);
+            return m_good;
+        }
+
+        void close (void) noexcept
+        {
+            if (true == m_mapped && nullptr != m_data)
+            {
+#if defined(_WIN32)
+                ::UnmapViewOfFile (m_data);
+#else
+                ::munmap (const_cast<char*>(m_data), m_size);
+#endif
+            }
+#if defined(_WIN32)
+            if (nullptr != m_mapping)
+                ::CloseHandle (m_mapping);
+            m_mapping = nullptr;
+#endif
+            m_buffer.clear();
+            m_data = nullptr;
+            m_size = 0u;
+            m_good = m_mapped = false;
+            return;
+        }
+
+        bool good (void) const noexcept { return m_good; }
+        bool mapped (void) const noexcept { return m_mapped; }
+        const char* data (void) const noexcept { return m_data; }
+        std::size_t size (void) const noexcept { return m_size; }
+
+        // drop whole pages of already processed range [0, bytes) from process working set (sequential readers of
+        // big files): content stays valid and read again from file on next access. No effect for buffered file.
+        void release (const std::size_t bytes) const noexcept
+        {
+#if !defined(_WIN32) && defined(MADV_DONTNEED)
+            const std::size_t page = static_cast<std::size_t>(::sysconf (_SC_PAGESIZE));
+            const std::size_t length = (std::min(bytes, m_size) / page) * page;
+            if (true == m_mapped && 0u != length)
+                ::madvise (const_cast<char*>(m_data), length, MADV_DONTNEED);
+#else
+            (void)bytes;
+#endif
+            return;
+        }
+
+    private:
+        const char* m_data = nullptr;
+        std::size_t m_size = 0u;
+        bool m_good = false;
+        bool m_mapped = false;
+        std::vector<char> m_buffer;
+#if defined(_WIN32)
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+
+} // namespace LutText
+
+#endif // __LUT_LIBRARY_MAPPED_FILE_UTILS__
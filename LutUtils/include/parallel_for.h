@@ -0,0 +1,95 @@
+#ifndef __LUT_LIBRARY_PARALLEL_FOR_UTILS__
+#define __LUT_LIBRARY_PARALLEL_FOR_UTILS__
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LutParallel
+{
+
+    // number of worker threads used when caller doesn't define it explicitly
+    inline uint32_t threads_number (void) noexcept
+    {
+        const uint32_t hwThreads = static_cast<uint32_t>(std::thread::hardware_concurrency());
+        return (0u == hwThreads ? 1u : hwThreads);
+    }
+
+
+    // Split range [begin, end) on contiguous chunks (not less than 'grain' elements each) and
+    // execute func (chunkBegin, chunkEnd, threadIdx) on separate threads. Chunks are assigned
+    // statically, so the same thread index always processes the same part of range.
+    // Calling thread processes the first chunk itself. If func throws on any thread, all started
+    // threads are joined first and then the first exception is rethrown to the caller.
+    template <typename F>
+    void parallel_for (const size_t begin, const size_t end, const size_t grain, F&& func, uint32_t threads = 0u)
+    {
+        if (end <= begin)
+            return;
+
+        const size_t total    = end - begin;
+        const size_t minChunk = std::max(grain, static_cast<size_t>(1));
+        const size_t maxJobs  = (total + minChunk - 1) / minChunk;
+
+        if (0u == threads)
+            threads = threads_number();
+
+        const size_t jobs = std::max(static_cast<size_t>(1), std::min(static_cast<size_t>(threads), maxJobs));
+        if (1u == jobs)
+        {
+            func (begin, end, 0u);
+            return;
+        }
+
+        const size_t chunk = total / jobs;
+        const size_t tail  = total % jobs;
+
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto keep_error = [&error, &errorMutex]()
+        {
+            std::lock_guard<std::mutex> lock (errorMutex);
+            if (nullptr == error)
+                error = std::current_exception();
+        };
+
+        std::vector<std::thread> workers;
+        try
+        {
+            workers.reserve(jobs - 1);
+
+            size_t chunkBegin = begin + chunk + (0u < tail ? 1u : 0u);
+            for (size_t j = 1; j < jobs; j++)
+            {
+                const size_t chunkEnd = chunkBegin + chunk + (j < tail ? 1u : 0u);
+                workers.emplace_back([&func, &keep_error, chunkBegin, chunkEnd, j]()
+                {
+                    try { func (chunkBegin, chunkEnd, static_cast<uint32_t>(j)); }
+                    catch (...) { keep_error(); }
+                });
+                chunkBegin = chunkEnd;
+            }
+
+            func (begin, begin + chunk + (0u < tail ? 1u : 0u), 0u);
+        }
+        catch (...)
+        {
+            keep_error();
+        }
+
+        for (auto& w : workers)
+            w.join();
+
+        if (nullptr != error)
+            std::rethrow_exception (error);
+
+        return;
+    }
+
+} // namespace LutParallel
+
+#endif // __LUT_LIBRARY_PARALLEL_FOR_UTILS__
@@ -0,0 +1,156 @@
+#ifndef __LUT_LIBRARY_PARALLEL_TEXT_UTILS__
+#define __LUT_LIBRARY_PARALLEL_TEXT_UTILS__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "string_view.h"
+#include "text_tokenizer.h"
+#include "parallel_for.h"
+#include "huge_pages.h"
+#include "load_budget.h"
+
+namespace LutText
+{
+
+    // bodies smaller than this parsed by calling thread only
+    constexpr std::size_t parallelParseGrain = 1024u * 1024u;
+
+    constexpr std::size_t rowsNoError = ~std::size_t(0);
+
+    struct RowsParseResult
+    {
+        std::size_t rows     = 0u;          // data rows found in text
+        std::size_t parsed   = 0u;          // rows stored in output (not more than requested)
+        std::size_t errorRow = rowsNoError; // index of the first row not parsed, rowsNoError if all rows parsed
+        bool        stopped  = false;       // parsing stopped by load budget: deadline passed or load cancelled
+
+        bool ok (void) const noexcept { return rowsNoError == errorRow && false == stopped; }
+    };
+
+
+    // Parse text block of data rows (each row - 'columns' numbers) into 'out'. Rows are lines for which
+    // isRow (trimmed line) returns true, other lines ignored. Not more than 'maxRows' rows parsed; 'out'
+    // resized to parsed rows * columns. Text split on line aligned chunks processed by worker threads:
+    // first pass counts rows per chunk, prefix sum of counts gives output offset of each chunk, second
+    // pass parses chunks directly into their place in 'out'. Errors merged by row index, so result is
+    // the same for any threads number. If load budget defined it polled every budgetCheckStep lines: expired
+    // deadline or cancellation stops both passes; bytes of parsed text reported as progress of second pass.
+    template <typename T, typename RowFilter>
+    RowsParseResult parse_rows
+    (
+        const char* data,
+        const std::size_t size,
+        const char separator,
+        const std::size_t maxRows,
+        const std::size_t columns,
+        std::vector<T>& out,
+        RowFilter&& isRow,
+        uint32_t threads = 0u,
+        const LutLimits::CLoadBudget* budget = nullptr
+    )
+    {
+        RowsParseResult result;
+        out.clear();
+        if (nullptr == data || 0u == size || 0u == columns)
+            return result;
+
+        if (0u == threads)
+            threads = LutParallel::threads_number();
+        const std::size_t jobs = std::max(static_cast<std::size_t>(1u),
+                                          std::min(static_cast<std::size_t>(threads), size / parallelParseGrain));
+
+        // chunk boundaries: equal byte ranges moved forward to the beginning of the next line
+        std::vector<std::size_t> bounds (jobs + 1u, size);
+        bounds[0] = 0u;
+        for (std::size_t j = 1u; j < jobs; j++)
+        {
+            const std::size_t from = std::max(bounds[j - 1u], size / jobs * j);
+            const char* lineEnd = static_cast<const char*>(std::memchr (data + from, separator, size - from));
+            bounds[j] = (nullptr == lineEnd ? size : static_cast<std::size_t>(lineEnd - data) + 1u);
+        }
+
+        std::atomic<bool> stopped { false };
+        auto for_each_row = [&](const std::size_t chunk, auto&& func, const bool bProgress)
+        {
+            CTextTokenizer text (data + bounds[chunk], bounds[chunk + 1u] - bounds[chunk], separator);
+            string_view line;
+            std::size_t lines = 0u;
+            const char* reported = data + bounds[chunk];
+            while (text.next_line (line))
+            {
+                if (nullptr != budget && 0u == (++lines % LutLimits::budgetCheckStep))
+                {
+                    if (true == stopped.load (std::memory_order_relaxed) || true == budget->stopped())
+                    {
+                        stopped.store (true, std::memory_order_relaxed);
+                        return;
+                    }
+                    if (true == bProgress)
+                    {
+                        budget->advance (static_cast<std::size_t>(line.data() - reported));
+                        reported = line.data();
+                    }
+                }
+                line = trim (line);
+                if (0u != line.size() && true == isRow (line) && false == func (line))
+                    break;
+            }
+            if (nullptr != budget && true == bProgress)
+                budget->advance (static_cast<std::size_t>(data + bounds[chunk + 1u] - reported));
+        };
+
+        // pass 1: rows per chunk
+        std::vector<std::size_t> offsets (jobs + 1u, 0u);
+        LutParallel::parallel_for (0u, jobs, 1u,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            {
+                for (std::size_t j = begin; j < end; j++)
+                    for_each_row (j, [&](const string_view&) { offsets[j + 1u]++; return true; }, false);
+            },
+            static_cast<uint32_t>(jobs));
+
+        if (true == (result.stopped = stopped.load()))
+            return result;
+
+        for (std::size_t j = 0u; j < jobs; j++)
+            offsets[j + 1u] += offsets[j];
+        result.rows   = offsets[jobs];
+        result.parsed = std::min(result.rows, maxRows);
+        LutMemory::reserve_huge (out, result.parsed * columns);
+        out.resize (result.parsed * columns);
+
+        // pass 2: parse rows into precomputed positions, remember first failed row of each chunk
+        std::vector<std::size_t> errors (jobs, rowsNoError);
+        LutParallel::parallel_for (0u, jobs, 1u,
+            [&](const std::size_t begin, const std::size_t end, const uint32_t)
+            {
+                for (std::size_t j = begin; j < end; j++)
+                {
+                    std::size_t row = offsets[j];
+                    if (row >= result.parsed)
+                        continue;
+                    for_each_row (j, [&](const string_view& line)
+                    {
+                        if (columns != parse_numbers (line, &out[row * columns], columns))
+                        {
+                            errors[j] = row;
+                            return false;
+                        }
+                        return (++row < result.parsed);
+                    }, true);
+                }
+            },
+            static_cast<uint32_t>(jobs));
+
+        result.errorRow = *std::min_element (errors.begin(), errors.end());
+        result.stopped  = stopped.load();
+        return result;
+    }
+
+} // namespace LutText
+
+#endif // __LUT_LIBRARY_PARALLEL_TEXT_UTILS__
@@ -70,7 +70,7 @@ namespace lututils_std
       constexpr bool      empty()    const noexcept {return (static_cast<size_type>(0) == m_size);}
       
       /* string and string elements access */
-      constexpr char_type* data() const noexcept {return m_string;}
+      constexpr const_pointer data() const noexcept {return m_string;}
       constexpr const_reference operator[] (const size_type position) const noexcept {return m_string[position];}
       constexpr const_reference at (const size_type position) const
       {
@@ -81,7 +81,7 @@ namespace lututils_std
       constexpr const_reference back  () const noexcept {return m_string[m_size - static_cast<size_type>(1)];}
       
       /* simple modifiers */
-      void remove_prefix (size_type prefix_pos)     noexcept {m_string += prefix_pos; m_size += prefix_pos;}
+      void remove_prefix (size_type prefix_pos)     noexcept {m_string += prefix_pos; m_size -= prefix_pos;}
       void remove_suffix (size_type suffix_pos)     noexcept {m_size -= suffix_pos;}
       void swap          (basic_string_view& other) noexcept {std::swap(m_string, other.m_string), std::swap(m_size, other.m_size);}
       
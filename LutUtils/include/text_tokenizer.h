@@ -0,0 +1,202 @@
+#ifndef __LUT_LIBRARY_TEXT_TOKENIZER_UTILS__
+#define __LUT_LIBRARY_TEXT_TOKENIZER_UTILS__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include "string_view.h"
+#include "fast_float.h"
+
+namespace LutText
+{
+
+    inline bool is_space (const char c) noexcept
+    {
+        return (' ' == c || '\t' == c || '\r' == c || '\n' == c || '\v' == c || '\f' == c);
+    }
+
+    // first character of numeric token: digit, sign or decimal point
+    inline bool is_number_start (const char c) noexcept
+    {
+        return ((c >= '0' && c <= '9') || '-' == c || '+' == c || '.' == c);
+    }
+
+    inline string_view trim (const string_view& str) noexcept
+    {
+        std::size_t b = 0u, e = str.size();
+        while (b < e && is_space (str[b]))
+            b++;
+        while (e > b && is_space (str[e - 1u]))
+            e--;
+        return string_view (str.data() + b, e - b);
+    }
+
+    // extract next whitespace separated token from 'line' and remove it from 'line'; false if no more tokens
+    inline bool next_token (string_view& line, string_view& token) noexcept
+    {
+        const char* p = line.data();
+        const char* const end = p + line.size();
+        while (p < end && is_space (*p))
+            p++;
+        const char* const tokenBegin = p;
+        while (p < end && !is_space (*p))
+            p++;
+        token = string_view (tokenBegin, static_cast<std::size_t>(p - tokenBegin));
+        line  = string_view (p, static_cast<std::size_t>(end - p));
+        return (0u != token.size());
+    }
+
+    // number of tokens in line, counting stops on 'maxCount'
+    inline std::size_t count_tokens (string_view line, const std::size_t maxCount = ~std::size_t(0)) noexcept
+    {
+        std::size_t count = 0u;
+        string_view token;
+        while (count < maxCount && next_token (line, token))
+            count++;
+        return count;
+    }
+
+
+    // parse complete token as floating point number (locale independent, correctly rounded)
+    template <typename T>
+    inline bool parse_number (const string_view& token, T& value) noexcept
+    {
+        return LutFastFloat::from_chars (token.data(), token.size(), value);
+    }
+
+    // parse complete token as unsigned 16 bit code value (integer LUT tables): decimal digits only, no float conversion
+    inline bool parse_number (const string_view& token, uint16_t& value) noexcept
+    {
+        const std::size_t size = token.size();
+        if (0u == size || size > 5u)
+            return false;
+        uint32_t v = 0u;
+        for (std::size_t i = 0u; i < size; i++)
+        {
+            const uint32_t digit = static_cast<uint32_t>(static_cast<unsigned char>(token[i])) - static_cast<uint32_t>('0');
+            if (digit > 9u)
+                return false;
+            v = v * 10u + digit;
+        }
+        if (v > 0xFFFFu)
+            return false;
+        value = static_cast<uint16_t>(v);
+        return true;
+    }
+
+    // parse complete token as decimal integer; value out of range of T (or negative for unsigned T) rejected
+    template <typename T>
+    inline bool parse_integer (const string_view& token, T& value) noexcept
+    {
+        static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t), "parse_integer: unsupported integer type");
+        std::size_t i = 0u;
+        const bool negative = (0u != token.size() && '-' == token[0]);
+        if (0u != token.size() && ('-' == token[0] || '+' == token[0]))
+            i++;
+        if (i == token.size() || (true == negative && false == std::is_signed<T>::value))
+            return false;
+
+        // magnitude limit: max() for positive value, -min() for negative one
+        const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (true == negative ? 1u : 0u);
+        uint64_t v = 0u;
+        for (; i < token.size(); i++)
+        {
+            if (token[i] < '0' || token[i] > '9')
+                return false;
+            const uint64_t digit = static_cast<uint64_t>(token[i] - '0');
+            if (v > (limit - digit) / 10u)
+                return false;
+            v = v * 10u + digit;
+        }
+        value = (true == negative && 0u != v) ? static_cast<T>(-static_cast<T>(v - 1u) - static_cast<T>(1)) : static_cast<T>(v);
+        return true;
+    }
+
+    // parse up to 'count' numbers from line; returns number of successfully parsed values
+    template <typename T>
+    inline std::size_t parse_numbers (string_view line, T* values, const std::size_t count) noexcept
+    {
+        string_view token;
+        std::size_t i = 0u;
+        for (; i < count && next_token (line, token); i++)
+        {
+            if (false == parse_number (token, values[i]))
+                break;
+        }
+        return i;
+    }
+
+
+    // Line tokenizer over caller provided (or memory mapped) text buffer. Buffer not copied and must outlive
+    // tokenizer and all returned views. Line separators LF, CRLF and CR (legacy) recognized; separator style
+    // detected on the first line terminator, line ends searched with memchr.
+    class CTextTokenizer
+    {
+    public:
+        CTextTokenizer (const char* data, const std::size_t size) noexcept : m_data (data), m_size (nullptr != data ? size : 0u)
+        {
+            // CR only files: first terminator is CR not followed by LF
+            for (std::size_t i = 0u; i < m_size; i++)
+            {
+                if ('\n' == m_data[i])
+                    break;
+                if ('\r' == m_data[i])
+                {
+                    m_separator = (i + 1u < m_size && '\n' == m_data[i + 1u]) ? '\n' : '\r';
+                    break;
+                }
+            }
+        }
+
+        // separator known in advance (e.g. line aligned part of bigger buffer)
+        CTextTokenizer (const char* data, const std::size_t size, const char separator) noexcept
+            : m_data (data), m_size (nullptr != data ? size : 0u), m_separator (separator) {}
+
+        // next line without terminator; false at end of buffer
+        bool next_line (string_view& line) noexcept
+        {
+            if (m_pos >= m_size)
+                return false;
+
+            const char* const begin = m_data + m_pos;
+            const std::size_t rest = m_size - m_pos;
+            const char* end = static_cast<const char*>(std::memchr (begin, m_separator, rest));
+            std::size_t length;
+            if (nullptr == end)
+            {
+                length = rest;
+                m_pos = m_size;
+            }
+            else
+            {
+                length = static_cast<std::size_t>(end - begin);
+                m_pos += length + 1u;
+            }
+            if ('\n' == m_separator && 0u != length && '\r' == begin[length - 1u])
+                length--;
+
+            line = string_view (begin, length);
+            m_line++;
+            return true;
+        }
+
+        bool eof (void) const noexcept { return m_pos >= m_size; }
+        std::size_t line_number (void) const noexcept { return m_line; }    // number of lines returned
+        std::size_t position (void) const noexcept { return m_pos; }        // offset of the next line
+        char separator (void) const noexcept { return m_separator; }
+
+    private:
+        const char* m_data = nullptr;
+        std::size_t m_size = 0u;
+        std::size_t m_pos = 0u;
+        std::size_t m_line = 0u;
+        char m_separator = '\n';
+    };
+
+} // namespace LutText
+
+#endif // __LUT_LIBRARY_TEXT_TOKENIZER_UTILS__